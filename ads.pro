@@ -5,5 +5,11 @@ SUBDIRS = \
         # demo \
 	examples
 
+# The benchmark tools are only built with CONFIG+=adsBuildBenchmarks
+adsBuildBenchmarks {
+	SUBDIRS += benchmark
+}
+
 demo.depends = src
 examples.depends = src
+benchmark.depends = src
@@ -0,0 +1,328 @@
+//============================================================================
+/// \file   DragSession.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDragSession, CDragRecorder and CDragReplayer
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DragSession.h"
+
+#include <QApplication>
+#include <QCursor>
+#include <QFile>
+#include <QLabel>
+#include <QMainWindow>
+#include <QMouseEvent>
+#include <QTest>
+#include <QTextStream>
+#include <QWindow>
+
+#include "DockManager.h"
+#include "DockWidget.h"
+
+static const char* const SessionMagic = "ADS-DRAG-SESSION";
+static const int SessionVersion = 1;
+
+
+/**
+ * Returns the name of the given event type that is used in session files
+ */
+static QString eventTypeName(QEvent::Type Type)
+{
+	switch (Type)
+	{
+	case QEvent::MouseButtonPress: return QStringLiteral("press");
+	case QEvent::MouseButtonRelease: return QStringLiteral("release");
+	default: return QStringLiteral("move");
+	}
+}
+
+
+/**
+ * Returns the event type for the given name
+ */
+static QEvent::Type eventTypeFromName(const QString& Name)
+{
+	if (Name == QLatin1String("press"))
+	{
+		return QEvent::MouseButtonPress;
+	}
+	else if (Name == QLatin1String("release"))
+	{
+		return QEvent::MouseButtonRelease;
+	}
+	else if (Name == QLatin1String("move"))
+	{
+		return QEvent::MouseMove;
+	}
+	return QEvent::None;
+}
+
+
+//============================================================================
+bool CDragSession::save(const QString& FileName) const
+{
+	QFile File(FileName);
+	if (!File.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		return false;
+	}
+
+	QTextStream s(&File);
+	s << SessionMagic << " " << SessionVersion << "\n";
+	s << "widgets " << DockWidgetCount << "\n";
+	s << "config " << ConfigFlags << "\n";
+	s << "geometry " << WindowGeometry.x() << " " << WindowGeometry.y() << " "
+	  << WindowGeometry.width() << " " << WindowGeometry.height() << "\n";
+	s << "state " << State.toBase64() << "\n";
+	for (const auto& Event : Events)
+	{
+		s << eventTypeName(Event.Type) << " " << Event.Time << " "
+		  << Event.GlobalPos.x() << " " << Event.GlobalPos.y() << " "
+		  << int(Event.Button) << " " << int(Event.Buttons) << " "
+		  << int(Event.Modifiers) << "\n";
+	}
+	return true;
+}
+
+
+//============================================================================
+bool CDragSession::load(const QString& FileName)
+{
+	QFile File(FileName);
+	if (!File.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return false;
+	}
+
+	QTextStream s(&File);
+	QString Magic;
+	int Version = 0;
+	s >> Magic >> Version;
+	if (Magic != QLatin1String(SessionMagic) || Version != SessionVersion)
+	{
+		return false;
+	}
+
+	Events.clear();
+	while (!s.atEnd())
+	{
+		QString Key;
+		s >> Key;
+		if (Key.isEmpty())
+		{
+			continue;
+		}
+
+		if (Key == QLatin1String("widgets"))
+		{
+			s >> DockWidgetCount;
+		}
+		else if (Key == QLatin1String("config"))
+		{
+			s >> ConfigFlags;
+		}
+		else if (Key == QLatin1String("geometry"))
+		{
+			int x, y, w, h;
+			s >> x >> y >> w >> h;
+			WindowGeometry = QRect(x, y, w, h);
+		}
+		else if (Key == QLatin1String("state"))
+		{
+			QString Data;
+			s >> Data;
+			State = QByteArray::fromBase64(Data.toLatin1());
+		}
+		else
+		{
+			SInputEvent Event;
+			Event.Type = eventTypeFromName(Key);
+			int x, y, Button, Buttons, Modifiers;
+			s >> Event.Time >> x >> y >> Button >> Buttons >> Modifiers;
+			if (Event.Type == QEvent::None || s.status() != QTextStream::Ok)
+			{
+				return false;
+			}
+			Event.GlobalPos = QPoint(x, y);
+			Event.Button = Qt::MouseButton(Button);
+			Event.Buttons = Qt::MouseButtons(Buttons);
+			Event.Modifiers = Qt::KeyboardModifiers(Modifiers);
+			Events.append(Event);
+		}
+	}
+	return DockWidgetCount > 0;
+}
+
+
+//============================================================================
+QMainWindow* createDragTestWindow(int DockWidgetCount, ads::CDockManager** DockManager)
+{
+	auto MainWindow = new QMainWindow();
+	auto Manager = new ads::CDockManager(MainWindow);
+	ads::CDockAreaWidget* FirstArea = nullptr;
+	for (int i = 0; i < DockWidgetCount; ++i)
+	{
+		auto Name = QString("Dock %1").arg(i + 1);
+		auto Label = new QLabel(Name);
+		Label->setAlignment(Qt::AlignCenter);
+		auto DockWidget = new ads::CDockWidget(Name);
+		DockWidget->setWidget(Label);
+
+		// Build a mix of split and tabbed dock areas
+		switch (i % 4)
+		{
+		case 0: FirstArea = Manager->addDockWidget(ads::LeftDockWidgetArea, DockWidget); break;
+		case 1: Manager->addDockWidget(ads::RightDockWidgetArea, DockWidget, FirstArea); break;
+		case 2: Manager->addDockWidget(ads::BottomDockWidgetArea, DockWidget, FirstArea); break;
+		default: Manager->addDockWidgetTab(ads::CenterDockWidgetArea, DockWidget); break;
+		}
+	}
+
+	if (DockManager)
+	{
+		*DockManager = Manager;
+	}
+	return MainWindow;
+}
+
+
+//============================================================================
+CDragRecorder::CDragRecorder(CDragSession& Session, QObject* Parent) :
+	QObject(Parent),
+	m_Session(Session)
+{
+	m_Timer.start();
+	qApp->installEventFilter(this);
+}
+
+
+//============================================================================
+CDragRecorder::~CDragRecorder()
+{
+	qApp->removeEventFilter(this);
+}
+
+
+//============================================================================
+bool CDragRecorder::eventFilter(QObject* Watched, QEvent* Event)
+{
+	switch (Event->type())
+	{
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseButtonRelease:
+	case QEvent::MouseMove:
+		break;
+
+	default:
+		return false;
+	}
+
+	// Each input event is first delivered to its window and then to the
+	// widgets. Recording only the window events records each input event
+	// exactly once.
+	if (!Watched->isWindowType() || !Event->spontaneous())
+	{
+		return false;
+	}
+
+	auto MouseEvent = static_cast<QMouseEvent*>(Event);
+	SInputEvent Input;
+	Input.Type = Event->type();
+	Input.Time = m_Timer.nsecsElapsed();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	Input.GlobalPos = MouseEvent->globalPosition().toPoint();
+#else
+	Input.GlobalPos = MouseEvent->globalPos();
+#endif
+	Input.Button = MouseEvent->button();
+	Input.Buttons = MouseEvent->buttons();
+	Input.Modifiers = MouseEvent->modifiers();
+	m_Session.Events.append(Input);
+	return false;
+}
+
+
+//============================================================================
+CDragReplayer::CDragReplayer(const CDragSession& Session) :
+	m_Session(Session)
+{
+
+}
+
+
+//============================================================================
+QWindow* CDragReplayer::targetWindow(const SInputEvent& Event) const
+{
+	// An explicit mouse grab always wins
+	auto Grabber = QWidget::mouseGrabber();
+	if (Grabber && Grabber->window()->windowHandle())
+	{
+		return Grabber->window()->windowHandle();
+	}
+
+	// While a button is pressed, the window system sends all events to the
+	// window that received the press
+	if (Event.Type != QEvent::MouseButtonPress && m_PressWindow && m_PressWindow->isVisible())
+	{
+		return m_PressWindow;
+	}
+
+	return QGuiApplication::topLevelAt(Event.GlobalPos);
+}
+
+
+//============================================================================
+void CDragReplayer::replay(bool Realtime, QVector<qint64>& Latencies)
+{
+	Latencies.clear();
+	Latencies.reserve(m_Session.Events.count());
+	QElapsedTimer ReplayTimer;
+	ReplayTimer.start();
+	QElapsedTimer Timer;
+	for (const auto& Event : m_Session.Events)
+	{
+		while (Realtime && ReplayTimer.nsecsElapsed() < Event.Time)
+		{
+			QCoreApplication::processEvents(QEventLoop::AllEvents);
+		}
+
+		auto Window = targetWindow(Event);
+		Timer.start();
+		QCursor::setPos(Event.GlobalPos);
+		if (Window)
+		{
+			auto LocalPos = Event.GlobalPos - Window->position();
+			switch (Event.Type)
+			{
+			case QEvent::MouseButtonPress:
+				m_PressWindow = Window;
+				QTest::mousePress(Window, Event.Button, Event.Modifiers, LocalPos);
+				break;
+
+			case QEvent::MouseButtonRelease:
+				QTest::mouseRelease(Window, Event.Button, Event.Modifiers, LocalPos);
+				if (Event.Buttons == Qt::NoButton)
+				{
+					m_PressWindow = nullptr;
+				}
+				break;
+
+			default:
+				QTest::mouseMove(Window, LocalPos);
+				break;
+			}
+		}
+
+		// The latency includes all events that have been posted while
+		// the input event has been processed
+		QCoreApplication::processEvents(QEventLoop::AllEvents);
+		Latencies.append(Timer.nsecsElapsed());
+	}
+}
+
+//---------------------------------------------------------------------------
+// EOF DragSession.cpp
@@ -0,0 +1,141 @@
+#ifndef DragSessionH
+#define DragSessionH
+//============================================================================
+/// \file   DragSession.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDragSession, CDragRecorder and CDragReplayer
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QObject>
+#include <QPoint>
+#include <QPointer>
+#include <QRect>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QMainWindow;
+class QWindow;
+QT_END_NAMESPACE
+
+namespace ads
+{
+class CDockManager;
+}
+
+
+/**
+ * One recorded mouse event
+ */
+struct SInputEvent
+{
+	QEvent::Type Type = QEvent::None;
+	qint64 Time = 0;///< nanoseconds since start of recording
+	QPoint GlobalPos;
+	Qt::MouseButton Button = Qt::NoButton;
+	Qt::MouseButtons Buttons = Qt::NoButton;
+	Qt::KeyboardModifiers Modifiers = Qt::NoModifier;
+};
+
+
+/**
+ * A recorded drag session.
+ * The session contains everything that is required to rebuild the layout
+ * the events have been recorded against: the number of dock widgets, the
+ * dock manager config flags, the main window geometry and the saved dock
+ * manager state.
+ */
+struct CDragSession
+{
+	int DockWidgetCount = 0;
+	int ConfigFlags = 0;
+	QRect WindowGeometry;
+	QByteArray State;
+	QVector<SInputEvent> Events;
+
+	/**
+	 * Saves the session into a text file with one event per line
+	 */
+	bool save(const QString& FileName) const;
+
+	/**
+	 * Loads the session from the given file
+	 */
+	bool load(const QString& FileName);
+};
+
+
+/**
+ * Creates the main window with a dock manager and the given number of
+ * dock widgets named "Dock 1" to "Dock N"
+ */
+QMainWindow* createDragTestWindow(int DockWidgetCount, ads::CDockManager** DockManager);
+
+
+/**
+ * Records all spontaneous mouse press, move and release events that are
+ * delivered to the windows of the application
+ */
+class CDragRecorder : public QObject
+{
+	Q_OBJECT
+private:
+	CDragSession& m_Session;
+	QElapsedTimer m_Timer;
+
+public:
+	/**
+	 * Starts recording into the given session
+	 */
+	CDragRecorder(CDragSession& Session, QObject* Parent = nullptr);
+
+	/**
+	 * Stops recording
+	 */
+	virtual ~CDragRecorder();
+
+	/**
+	 * Records the mouse events of all windows
+	 */
+	virtual bool eventFilter(QObject* Watched, QEvent* Event) override;
+};
+
+
+/**
+ * Replays the events of a session and measures the time from injecting
+ * an event until the event loop has processed all resulting events
+ */
+class CDragReplayer
+{
+private:
+	const CDragSession& m_Session;
+	QPointer<QWindow> m_PressWindow;
+
+	/**
+	 * Returns the window that would receive the given event from the
+	 * windowing system
+	 */
+	QWindow* targetWindow(const SInputEvent& Event) const;
+
+public:
+	/**
+	 * Creates a replayer for the given session
+	 */
+	CDragReplayer(const CDragSession& Session);
+
+	/**
+	 * Replays all events. If Realtime is true, the recorded timing between
+	 * the events is kept, otherwise the events are injected as fast as
+	 * possible. Latencies receives the processing time of each event in
+	 * nanoseconds.
+	 */
+	void replay(bool Realtime, QVector<qint64>& Latencies);
+};
+
+//---------------------------------------------------------------------------
+#endif // DragSessionH
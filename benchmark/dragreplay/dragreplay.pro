@@ -0,0 +1,27 @@
+ADS_OUT_ROOT = $${OUT_PWD}/../..
+
+QT += core gui widgets testlib
+
+TARGET = DragReplay
+DESTDIR = $${ADS_OUT_ROOT}/lib
+TEMPLATE = app
+CONFIG += c++14
+CONFIG += console
+CONFIG += debug_and_release
+adsBuildStatic {
+    DEFINES += ADS_STATIC
+}
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+        main.cpp \
+        DragSession.cpp
+
+HEADERS += \
+        DragSession.h
+
+LIBS += -L$${ADS_OUT_ROOT}/lib
+include(../../ads.pri)
+INCLUDEPATH += ../../src
+DEPENDPATH += ../../src
@@ -0,0 +1,183 @@
+//============================================================================
+/// \file   main.cpp
+/// \date   19.10.2026
+/// \brief  Records drag sessions and replays them to measure the latency
+///         of the event processing
+///
+/// Record a session against the default layout or a saved state:
+///     DragReplay record session.txt [--widgets 12] [--layout state.xml]
+/// Replay it headless and print the latency percentiles:
+///     QT_QPA_PLATFORM=offscreen DragReplay replay session.txt [--realtime]
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QMainWindow>
+#include <QTest>
+
+#include <algorithm>
+#include <stdio.h>
+
+#include "DockManager.h"
+#include "DragSession.h"
+
+
+/**
+ * Returns the given percentile of the sorted values in milliseconds
+ */
+static double percentile(const QVector<qint64>& Sorted, double Percent)
+{
+	if (Sorted.isEmpty())
+	{
+		return 0.0;
+	}
+
+	int Index = qBound(0, int(Percent / 100.0 * (Sorted.count() - 1) + 0.5), Sorted.count() - 1);
+	return Sorted[Index] / 1000000.0;
+}
+
+
+/**
+ * Prints one line of the latency report
+ */
+static void printLatencies(const char* Name, QVector<qint64> Values)
+{
+	std::sort(Values.begin(), Values.end());
+	printf("%-8s %8d %10.3f %10.3f %10.3f %10.3f\n", Name, Values.count(),
+		percentile(Values, 50), percentile(Values, 90), percentile(Values, 99),
+		percentile(Values, 100));
+}
+
+
+/**
+ * Records a session until the main window is closed
+ */
+static int record(QApplication& App, const QString& FileName, int DockWidgetCount,
+	const QString& LayoutFileName)
+{
+	ads::CDockManager* DockManager;
+	QScopedPointer<QMainWindow> MainWindow(createDragTestWindow(DockWidgetCount, &DockManager));
+	if (!LayoutFileName.isEmpty())
+	{
+		QFile File(LayoutFileName);
+		if (!File.open(QIODevice::ReadOnly) || !DockManager->restoreState(File.readAll()))
+		{
+			fprintf(stderr, "Failed to restore layout %s\n", qPrintable(LayoutFileName));
+			return 1;
+		}
+	}
+	MainWindow->resize(1280, 800);
+	MainWindow->show();
+	QTest::qWaitForWindowExposed(MainWindow.data());
+
+	CDragSession Session;
+	Session.DockWidgetCount = DockWidgetCount;
+	Session.ConfigFlags = int(ads::CDockManager::configFlags());
+	Session.WindowGeometry = MainWindow->geometry();
+	Session.State = DockManager->saveState();
+	{
+		CDragRecorder Recorder(Session);
+		App.exec();
+	}
+
+	if (!Session.save(FileName))
+	{
+		fprintf(stderr, "Failed to save session %s\n", qPrintable(FileName));
+		return 1;
+	}
+	printf("Recorded %d events\n", Session.Events.count());
+	return 0;
+}
+
+
+/**
+ * Replays the session and prints the latency report
+ */
+static int replay(const QString& FileName, bool Realtime)
+{
+	CDragSession Session;
+	if (!Session.load(FileName))
+	{
+		fprintf(stderr, "Failed to load session %s\n", qPrintable(FileName));
+		return 1;
+	}
+
+	ads::CDockManager::setConfigFlags(ads::CDockManager::ConfigFlags(Session.ConfigFlags));
+	ads::CDockManager* DockManager;
+	QScopedPointer<QMainWindow> MainWindow(createDragTestWindow(Session.DockWidgetCount, &DockManager));
+	MainWindow->setGeometry(Session.WindowGeometry);
+	MainWindow->show();
+	QTest::qWaitForWindowExposed(MainWindow.data());
+	if (!DockManager->restoreState(Session.State))
+	{
+		fprintf(stderr, "Failed to restore the layout of the session\n");
+		return 1;
+	}
+	QCoreApplication::processEvents();
+
+	QVector<qint64> Latencies;
+	CDragReplayer Replayer(Session);
+	Replayer.replay(Realtime, Latencies);
+
+	QVector<qint64> Press, Move, Release;
+	for (int i = 0; i < Latencies.count(); ++i)
+	{
+		switch (Session.Events[i].Type)
+		{
+		case QEvent::MouseButtonPress: Press.append(Latencies[i]); break;
+		case QEvent::MouseButtonRelease: Release.append(Latencies[i]); break;
+		default: Move.append(Latencies[i]); break;
+		}
+	}
+
+	printf("%-8s %8s %10s %10s %10s %10s\n", "event", "count", "p50 [ms]",
+		"p90 [ms]", "p99 [ms]", "max [ms]");
+	printLatencies("press", Press);
+	printLatencies("move", Move);
+	printLatencies("release", Release);
+	printLatencies("all", Latencies);
+	return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+	QApplication App(argc, argv);
+	QCommandLineParser Parser;
+	Parser.setApplicationDescription("Records and replays drag sessions to "
+		"measure the event processing latency of the docking system");
+	Parser.addHelpOption();
+	Parser.addPositionalArgument("mode", "record or replay");
+	Parser.addPositionalArgument("session", "The session file");
+	QCommandLineOption WidgetsOption("widgets", "Number of dock widgets for recording", "count", "12");
+	QCommandLineOption LayoutOption("layout", "Saved dock manager state for recording", "file");
+	QCommandLineOption RealtimeOption("realtime", "Keep the recorded timing between the events");
+	Parser.addOption(WidgetsOption);
+	Parser.addOption(LayoutOption);
+	Parser.addOption(RealtimeOption);
+	Parser.process(App);
+
+	auto Args = Parser.positionalArguments();
+	if (Args.count() != 2)
+	{
+		Parser.showHelp(1);
+	}
+
+	if (Args[0] == QLatin1String("record"))
+	{
+		return record(App, Args[1], Parser.value(WidgetsOption).toInt(),
+			Parser.value(LayoutOption));
+	}
+	else if (Args[0] == QLatin1String("replay"))
+	{
+		return replay(Args[1], Parser.isSet(RealtimeOption));
+	}
+
+	Parser.showHelp(1);
+	return 1;
+}
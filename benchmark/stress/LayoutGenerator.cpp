@@ -0,0 +1,181 @@
+//============================================================================
+/// \file   LayoutGenerator.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CLayoutGenerator
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LayoutGenerator.h"
+
+#include <QFile>
+#include <QLabel>
+#include <QMainWindow>
+#include <QScopedPointer>
+#include <QSplitter>
+#include <QVector>
+
+#include <random>
+
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockWidget.h"
+
+
+//============================================================================
+QList<ads::CDockWidget*> CLayoutGenerator::createDockWidgets(int Count)
+{
+	QList<ads::CDockWidget*> DockWidgets;
+	DockWidgets.reserve(Count);
+	for (int i = 0; i < Count; ++i)
+	{
+		auto Name = QString("Dock %1").arg(i + 1);
+		auto DockWidget = new ads::CDockWidget(Name);
+		DockWidget->setWidget(new QLabel(Name));
+		DockWidgets.append(DockWidget);
+	}
+	return DockWidgets;
+}
+
+
+/**
+ * Returns the number of splitters between the given dock area and the
+ * dock manager
+ */
+static int nestingDepth(ads::CDockAreaWidget* DockArea, ads::CDockManager* DockManager)
+{
+	int Depth = 0;
+	for (auto Parent = DockArea->parentWidget(); Parent && Parent != DockManager;
+		Parent = Parent->parentWidget())
+	{
+		if (qobject_cast<QSplitter*>(Parent))
+		{
+			++Depth;
+		}
+	}
+	return Depth;
+}
+
+
+/**
+ * Returns a random side of the given dock area. If Nest is true, the side
+ * is perpendicular to the orientation of the parent splitter, so the split
+ * creates a new nested splitter. Otherwise the new dock area is inserted
+ * into the parent splitter.
+ */
+static ads::DockWidgetArea splitSide(ads::CDockAreaWidget* DockArea, bool Nest,
+	std::mt19937& Random)
+{
+	auto Splitter = qobject_cast<QSplitter*>(DockArea->parentWidget());
+	bool Horizontal = Splitter && Splitter->orientation() == Qt::Horizontal;
+	if (Horizontal != Nest)
+	{
+		return (Random() % 2) ? ads::LeftDockWidgetArea : ads::RightDockWidgetArea;
+	}
+	return (Random() % 2) ? ads::TopDockWidgetArea : ads::BottomDockWidgetArea;
+}
+
+
+//============================================================================
+QList<ads::CDockWidget*> CLayoutGenerator::generate(ads::CDockManager* DockManager,
+	const SLayoutParameters& Parameters)
+{
+	std::mt19937 Random(Parameters.Seed);
+	auto DockWidgets = createDockWidgets(Parameters.DockWidgets);
+	int Count = DockWidgets.count();
+	int Floating = qBound(0, Parameters.FloatingWindows, Count - 1);
+	int AutoHide = ads::CDockManager::testAutoHideConfigFlag(ads::CDockManager::AutoHideFeatureEnabled)
+		? qBound(0, Parameters.AutoHideWidgets, Count - Floating - 1) : 0;
+	QVector<ads::CDockAreaWidget*> DockedAreas;
+	QVector<ads::CDockAreaWidget*> FloatingAreas;
+
+	int i = 0;
+	for (; i < Floating; ++i)
+	{
+		DockManager->addDockWidgetFloating(DockWidgets[i]);
+		FloatingAreas.append(DockWidgets[i]->dockAreaWidget());
+	}
+
+	for (int j = 0; j < AutoHide; ++j, ++i)
+	{
+		DockManager->addAutoHideDockWidget(ads::SideBarLocation(Random() % 4), DockWidgets[i]);
+	}
+
+	// Build one chain of nested splitters first, so the requested depth is
+	// reached even for small layouts. A split perpendicular to the parent
+	// splitter only nests, if the parent splitter has more than one widget,
+	// so the first split is done in the orientation of the root splitter.
+	const int MaxDepth = qMax(1, Parameters.Depth);
+	ads::CDockAreaWidget* Last = nullptr;
+	for (; i < Count; ++i)
+	{
+		auto DockWidget = DockWidgets[i];
+		if (!Last)
+		{
+			Last = DockManager->addDockWidget(ads::CenterDockWidgetArea, DockWidget);
+		}
+		else
+		{
+			int Depth = nestingDepth(Last, DockManager);
+			auto Splitter = qobject_cast<QSplitter*>(Last->parentWidget());
+			bool Nest = Splitter && Splitter->count() > 1;
+			if (Nest && Depth >= MaxDepth)
+			{
+				break;
+			}
+			Last = DockManager->addDockWidget(splitSide(Last, Nest, Random), DockWidget, Last);
+		}
+		DockedAreas.append(Last);
+	}
+
+	for (; i < Count; ++i)
+	{
+		auto DockWidget = DockWidgets[i];
+		int Choice = Random() % 4;
+		if (Choice == 0 && !FloatingAreas.isEmpty())
+		{
+			DockManager->addDockWidgetTabToArea(DockWidget, FloatingAreas[Random() % FloatingAreas.count()]);
+			continue;
+		}
+
+		// Splitting a dock area perpendicular to its parent splitter moves
+		// the dock area and the new one into a nested splitter. Dock areas
+		// at the maximum depth are only split in the orientation of their
+		// parent splitter, which does not change the nesting depth.
+		auto Target = DockedAreas[Random() % DockedAreas.count()];
+		if (Choice == 1)
+		{
+			DockManager->addDockWidgetTabToArea(DockWidget, Target);
+		}
+		else
+		{
+			bool Nest = nestingDepth(Target, DockManager) < MaxDepth;
+			DockedAreas.append(DockManager->addDockWidget(splitSide(Target, Nest, Random),
+				DockWidget, Target));
+		}
+	}
+
+	return DockWidgets;
+}
+
+
+//============================================================================
+bool CLayoutGenerator::generateFile(const QString& FileName, const SLayoutParameters& Parameters)
+{
+	QScopedPointer<QMainWindow> MainWindow(new QMainWindow());
+	auto DockManager = new ads::CDockManager(MainWindow.data());
+	generate(DockManager, Parameters);
+
+	QFile File(FileName);
+	if (!File.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+	File.write(DockManager->saveState());
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// EOF LayoutGenerator.cpp
@@ -0,0 +1,71 @@
+#ifndef LayoutGeneratorH
+#define LayoutGeneratorH
+//============================================================================
+/// \file   LayoutGenerator.h
+/// \date   19.10.2026
+/// \brief  Declaration of CLayoutGenerator
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QList>
+#include <QString>
+
+namespace ads
+{
+class CDockManager;
+class CDockWidget;
+}
+
+
+/**
+ * Parameters of a generated layout
+ */
+struct SLayoutParameters
+{
+	int DockWidgets = 100;///< total number of dock widgets
+	int Depth = 4;///< maximum splitter nesting depth of the docked dock areas
+	int FloatingWindows = 2;///< number of floating containers
+	int AutoHideWidgets = 4;///< number of auto hide side bar entries
+	unsigned int Seed = 1;///< seed for the random generator
+};
+
+
+/**
+ * Builds random but valid layouts with a given number of dock widgets,
+ * splitter nesting depth, floating windows and auto hide side bar entries.
+ * The nesting depth of a dock area is the number of splitters between the
+ * dock area and its container, so the root splitter has depth 1. No dock
+ * area exceeds the given depth, which is at least 1, and the depth is
+ * reached if there are enough dock widgets.
+ * The same parameters and seed always create the same layout. The dock
+ * widgets are named "Dock 1" to "Dock N", so a saved state can be restored
+ * into any dock manager that contains the dock widgets created by
+ * createDockWidgets() for the same number of dock widgets.
+ */
+class CLayoutGenerator
+{
+public:
+	/**
+	 * Creates the given number of dock widgets with simple label content
+	 */
+	static QList<ads::CDockWidget*> createDockWidgets(int Count);
+
+	/**
+	 * Adds the dock widgets of a generated layout to the given dock manager.
+	 * Auto hide entries are only created if the auto hide feature is
+	 * enabled. Returns the added dock widgets.
+	 */
+	static QList<ads::CDockWidget*> generate(ads::CDockManager* DockManager,
+		const SLayoutParameters& Parameters);
+
+	/**
+	 * Generates a layout in a temporary dock manager and saves the state
+	 * via CDockManager::saveState() into the given file
+	 */
+	static bool generateFile(const QString& FileName, const SLayoutParameters& Parameters);
+};
+
+//---------------------------------------------------------------------------
+#endif // LayoutGeneratorH
@@ -0,0 +1,670 @@
+//============================================================================
+/// \file   main.cpp
+/// \date   19.10.2026
+/// \brief  Generates large layouts and measures how the cost of the
+///         docking operations scales with the number of dock widgets
+///
+/// Generate a layout file:
+///     LayoutStress generate layout.xml --widgets 1000 --depth 6
+/// Sweep the number of dock widgets and flag super-linear operations:
+///     QT_QPA_PLATFORM=offscreen LayoutStress sweep --min 10 --max 10000
+/// Print the memory use of a layout by component type and the number of
+/// title bar buttons that have been created per dock area:
+///     QT_QPA_PLATFORM=offscreen LayoutStress memory --widgets 1000
+/// Measure the quick open queries of a layout with 10000 dock widgets:
+///     QT_QPA_PLATFORM=offscreen LayoutStress quickopen
+/// Count the X11 requests of floating widget stacking changes (Linux):
+///     xvfb-run -a LayoutStress stacking --floating 20
+/// The sweep and the memory mode fail, if the heap bytes per dock widget
+/// exceed the value given with --max-bytes. The tracked target is 32768
+/// bytes per dock widget including the label content of the generated dock
+/// widgets. This is an estimate of about 20 KB for the dock widget, its
+/// tab, scroll area, toggle view action and content label plus headroom -
+/// lower it to the measured figure once a run on the reference machine
+/// is available. A value of 0 disables the check.
+/// The sweep also fails, if the geometry of a dock area or splitter still
+/// changes after restoreState() returned or if one of them receives more
+/// than one resize event when the restored layout is shown. The quick open mode fails, if one query takes
+/// longer than the value given with --max-ms. The stacking mode fails, if
+/// an activation change sends redundant stacking state changes or flushes
+/// the X connection more than once.
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QMainWindow>
+#include <QHash>
+#include <QScopedPointer>
+#include <QSet>
+#include <QSplitter>
+#include <QVector>
+
+#include <math.h>
+#include <stdio.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "DockAreaTitleBar.h"
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockQuickOpen.h"
+#include "DockWidget.h"
+#include "FloatingDockContainer.h"
+#include "LayoutGenerator.h"
+
+
+/**
+ * The measured operations
+ */
+enum eOperation
+{
+	OpAddDockWidget,
+	OpRestoreState,
+	OpToggleView,
+	OpTabSwitch,
+	OpHitTest,
+	OpRemoveDockWidget,
+	OperationCount
+};
+
+static const char* const OperationNames[OperationCount] = {"addDockWidget",
+	"restoreState", "toggleView", "tabSwitch", "hitTest", "removeDockWidget"};
+
+static const int HitTestCount = 1000;
+
+
+/**
+ * The memory figures of one measurement
+ */
+struct SMemory
+{
+	qint64 HeapBytesPerWidget = -1;///< heap growth per dock widget, -1 if unknown
+	qint64 ShallowBytesPerWidget = 0;///< CDockMemoryUsage::bytesPerDockWidget()
+};
+
+
+/**
+ * The restore passes of one measurement
+ */
+struct SRestorePasses
+{
+	int MaxResizes = 0;///< largest number of resize events of one widget
+	int Relayouts = 0;///< number of widgets that moved after the restore
+};
+
+
+/**
+ * Counts the resize events of all dock areas and splitters while it is
+ * installed as application event filter
+ */
+class CResizeCounter : public QObject
+{
+public:
+	QHash<QObject*, int> Counts;
+
+	virtual bool eventFilter(QObject* Object, QEvent* Event) override
+	{
+		if (Event->type() == QEvent::Resize && (qobject_cast<ads::CDockAreaWidget*>(Object)
+		 || qobject_cast<QSplitter*>(Object)))
+		{
+			++Counts[Object];
+		}
+		return false;
+	}
+
+	/**
+	 * Returns the largest number of resize events of one widget
+	 */
+	int maxCount() const
+	{
+		int Result = 0;
+		for (auto Count : Counts)
+		{
+			Result = qMax(Result, Count);
+		}
+		return Result;
+	}
+};
+
+
+/**
+ * Returns the geometries of all dock areas and splitters of the given
+ * dock manager
+ */
+static QHash<QWidget*, QRect> layoutGeometries(ads::CDockManager* DockManager)
+{
+	QHash<QWidget*, QRect> Result;
+	const auto Widgets = DockManager->findChildren<QWidget*>();
+	for (auto Widget : Widgets)
+	{
+		if (qobject_cast<ads::CDockAreaWidget*>(Widget) || qobject_cast<QSplitter*>(Widget))
+		{
+			Result.insert(Widget, Widget->geometry());
+		}
+	}
+	return Result;
+}
+
+
+/**
+ * Returns the number of allocated heap bytes or -1 if this is not
+ * supported on this platform
+ */
+static qint64 heapBytes()
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+	return qint64(mallinfo2().uordblks);
+#elif defined(__GLIBC__)
+	return qint64(mallinfo().uordblks);
+#else
+	return -1;
+#endif
+}
+
+
+/**
+ * Returns the elapsed time in milliseconds after processing all pending
+ * events, so deferred layout work is included in the measurement
+ */
+static double elapsedMs(const QElapsedTimer& Timer)
+{
+	QCoreApplication::processEvents();
+	return Timer.nsecsElapsed() / 1000000.0;
+}
+
+
+/**
+ * Measures all operations for the given layout parameters. The heap growth
+ * includes the label content of the generated dock widgets. Restore
+ * returns the passes that the restored layout needed to settle.
+ */
+static QVector<double> measure(const SLayoutParameters& Parameters, SMemory& Memory,
+	SRestorePasses& Restore)
+{
+	QVector<double> Result(OperationCount, 0.0);
+	QElapsedTimer Timer;
+
+	// Build the generated layout
+	qint64 HeapBefore = heapBytes();
+	QScopedPointer<QMainWindow> MainWindow(new QMainWindow());
+	auto DockManager = new ads::CDockManager(MainWindow.data());
+	MainWindow->resize(1600, 1000);
+	MainWindow->show();
+	Timer.start();
+	auto DockWidgets = CLayoutGenerator::generate(DockManager, Parameters);
+	Result[OpAddDockWidget] = elapsedMs(Timer);
+	if (HeapBefore >= 0 && !DockWidgets.isEmpty())
+	{
+		Memory.HeapBytesPerWidget = (heapBytes() - HeapBefore) / DockWidgets.count();
+	}
+	Memory.ShallowBytesPerWidget = DockManager->memoryUsage().bytesPerDockWidget();
+	auto State = DockManager->saveState();
+
+	// Make each tab of each dock area the current one
+	Timer.start();
+	for (auto DockArea : DockManager->openedDockAreas())
+	{
+		for (int i = 0; i < DockArea->dockWidgetsCount(); ++i)
+		{
+			DockArea->setCurrentIndex(i);
+		}
+	}
+	Result[OpTabSwitch] = elapsedMs(Timer);
+
+	// Hit test a fixed grid of positions like a drag over the dock manager
+	auto Origin = DockManager->mapToGlobal(QPoint(0, 0));
+	int Columns = 40;
+	int Rows = HitTestCount / Columns;
+	Timer.start();
+	for (int i = 0; i < HitTestCount; ++i)
+	{
+		QPoint Pos(DockManager->width() * (i % Columns) / Columns,
+			DockManager->height() * (i / Columns) / Rows);
+		DockManager->dockAreaAt(Origin + Pos);
+	}
+	Result[OpHitTest] = elapsedMs(Timer);
+
+	// Close and reopen all dock widgets
+	Timer.start();
+	for (auto DockWidget : DockWidgets)
+	{
+		DockWidget->toggleView(false);
+	}
+	for (auto DockWidget : DockWidgets)
+	{
+		DockWidget->toggleView(true);
+	}
+	Result[OpToggleView] = elapsedMs(Timer);
+	MainWindow.reset();
+
+	// Restore the saved layout into a new dock manager that contains all
+	// dock widgets tabbed in one dock area
+	MainWindow.reset(new QMainWindow());
+	DockManager = new ads::CDockManager(MainWindow.data());
+	MainWindow->resize(1600, 1000);
+	MainWindow->show();
+	DockWidgets = CLayoutGenerator::createDockWidgets(Parameters.DockWidgets);
+	for (auto DockWidget : DockWidgets)
+	{
+		DockManager->addDockWidgetTab(ads::CenterDockWidgetArea, DockWidget);
+	}
+	QCoreApplication::processEvents();
+
+	// restoreState() hides the dock manager, so Qt coalesces all resizes
+	// of the restore into one pending resize event per widget. The restore
+	// is only single pass, if the geometry that restoreState() has applied
+	// is final - the geometries must not change and each widget must not
+	// receive more than one resize event when the visible layout settles.
+	// If the splitter sizes are applied bottom up, the splitters rescale
+	// their children when they get their real size and both checks fail.
+	CResizeCounter ResizeCounter;
+	Timer.start();
+	DockManager->restoreState(State);
+	const auto Geometries = layoutGeometries(DockManager);
+	qApp->installEventFilter(&ResizeCounter);
+	Result[OpRestoreState] = elapsedMs(Timer);
+	qApp->removeEventFilter(&ResizeCounter);
+	Restore.MaxResizes = ResizeCounter.maxCount();
+	Restore.Relayouts = 0;
+	const auto Settled = layoutGeometries(DockManager);
+	for (auto it = Settled.constBegin(); it != Settled.constEnd(); ++it)
+	{
+		if (Geometries.value(it.key()) != it.value())
+		{
+			++Restore.Relayouts;
+		}
+	}
+
+	Timer.start();
+	for (auto DockWidget : DockWidgets)
+	{
+		DockManager->removeDockWidget(DockWidget);
+	}
+	Result[OpRemoveDockWidget] = elapsedMs(Timer);
+	qDeleteAll(DockWidgets);
+	return Result;
+}
+
+
+/**
+ * Returns true, if the heap bytes per dock widget exceed the given maximum.
+ * A maximum of 0 disables the check.
+ */
+static bool exceedsMaxBytes(const SMemory& Memory, qint64 MaxBytes)
+{
+	return MaxBytes > 0 && Memory.HeapBytesPerWidget > MaxBytes;
+}
+
+
+/**
+ * Runs the sweep and returns the number of flagged operations
+ */
+static int sweep(SLayoutParameters Parameters, int Min, int Max, int Factor,
+	double Tolerance, double FloorMs, qint64 MaxBytes)
+{
+	QVector<int> Sizes;
+	for (qint64 n = Min; n <= Max; n *= Factor)
+	{
+		Sizes.append(int(n));
+	}
+
+	printf("%-18s", "widgets");
+	for (auto n : Sizes)
+	{
+		printf(" %12d", n);
+	}
+	printf("\n");
+
+	QVector<QVector<double>> Results;
+	QVector<SMemory> Memory(Sizes.count());
+	QVector<SRestorePasses> Restore(Sizes.count());
+	for (int i = 0; i < Sizes.count(); ++i)
+	{
+		Parameters.DockWidgets = Sizes[i];
+		Results.append(measure(Parameters, Memory[i], Restore[i]));
+	}
+
+	int Flagged = 0;
+	for (int Op = 0; Op < OperationCount; ++Op)
+	{
+		printf("%-18s", OperationNames[Op]);
+		for (const auto& Result : Results)
+		{
+			printf(" %9.2f ms", Result[Op]);
+		}
+
+		// The growth exponent between two sizes is 1 for linear cost and
+		// 2 for quadratic cost. Very small times are dominated by noise, so
+		// both times need to be above the floor.
+		QStringList Warnings;
+		for (int i = 1; i < Results.count(); ++i)
+		{
+			double t0 = Results[i - 1][Op];
+			double t1 = Results[i][Op];
+			if (t0 <= 0 || t0 < FloorMs || t1 < FloorMs)
+			{
+				continue;
+			}
+			double Exponent = log(t1 / t0) / log(double(Sizes[i]) / Sizes[i - 1]);
+			if (Exponent > 1.0 + Tolerance)
+			{
+				Warnings.append(QString("%1->%2: n^%3").arg(Sizes[i - 1]).arg(Sizes[i])
+					.arg(Exponent, 0, 'f', 2));
+			}
+		}
+
+		if (!Warnings.isEmpty())
+		{
+			++Flagged;
+			printf("  SUPER-LINEAR (%s)", qPrintable(Warnings.join(", ")));
+		}
+		printf("\n");
+	}
+
+	// Restoring a layout should apply the final geometry of each dock area
+	// and splitter in one pass
+	bool RelayoutsFlagged = false;
+	printf("%-18s", "restore relayouts");
+	for (const auto& r : Restore)
+	{
+		printf(" %12d", r.Relayouts);
+		RelayoutsFlagged |= (r.Relayouts > 0);
+	}
+	if (RelayoutsFlagged)
+	{
+		++Flagged;
+		printf("  GEOMETRY CHANGED AFTER RESTORE");
+	}
+	printf("\n");
+
+	bool ResizesFlagged = false;
+	printf("%-18s", "restore resizes");
+	for (const auto& r : Restore)
+	{
+		printf(" %12d", r.MaxResizes);
+		ResizesFlagged |= (r.MaxResizes > 1);
+	}
+	if (ResizesFlagged)
+	{
+		++Flagged;
+		printf("  MULTIPLE RESIZES");
+	}
+	printf("\n");
+
+	// The memory per dock widget should stay constant for all sizes
+	bool MemoryFlagged = false;
+	printf("%-18s", "heap/widget");
+	for (const auto& m : Memory)
+	{
+		printf(" %10lld B", (long long)m.HeapBytesPerWidget);
+		MemoryFlagged |= exceedsMaxBytes(m, MaxBytes);
+	}
+	if (MemoryFlagged)
+	{
+		++Flagged;
+		printf("  ABOVE TARGET (%lld B)", (long long)MaxBytes);
+	}
+	printf("\n%-18s", "shallow/widget");
+	for (const auto& m : Memory)
+	{
+		printf(" %10lld B", (long long)m.ShallowBytesPerWidget);
+	}
+	printf("\n");
+	return Flagged;
+}
+
+
+/**
+ * Prints the memory use of a generated layout by component type and
+ * returns true, if the heap bytes per dock widget are within the target
+ */
+static bool memory(const SLayoutParameters& Parameters, qint64 MaxBytes)
+{
+	qint64 HeapBefore = heapBytes();
+	QScopedPointer<QMainWindow> MainWindow(new QMainWindow());
+	auto DockManager = new ads::CDockManager(MainWindow.data());
+	MainWindow->resize(1600, 1000);
+	MainWindow->show();
+	auto DockWidgets = CLayoutGenerator::generate(DockManager, Parameters);
+	QCoreApplication::processEvents();
+
+	SMemory Memory;
+	if (HeapBefore >= 0 && !DockWidgets.isEmpty())
+	{
+		Memory.HeapBytesPerWidget = (heapBytes() - HeapBefore) / DockWidgets.count();
+	}
+	auto Usage = DockManager->memoryUsage();
+	printf("%-20s %8s %12s\n", "component", "count", "bytes");
+	printf("%s", qPrintable(Usage.toString()));
+	printf("shallow bytes per dock widget: %lld\n", (long long)Usage.bytesPerDockWidget());
+	printf("heap bytes per dock widget:    %lld\n", (long long)Memory.HeapBytesPerWidget);
+
+	// Title bar buttons are created when they become visible for the first
+	// time, so this shows how many buttons a dock area really needs
+	QSet<ads::CTitleBarButton*> Buttons;
+	for (auto Button : DockManager->findChildren<ads::CTitleBarButton*>())
+	{
+		Buttons.insert(Button);
+	}
+	for (auto FloatingWidget : DockManager->floatingWidgets())
+	{
+		for (auto Button : FloatingWidget->findChildren<ads::CTitleBarButton*>())
+		{
+			Buttons.insert(Button);
+		}
+	}
+	int DockAreas = Usage.count(ads::CDockMemoryUsage::DockAreas);
+	printf("title bar buttons per dock area: %.2f\n",
+		DockAreas ? double(Buttons.count()) / DockAreas : 0.0);
+	if (exceedsMaxBytes(Memory, MaxBytes))
+	{
+		printf("ABOVE TARGET (%lld B)\n", (long long)MaxBytes);
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Measures the quick open queries of a generated layout and returns true,
+ * if no query takes longer than the given maximum
+ */
+static bool quickOpen(const SLayoutParameters& Parameters, double MaxMs)
+{
+	// Substring, fuzzy, multi word, empty and unmatched queries
+	static const char* const Queries[] = {"dock", "dock 4711", "ock 99", "9999",
+		"dk12", "d 1 2", "", "xyz"};
+	static const int Repetitions = 20;
+
+	QScopedPointer<QMainWindow> MainWindow(new QMainWindow());
+	auto DockManager = new ads::CDockManager(MainWindow.data());
+	CLayoutGenerator::generate(DockManager, Parameters);
+	QElapsedTimer Timer;
+	Timer.start();
+	auto Index = DockManager->dockWidgetIndex();
+	printf("index of %d dock widgets built in %.2f ms\n", Index->count(),
+		Timer.nsecsElapsed() / 1000000.0);
+
+	bool Result = true;
+	printf("%-12s %8s %10s %10s\n", "query", "results", "avg", "max");
+	for (auto Query : Queries)
+	{
+		double Total = 0;
+		double Max = 0;
+		int Count = 0;
+		for (int i = 0; i < Repetitions; ++i)
+		{
+			Timer.start();
+			Count = Index->query(QString::fromLatin1(Query)).count();
+			double Ms = Timer.nsecsElapsed() / 1000000.0;
+			Total += Ms;
+			Max = qMax(Max, Ms);
+		}
+
+		printf("%-12s %8d %7.3f ms %7.3f ms", qPrintable(QString("\"%1\"").arg(Query)),
+			Count, Total / Repetitions, Max);
+		if (Max > MaxMs)
+		{
+			Result = false;
+			printf("  ABOVE TARGET (%.1f ms)", MaxMs);
+		}
+		printf("\n");
+	}
+	return Result;
+}
+
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+/**
+ * Sends activation changes to the main window with floating widgets and
+ * returns true, if the X11 requests match the expected requests
+ */
+static bool stacking(int FloatingWidgets)
+{
+	if (QGuiApplication::platformName() != QLatin1String("xcb"))
+	{
+		fprintf(stderr, "The stacking mode requires the xcb platform, e.g. run it with xvfb-run\n");
+		return false;
+	}
+
+	QScopedPointer<QMainWindow> MainWindow(new QMainWindow());
+	auto DockManager = new ads::CDockManager(MainWindow.data());
+	MainWindow->resize(1600, 1000);
+	MainWindow->show();
+	auto DockWidgets = CLayoutGenerator::createDockWidgets(FloatingWidgets);
+	for (auto DockWidget : DockWidgets)
+	{
+		DockManager->addDockWidgetFloating(DockWidget);
+	}
+	QCoreApplication::processEvents();
+
+	// The window system may have activated or deactivated the main window
+	// already, so the floating widgets are brought into a known state first
+	QEvent Prepare(QEvent::WindowDeactivate);
+	QCoreApplication::sendEvent(MainWindow.data(), &Prepare);
+
+	// Each activation change sends one client message per floating widget
+	// whose state changes and flushes once. Repeated activation changes do
+	// not change any state.
+	struct SStep
+	{
+		const char* Name;
+		QEvent::Type Event;
+		int ClientMessages;
+		int Flushes;
+	};
+	const SStep Steps[] = {
+		{"activate", QEvent::WindowActivate, FloatingWidgets, 1},
+		{"activate again", QEvent::WindowActivate, 0, 0},
+		{"deactivate", QEvent::WindowDeactivate, FloatingWidgets, 1},
+		{"deactivate again", QEvent::WindowDeactivate, 0, 0}};
+
+	bool Result = true;
+	printf("%-18s %16s %16s\n", "step", "client messages", "flushes");
+	for (const auto& Step : Steps)
+	{
+		ads::internal::xcb_reset_request_counts();
+		QEvent Event(Step.Event);
+		QCoreApplication::sendEvent(MainWindow.data(), &Event);
+		auto Counts = ads::internal::xcb_request_counts();
+		printf("%-18s %7d (exp %3d) %7d (exp %3d)", Step.Name, Counts.ClientMessages,
+			Step.ClientMessages, Counts.Flushes, Step.Flushes);
+		if (Counts.ClientMessages != Step.ClientMessages || Counts.Flushes != Step.Flushes)
+		{
+			Result = false;
+			printf("  UNEXPECTED REQUESTS");
+		}
+		printf("\n");
+	}
+	return Result;
+}
+#endif
+
+
+int main(int argc, char *argv[])
+{
+	QApplication App(argc, argv);
+	ads::CDockManager::setAutoHideConfigFlags(ads::CDockManager::DefaultAutoHideConfig);
+
+	QCommandLineParser Parser;
+	Parser.setApplicationDescription("Generates large dock layouts and "
+		"detects docking operations with super-linear cost");
+	Parser.addHelpOption();
+	Parser.addPositionalArgument("mode", "generate, sweep, memory, quickopen or stacking");
+	Parser.addPositionalArgument("file", "The layout file for generate mode");
+	QCommandLineOption WidgetsOption("widgets",
+		"Number of dock widgets, the quick open mode uses 10000 by default", "count", "100");
+	QCommandLineOption DepthOption("depth", "Maximum splitter nesting depth", "depth", "4");
+	QCommandLineOption FloatingOption("floating",
+		"Number of floating windows, the stacking mode uses 20 by default", "count", "2");
+	QCommandLineOption AutoHideOption("autohide", "Number of auto hide side bar entries", "count", "4");
+	QCommandLineOption SeedOption("seed", "Seed of the random generator", "seed", "1");
+	QCommandLineOption MinOption("min", "Smallest number of dock widgets", "count", "10");
+	QCommandLineOption MaxOption("max", "Largest number of dock widgets", "count", "1000");
+	QCommandLineOption FactorOption("factor", "Growth factor between the sizes", "factor", "10");
+	QCommandLineOption ToleranceOption("tolerance", "Allowed growth exponent above 1", "value", "0.3");
+	QCommandLineOption FloorOption("floor", "Ignore times below this value", "ms", "5");
+	QCommandLineOption MaxBytesOption("max-bytes", "Target heap bytes per dock widget, 0 disables the check", "bytes", "32768");
+	QCommandLineOption MaxMsOption("max-ms", "Maximum time of one quick open query", "ms", "16");
+	Parser.addOptions({WidgetsOption, DepthOption, FloatingOption, AutoHideOption,
+		SeedOption, MinOption, MaxOption, FactorOption, ToleranceOption, FloorOption,
+		MaxBytesOption, MaxMsOption});
+	Parser.process(App);
+
+	SLayoutParameters Parameters;
+	Parameters.DockWidgets = Parser.value(WidgetsOption).toInt();
+	Parameters.Depth = Parser.value(DepthOption).toInt();
+	Parameters.FloatingWindows = Parser.value(FloatingOption).toInt();
+	Parameters.AutoHideWidgets = Parser.value(AutoHideOption).toInt();
+	Parameters.Seed = Parser.value(SeedOption).toUInt();
+
+	qint64 MaxBytes = Parser.value(MaxBytesOption).toLongLong();
+	auto Args = Parser.positionalArguments();
+	auto Mode = Args.value(0, "sweep");
+	if (Mode == QLatin1String("generate") && Args.count() == 2)
+	{
+		if (!CLayoutGenerator::generateFile(Args[1], Parameters))
+		{
+			fprintf(stderr, "Failed to write %s\n", qPrintable(Args[1]));
+			return 1;
+		}
+		return 0;
+	}
+	else if (Mode == QLatin1String("sweep"))
+	{
+		int Factor = qMax(2, Parser.value(FactorOption).toInt());
+		int Flagged = sweep(Parameters, qMax(1, Parser.value(MinOption).toInt()),
+			Parser.value(MaxOption).toInt(), Factor,
+			Parser.value(ToleranceOption).toDouble(), Parser.value(FloorOption).toDouble(),
+			MaxBytes);
+		return Flagged ? 2 : 0;
+	}
+	else if (Mode == QLatin1String("memory"))
+	{
+		return memory(Parameters, MaxBytes) ? 0 : 2;
+	}
+	else if (Mode == QLatin1String("quickopen"))
+	{
+		if (!Parser.isSet(WidgetsOption))
+		{
+			Parameters.DockWidgets = 10000;
+		}
+		return quickOpen(Parameters, Parser.value(MaxMsOption).toDouble()) ? 0 : 2;
+	}
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+	else if (Mode == QLatin1String("stacking"))
+	{
+		int FloatingWidgets = Parser.isSet(FloatingOption) ? Parameters.FloatingWindows : 20;
+		return stacking(qMax(1, FloatingWidgets)) ? 0 : 2;
+	}
+#endif
+
+	Parser.showHelp(1);
+	return 1;
+}
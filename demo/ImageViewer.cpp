@@ -275,6 +275,20 @@ void CImageViewer::wheelEvent(QWheelEvent* Event)
 	d->RenderWidget->zoomByValue(Zoom);
 }
 
+
+//============================================================================
+void CImageViewer::pauseContent()
+{
+	d->RenderWidget->pauseContent();
+}
+
+
+//============================================================================
+void CImageViewer::resumeContent()
+{
+	d->RenderWidget->resumeContent();
+}
+
 #include "moc_ImageViewer.cpp"
 //---------------------------------------------------------------------------
 // EOF ImageViewer.cpp
@@ -12,6 +12,8 @@
 //============================================================================
 #include <QScrollArea>
 
+#include "DockWidget.h"
+
 QT_BEGIN_NAMESPACE
 class QLabel;
 QT_END_NAMESPACE
@@ -22,7 +24,7 @@ struct ImageViewerPrivate;
 /**
  * Tiny simple image viewer for showing images in demo
  */
-class CImageViewer : public QScrollArea
+class CImageViewer : public QScrollArea, public ads::IDockWidgetContent
 {
 	Q_OBJECT
 public:
@@ -34,6 +36,16 @@ public:
 	bool loadFile(const QString& Filename);
 	void setImage(const QImage &newImage);
 
+	/**
+	 * @brief Pauses the render widget if the viewer is not visible
+	 */
+	virtual void pauseContent() override;
+
+	/**
+	 * @brief Resumes the render widget
+	 */
+	virtual void resumeContent() override;
+
 public Q_SLOTS:
 	void open();
     void zoomIn();
@@ -29,9 +29,34 @@ CRenderWidget::~CRenderWidget()
 
 }
 
+
+//===========================================================================
+void CRenderWidget::pauseContent()
+{
+	m_Paused = true;
+}
+
+
+//===========================================================================
+void CRenderWidget::resumeContent()
+{
+	m_Paused = false;
+	if (!m_PendingImage.isNull())
+	{
+		showImage(m_PendingImage);
+		m_PendingImage = QImage();
+	}
+}
+
 //===========================================================================
 void CRenderWidget::showImage(const QImage& Image)
 {
+	if (m_Paused)
+	{
+		m_PendingImage = Image;
+		return;
+	}
+
 	m_Image = QPixmap::fromImage(Image);
 	this->adjustWidgetSize();
 	this->repaint();
@@ -12,22 +12,23 @@
 //============================================================================
 #include <QWidget>
 #include <QPixmap>
+#include <QImage>
 
-//============================================================================
-//                           FORWARD DECLARATIONS
-//============================================================================
-class QImage;
-
+#include "DockWidget.h"
 
 /**
  * @brief Widget for fast display of images (i.e. for video capture devices)
+ * If the widget is paused because its dock widget is not visible, only the
+ * last image is stored and it is converted and painted on resume.
  */
-class CRenderWidget : public QWidget
+class CRenderWidget : public QWidget, public ads::IDockWidgetContent
 {
 	Q_OBJECT
 private:
 	QPixmap m_Image;
+	QImage m_PendingImage;
 	double m_ScaleFactor;
+	bool m_Paused = false;
 
 protected:
 	/**
@@ -57,6 +58,16 @@ public:
 	 */
 	virtual ~CRenderWidget();
 
+	/**
+	 * @brief Stops the conversion and painting of new images
+	 */
+	virtual void pauseContent() override;
+
+	/**
+	 * @brief Shows the last image that arrived while the widget was paused
+	 */
+	virtual void resumeContent() override;
+
 signals:
 	/**
 	 * @brief Signalize change of captured image size.
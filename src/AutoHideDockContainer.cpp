@@ -36,13 +36,16 @@
 #include <QPointer>
 #include <QApplication>
 #include <QCursor>
+#include <QTimer>
 
 #include "DockManager.h"
 #include "DockAreaWidget.h"
+#include "DockMemoryUsage.h"
 #include "ResizeHandle.h"
 #include "DockComponentsFactory.h"
 #include "AutoHideSideBar.h"
 #include "AutoHideTab.h"
+#include "DockLayoutSnapshot.h"
 
 namespace ads
 {
@@ -114,13 +117,42 @@ struct AutoHideDockContainerPrivate
 	CResizeHandle* ResizeHandle = nullptr;
 	QSize Size; // creates invalid size
 	QPointer<CAutoHideTab> SideTab;
+	bool SideTabRecycled = false;
 	QSize SizeCache;
+	QSize PrewarmedSize; // invalid until the first prewarm
+	QPixmap Snapshot;
+	bool PrewarmPending = false;
 
 	/**
 	 * Private data constructor
 	 */
 	AutoHideDockContainerPrivate(CAutoHideDockContainer *_public);
 
+	/**
+	 * Returns true if the given auto hide config flag is set for the dock
+	 * manager of this container
+	 */
+	bool testAutoHideConfigFlag(CDockManager::eAutoHideFlag Flag) const
+	{
+		return CDockManager::testAutoHideConfigFlag(DockArea ? DockArea->dockManager() : nullptr, Flag);
+	}
+
+	/**
+	 * Schedules a prewarm of the hidden container for the next time the
+	 * event loop becomes idle, if prewarming is enabled
+	 */
+	void schedulePrewarm()
+	{
+		if (PrewarmPending
+		 || !testAutoHideConfigFlag(CDockManager::AutoHidePrewarmContent))
+		{
+			return;
+		}
+
+		PrewarmPending = true;
+		QTimer::singleShot(0, _this, &CAutoHideDockContainer::prewarm);
+	}
+
 	/**
 	 * Convenience function to get a dock widget area
 	 */
@@ -196,9 +228,11 @@ CAutoHideDockContainer::CAutoHideDockContainer(CDockWidget* DockWidget, SideBarL
 {
 	hide(); // auto hide dock container is initially always hidden
 	d->SideTabBarArea = area;
-	d->SideTab = componentsFactory()->createDockWidgetSideTab(nullptr);
+	auto DockManager = DockWidget->dockManager();
+	d->SideTab = DockManager ? DockManager->takeAutoHideTab()
+		: componentsFactory()->createDockWidgetSideTab(nullptr);
 	connect(d->SideTab, &CAutoHideTab::pressed, this, &CAutoHideDockContainer::toggleCollapseState);
-	d->DockArea = new CDockAreaWidget(DockWidget->dockManager(), parent);
+	d->DockArea = new CDockAreaWidget(DockManager, parent);
 	d->DockArea->setObjectName("autoHideDockArea");
 	d->DockArea->setAutoHideDockContainer(this);
 
@@ -210,7 +244,7 @@ CAutoHideDockContainer::CAutoHideDockContainer(CDockWidget* DockWidget, SideBarL
 	setLayout(d->Layout);
 	d->ResizeHandle = new CResizeHandle(edgeFromSideTabBarArea(area), this);
 	d->ResizeHandle->setMinResizeSize(64);
-	bool OpaqueResize = CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize);
+	bool OpaqueResize = CDockManager::testConfigFlag(d->DockArea->dockManager(), CDockManager::OpaqueSplitterResize);
 	d->ResizeHandle->setOpaqueResize(OpaqueResize);
 	d->Size = d->DockArea->size();
 	d->SizeCache = DockWidget->size();
@@ -223,6 +257,7 @@ CAutoHideDockContainer::CAutoHideDockContainer(CDockWidget* DockWidget, SideBarL
 	// setGeometry: Unable to set geometry XxY+Width+Height on QWidgetWindow/'WidgetClassWindow
 	d->Layout->addWidget(d->DockArea);
 	d->Layout->insertWidget(resizeHandleLayoutPosition(area), d->ResizeHandle);
+	d->schedulePrewarm();
 }
 
 
@@ -292,7 +327,7 @@ CAutoHideDockContainer::~CAutoHideDockContainer()
 		dockContainer()->removeAutoHideWidget(this);
 	}
 
-	if (d->SideTab)
+	if (d->SideTab && !d->SideTabRecycled)
 	{
 		delete d->SideTab;
 	}
@@ -412,6 +447,14 @@ void CAutoHideDockContainer::cleanupAndDelete()
         SideTab->removeFromSideBar();
         SideTab->setParent(nullptr);
         SideTab->hide();
+
+        // The dock manager takes over the tab, if it recycles auto hide tabs
+        auto DockManager = dockWidget->dockManager();
+        if (DockManager && DockManager->recycleAutoHideTab(SideTab))
+        {
+        	SideTab->disconnect(this);
+        	d->SideTabRecycled = true;
+        }
 	}
 
 	hide();
@@ -422,11 +465,15 @@ void CAutoHideDockContainer::cleanupAndDelete()
 //============================================================================
 void CAutoHideDockContainer::saveState(QXmlStreamWriter& s)
 {
-	s.writeStartElement("Widget");
-	s.writeAttribute("Name", d->DockWidget->objectName());
-	s.writeAttribute("Closed", QString::number(d->DockWidget->isClosed() ? 1 : 0));
-    s.writeAttribute("Size", QString::number(d->isHorizontal() ? d->Size.height() : d->Size.width()));
-	s.writeEndElement();
+	layoutSnapshot().writeState(s);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CAutoHideDockContainer::layoutSnapshot() const
+{
+	return CDockLayoutSnapshot::createDockWidget(d->DockWidget->objectName(),
+		d->DockWidget->isClosed(), d->isHorizontal() ? d->Size.height() : d->Size.width());
 }
 
 
@@ -459,6 +506,10 @@ void CAutoHideDockContainer::collapseView(bool Enable)
 	{
 		hide();
 		qApp->removeEventFilter(this);
+		// The content has just been shown with its current size, so there is
+		// no need to prewarm it again as long as the size does not change
+		d->PrewarmedSize = size();
+		d->Snapshot = QPixmap();
 	}
 	else
 	{
@@ -495,6 +546,10 @@ void CAutoHideDockContainer::setSize(int Size)
 	}
 
 	updateSize();
+	if (!isVisible())
+	{
+		d->schedulePrewarm();
+	}
 }
 
 
@@ -705,5 +760,78 @@ int CAutoHideDockContainer::tabIndex() const
 	return d->SideTab->tabIndex();
 }
 
+
+//============================================================================
+void CAutoHideDockContainer::prewarm()
+{
+	d->PrewarmPending = false;
+	if (isVisible() || !d->DockWidget || d->DockWidget->isClosed())
+	{
+		return;
+	}
+
+	updateSize();
+	if (isPrewarmed())
+	{
+		return;
+	}
+
+	// ensurePolished() polishes the complete widget tree. Then we activate
+	// the layouts top down - findChildren() returns parents before their
+	// children - so that each child layout sees the final geometry of its
+	// parent and every widget is laid out only once. Layouts of hidden
+	// widgets are not activated by the layout request events, so we need to
+	// do this explicitly here.
+	ensurePolished();
+	d->DockArea->resize(size());
+	if (layout())
+	{
+		layout()->activate();
+	}
+	const auto Children = findChildren<QWidget*>();
+	for (auto Child : Children)
+	{
+		if (Child->layout())
+		{
+			Child->layout()->activate();
+		}
+	}
+
+	d->PrewarmedSize = size();
+	if (d->testAutoHideConfigFlag(CDockManager::AutoHidePrewarmSnapshot))
+	{
+		// grab() renders the hidden widget tree offscreen. This also delivers
+		// the pending resize events, so the first real paint does not need
+		// to do this anymore
+		d->Snapshot = grab();
+	}
+	else
+	{
+		d->Snapshot = QPixmap();
+	}
+	ADS_PRINT("CAutoHideDockContainer::prewarm " << size());
+}
+
+
+//============================================================================
+bool CAutoHideDockContainer::isPrewarmed() const
+{
+	return d->PrewarmedSize.isValid() && (d->PrewarmedSize == size());
+}
+
+
+//============================================================================
+QPixmap CAutoHideDockContainer::contentSnapshot() const
+{
+	return isPrewarmed() ? d->Snapshot : QPixmap();
+}
+
+
+//============================================================================
+std::size_t internal::privateDataSize(const CAutoHideDockContainer*)
+{
+	return sizeof(AutoHideDockContainerPrivate);
+}
+
 }
 
@@ -32,6 +32,7 @@
 #include "ads_globals.h"
 
 #include <QSplitter>
+#include <QPixmap>
 #include "AutoHideTab.h"
 
 QT_FORWARD_DECLARE_CLASS(QXmlStreamWriter)
@@ -45,6 +46,7 @@ class CDockContainerWidget;
 class CAutoHideSideBar;
 class CDockAreaWidget;
 class CDockingStateReader;
+class CDockLayoutSnapshot;
 struct SideTabBarPrivate;
 
 /**
@@ -76,6 +78,11 @@ protected:
 	 */
 	void saveState(QXmlStreamWriter& Stream);
 
+	/**
+	 * Returns a snapshot node of the dock widget and its size
+	 */
+	CDockLayoutSnapshot layoutSnapshot() const;
+
 public:
 	using Super = QFrame;
 
@@ -195,6 +202,29 @@ public:
 	 * it to the new side bar given in SideBarLocation
 	 */
 	void moveToNewSideBarLocation(SideBarLocation SideBarLocation, int TabIndex = -1);
+
+	/**
+	 * Polishes and lays out the hidden container and its content at the
+	 * size it will have when it slides in.
+	 * This is done automatically in idle time if the AutoHidePrewarmContent
+	 * flag is set. The function does nothing if the container is visible or
+	 * if it has already been prewarmed for the current target size.
+	 */
+	void prewarm();
+
+	/**
+	 * Returns true, if the container has been prewarmed for its current
+	 * target size
+	 */
+	bool isPrewarmed() const;
+
+	/**
+	 * Returns the content snapshot that has been cached by the last prewarm()
+	 * call if the AutoHidePrewarmSnapshot flag is set. The snapshot may be
+	 * used for slide in animations. Returns a null pixmap if there is no
+	 * valid snapshot for the current target size.
+	 */
+	QPixmap contentSnapshot() const;
 };
 } // namespace ads
 
@@ -36,11 +36,13 @@
 #include <QXmlStreamWriter>
 
 #include "DockContainerWidget.h"
+#include "DockMemoryUsage.h"
 #include "DockWidgetTab.h"
 #include "DockFocusController.h"
 #include "AutoHideDockContainer.h"
 #include "DockAreaWidget.h"
 #include "AutoHideTab.h"
+#include "DockLayoutSnapshot.h"
 
 namespace ads
 {
@@ -391,10 +393,15 @@ void CAutoHideSideBar::saveState(QXmlStreamWriter& s) const
 		return;
 	}
 
-	s.writeStartElement("SideBar");
-	s.writeAttribute("Area", QString::number(sideBarLocation()));
-	s.writeAttribute("Tabs", QString::number(count()));
+	layoutSnapshot().writeState(s);
+}
+
 
+//============================================================================
+CDockLayoutSnapshot CAutoHideSideBar::layoutSnapshot() const
+{
+	QVector<CDockLayoutSnapshot> DockWidgets;
+	DockWidgets.reserve(count());
 	for (auto i = 0; i < count(); ++i)
 	{
 		auto Tab = tab(i);
@@ -403,10 +410,10 @@ void CAutoHideSideBar::saveState(QXmlStreamWriter& s) const
 			continue;
 		}
 
-		Tab->dockWidget()->autoHideDockContainer()->saveState(s);
+		DockWidgets.append(Tab->dockWidget()->autoHideDockContainer()->layoutSnapshot());
 	}
 
-	s.writeEndElement();
+	return CDockLayoutSnapshot::createSideBar(sideBarLocation(), DockWidgets);
 }
 
 //===========================================================================
@@ -503,5 +510,12 @@ int CAutoHideSideBar::tabInsertIndexAt(const QPoint& Pos) const
 	}
 }
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CAutoHideSideBar*)
+{
+	return sizeof(AutoHideSideBarPrivate);
+}
+
 } // namespace ads
 
@@ -43,6 +43,7 @@ class CDockContainerWidget;
 class CAutoHideTab;
 class CAutoHideDockContainer;
 class CDockingStateReader;
+class CDockLayoutSnapshot;
 
 /**
  * Side tab bar widget that is shown at the edges of a dock container.
@@ -76,6 +77,11 @@ protected:
 	 */
 	void saveState(QXmlStreamWriter& Stream) const;
 
+	/**
+	 * Returns a snapshot node of this side bar and its dock widgets
+	 */
+	CDockLayoutSnapshot layoutSnapshot() const;
+
 	/**
 	 * Inserts the given dock widget tab at the given position.
 	 * An Index value of -1 appends the side tab at the end.
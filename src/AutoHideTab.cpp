@@ -38,6 +38,7 @@
 #include "AutoHideSideBar.h"
 #include "DockAreaWidget.h"
 #include "DockManager.h"
+#include "DockMemoryUsage.h"
 #include "DockWidget.h"
 #include "FloatingDragPreview.h"
 #include "DockOverlay.h"
@@ -67,6 +68,15 @@ struct AutoHideTabPrivate
 	 */
 	AutoHideTabPrivate(CAutoHideTab* _public);
 
+	/**
+	 * Returns true if the given auto hide config flag is set for the dock
+	 * manager of the dock widget
+	 */
+	bool testAutoHideConfigFlag(CDockManager::eAutoHideFlag Flag) const
+	{
+		return CDockManager::testAutoHideConfigFlag(DockWidget ? DockWidget->dockManager() : nullptr, Flag);
+	}
+
 	/**
 	 * Update the orientation, visibility and spacing based on the area of
 	 * the side bar
@@ -155,7 +165,7 @@ AutoHideTabPrivate::AutoHideTabPrivate(CAutoHideTab* _public) :
 //============================================================================
 void AutoHideTabPrivate::updateOrientation()
 {
-	bool IconOnly = CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideSideBarsIconOnly);
+	bool IconOnly = testAutoHideConfigFlag(CDockManager::AutoHideSideBarsIconOnly);
 	if (IconOnly && !_this->icon().isNull())
 	{
 		_this->setText("");
@@ -245,6 +255,24 @@ void CAutoHideTab::removeFromSideBar()
     setSideBar(nullptr);
 }
 
+//============================================================================
+void CAutoHideTab::resetForReuse()
+{
+	removeFromSideBar();
+	d->DockWidget = nullptr;
+	d->MousePressed = false;
+	d->DragState = DraggingInactive;
+	d->FloatingWidget = nullptr;
+	setText(QString());
+	setIcon(QIcon());
+	setToolTip(QString());
+	// The tab has been hidden explicitly when it was removed from its side
+	// bar, but it should become visible again when it is inserted into a
+	// side bar layout
+	setAttribute(Qt::WA_WState_ExplicitShowHide, false);
+}
+
+
 //============================================================================
 CAutoHideTab::CAutoHideTab(QWidget* parent) :
 	CPushButton(parent),
@@ -344,7 +372,7 @@ void CAutoHideTab::setDockWidget(CDockWidget* DockWidget)
 //============================================================================
 bool CAutoHideTab::event(QEvent* event)
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideShowOnMouseOver))
+	if (!d->testAutoHideConfigFlag(CDockManager::AutoHideShowOnMouseOver))
 	{
 		return Super::event(event);
 	}
@@ -366,7 +394,7 @@ bool CAutoHideTab::event(QEvent* event)
 //============================================================================
 bool CAutoHideTab::iconOnly() const
 {
-	return CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideSideBarsIconOnly) && !icon().isNull();
+	return d->testAutoHideConfigFlag(CDockManager::AutoHideSideBarsIconOnly) && !icon().isNull();
 }
 
 
@@ -557,4 +585,10 @@ int CAutoHideTab::tabIndex() const
 }
 
 
+//============================================================================
+std::size_t internal::privateDataSize(const CAutoHideTab*)
+{
+	return sizeof(AutoHideTabPrivate);
+}
+
 }
@@ -64,6 +64,7 @@ private:
 	friend class CDockAreaWidget;
 	friend class CDockContainerWidget;
 	friend DockContainerWidgetPrivate;
+	friend struct DockManagerPrivate;
 
 private Q_SLOTS:
 	void onAutoHideToActionClicked();
@@ -71,6 +72,14 @@ private Q_SLOTS:
 protected:
 	void setSideBar(CAutoHideSideBar *SideTabBar);
 	void removeFromSideBar();
+
+	/**
+	 * Resets the internal state of this tab, that has been removed from its
+	 * side bar, so that the dock manager can keep it in its auto hide tab
+	 * pool
+	 */
+	void resetForReuse();
+
 	virtual bool event(QEvent* event) override;
 	virtual void contextMenuEvent(QContextMenuEvent* ev) override;
 	virtual void mousePressEvent(QMouseEvent* ev) override;
@@ -38,6 +38,7 @@
 #include <QtGlobal>
 #include <QTimer>
 
+#include "DockMemoryUsage.h"
 #include "FloatingDockContainer.h"
 #include "DockAreaWidget.h"
 #include "DockManager.h"
@@ -567,6 +568,13 @@ int CDockAreaTabBar::tabInsertIndexAt(const QPoint& Pos) const
 	}
 }
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CDockAreaTabBar*)
+{
+	return sizeof(DockAreaTabBarPrivate);
+}
+
 } // namespace ads
 
 
@@ -39,9 +39,11 @@
 #include <QDebug>
 #include <QPointer>
 #include <QApplication>
+#include <QTimer>
 
 #include "DockAreaTitleBar_p.h"
 #include "ads_globals.h"
+#include "DockMemoryUsage.h"
 #include "FloatingDockContainer.h"
 #include "FloatingDragPreview.h"
 #include "DockAreaWidget.h"
@@ -74,7 +76,11 @@ struct DockAreaTitleBarPrivate
 	CDockAreaTabBar* TabBar;
 	CElidingLabel* AutoHideTitleLabel = nullptr;
 	bool MenuOutdated = true;
-	QMenu* TabsMenu;
+	QMenu* TabsMenu = nullptr;
+	QMenu* ContextMenu = nullptr;
+	int ContextMenuKey = -1;
+	int DisabledButtons = 0;
+	int HiddenButtons = 0;
 	QList<tTitleBarButton*> DockWidgetActionsButtons;
 
 	QPoint DragStartMousePos;
@@ -88,9 +94,41 @@ struct DockAreaTitleBarPrivate
 	DockAreaTitleBarPrivate(CDockAreaTitleBar* _public);
 
 	/**
-	 * Creates the title bar close and menu buttons
+	 * Returns the given button or a nullptr if it has not been created yet
 	 */
-	void createButtons();
+	CTitleBarButton* button(TitleBarButton Which) const;
+
+	/**
+	 * Returns true, if the given button is configured to be shown in the
+	 * title bar
+	 */
+	bool showInTitleBar(TitleBarButton Which) const;
+
+	/**
+	 * Creates the given title bar button and inserts it into the layout.
+	 * The buttons are created on demand when they become visible for the
+	 * first time.
+	 */
+	CTitleBarButton* createButton(TitleBarButton Which);
+
+	/**
+	 * Returns the layout index for the given button. The buttons keep their
+	 * order, independently of the order in which they are created.
+	 */
+	int buttonInsertIndex(TitleBarButton Which) const;
+
+	/**
+	 * Creates the empty tabs menu of the tabs menu button. The menu is
+	 * populated when it is shown.
+	 */
+	void createTabsMenu();
+
+	/**
+	 * Returns the context menu. The menu is built on first use and only
+	 * rebuilt if the state of the dock area that affects its entries
+	 * changes.
+	 */
+	QMenu* contextMenu();
 
 
 	/**
@@ -112,21 +150,21 @@ struct DockAreaTitleBarPrivate
 	}
 
 	/**
-	 * Returns true if the given config flag is set
+	 * Returns true if the given config flag is set for the dock manager
 	 * Convenience function to ease config flag testing
 	 */
-	static bool testConfigFlag(CDockManager::eConfigFlag Flag)
+	bool testConfigFlag(CDockManager::eConfigFlag Flag) const
 	{
-		return CDockManager::testConfigFlag(Flag);
+		return CDockManager::testConfigFlag(dockManager(), Flag);
 	}
 
 	/**
-	 * Returns true if the given config flag is set
+	 * Returns true if the given config flag is set for the dock manager
 	 * Convenience function to ease config flag testing
 	 */
-	static bool testAutoHideConfigFlag(CDockManager::eAutoHideFlag Flag)
+	bool testAutoHideConfigFlag(CDockManager::eAutoHideFlag Flag) const
 	{
-		return CDockManager::testAutoHideConfigFlag(Flag);
+		return CDockManager::testAutoHideConfigFlag(dockManager(), Flag);
 	}
 
 	/**
@@ -170,77 +208,224 @@ DockAreaTitleBarPrivate::DockAreaTitleBarPrivate(CDockAreaTitleBar* _public) :
 
 
 //============================================================================
-void DockAreaTitleBarPrivate::createButtons()
+CTitleBarButton* DockAreaTitleBarPrivate::button(TitleBarButton Which) const
+{
+	switch (Which)
+	{
+	case TitleBarButtonTabsMenu: return TabsMenuButton;
+	case TitleBarButtonUndock: return UndockButton;
+	case TitleBarButtonClose: return CloseButton;
+	case TitleBarButtonAutoHide: return AutoHideButton;
+	case TitleBarButtonMinimize: return MinimizeButton;
+	default:
+		return nullptr;
+	}
+}
+
+
+//============================================================================
+bool DockAreaTitleBarPrivate::showInTitleBar(TitleBarButton Which) const
+{
+	switch (Which)
+	{
+	case TitleBarButtonTabsMenu: return testConfigFlag(CDockManager::DockAreaHasTabsMenuButton);
+	case TitleBarButtonUndock: return testConfigFlag(CDockManager::DockAreaHasUndockButton);
+	case TitleBarButtonClose: return testConfigFlag(CDockManager::DockAreaHasCloseButton);
+	case TitleBarButtonAutoHide:
+		 return testAutoHideConfigFlag(CDockManager::DockAreaHasAutoHideButton)
+			 && testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled);
+	case TitleBarButtonMinimize: return testAutoHideConfigFlag(CDockManager::AutoHideHasMinimizeButton);
+	default:
+		return false;
+	}
+}
+
+
+//============================================================================
+int DockAreaTitleBarPrivate::buttonInsertIndex(TitleBarButton Which) const
+{
+	static const TitleBarButton ButtonOrder[] = {TitleBarButtonTabsMenu,
+		TitleBarButtonUndock, TitleBarButtonAutoHide, TitleBarButtonMinimize,
+		TitleBarButtonClose};
+	static const int ButtonCount = sizeof(ButtonOrder) / sizeof(ButtonOrder[0]);
+
+	int Position = 0;
+	while (Position < ButtonCount && ButtonOrder[Position] != Which)
+	{
+		++Position;
+	}
+
+	for (int i = Position - 1; i >= 0; --i)
+	{
+		if (auto Button = button(ButtonOrder[i]))
+		{
+			return Layout->indexOf(Button) + 1;
+		}
+	}
+
+	for (int i = Position + 1; i < ButtonCount; ++i)
+	{
+		if (auto Button = button(ButtonOrder[i]))
+		{
+			return Layout->indexOf(Button);
+		}
+	}
+
+	return Layout->count();
+}
+
+
+//============================================================================
+CTitleBarButton* DockAreaTitleBarPrivate::createButton(TitleBarButton Which)
 {
 	QSizePolicy ButtonSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+	CTitleBarButton* Button = nullptr;
+	switch (Which)
+	{
+	case TitleBarButtonTabsMenu:
+		Button = TabsMenuButton = new CTitleBarButton(showInTitleBar(Which), false, Which);
+		Button->setObjectName("tabsMenuButton");
+		Button->setPopupMode(QToolButton::InstantPopup);
+		internal::setButtonIcon(Button, QStyle::SP_TitleBarUnshadeButton, ads::DockAreaMenuIcon);
+		internal::setToolTip(Button, QObject::tr("List All Tabs"));
+		// The button needs a menu to show its menu indicator
+		createTabsMenu();
+		break;
+
+	case TitleBarButtonUndock:
+		Button = UndockButton = new CTitleBarButton(showInTitleBar(Which), true, Which);
+		Button->setObjectName("detachGroupButton");
+		internal::setToolTip(Button, QObject::tr("Detach Group"));
+		internal::setButtonIcon(Button, QStyle::SP_TitleBarNormalButton, ads::DockAreaUndockIcon);
+		_this->connect(Button, SIGNAL(clicked()), SLOT(onUndockButtonClicked()));
+		break;
+
+	case TitleBarButtonAutoHide:
+		Button = AutoHideButton = new CTitleBarButton(showInTitleBar(Which), true, Which);
+		Button->setObjectName("dockAreaAutoHideButton");
+		internal::setToolTip(Button, _this->titleBarButtonToolTip(TitleBarButtonAutoHide));
+		internal::setButtonIcon(Button, QStyle::SP_DialogOkButton, ads::AutoHideIcon);
+		Button->setCheckable(testAutoHideConfigFlag(CDockManager::AutoHideButtonCheckable));
+		Button->setChecked(DockArea->isAutoHide());
+		_this->connect(Button, SIGNAL(clicked()),  SLOT(onAutoHideButtonClicked()));
+		break;
+
+	case TitleBarButtonMinimize:
+		Button = MinimizeButton = new CTitleBarButton(showInTitleBar(Which), false, Which);
+		Button->setObjectName("dockAreaMinimizeButton");
+		internal::setButtonIcon(Button, QStyle::SP_TitleBarMinButton, ads::DockAreaMinimizeIcon);
+		internal::setToolTip(Button, QObject::tr("Minimize"));
+		_this->connect(Button, SIGNAL(clicked()), SLOT(minimizeAutoHideContainer()));
+		break;
+
+	case TitleBarButtonClose:
+		Button = CloseButton = new CTitleBarButton(showInTitleBar(Which), true, Which);
+		Button->setObjectName("dockAreaCloseButton");
+		internal::setButtonIcon(Button, QStyle::SP_TitleBarCloseButton, ads::DockAreaCloseIcon);
+		internal::setToolTip(Button, _this->titleBarButtonToolTip(TitleBarButtonClose));
+		Button->setIconSize(QSize(16, 16));
+		_this->connect(Button, SIGNAL(clicked()), SLOT(onCloseButtonClicked()));
+		break;
+
+	default:
+		return nullptr;
+	}
+
+	Button->setAutoRaise(true);
+	Button->setSizePolicy(ButtonSizePolicy);
+	Layout->insertWidget(buttonInsertIndex(Which), Button, 0);
+	if (DisabledButtons & (1 << Which))
+	{
+		Button->setEnabled(false);
+	}
+	// The minimize button is only visible in auto hide mode
+	if ((HiddenButtons & (1 << Which)) || TitleBarButtonMinimize == Which)
+	{
+		Button->setVisible(false);
+	}
+	return Button;
+}
+
 
-	// Tabs menu button
-	TabsMenuButton = new CTitleBarButton(testConfigFlag(CDockManager::DockAreaHasTabsMenuButton),
-		false, TitleBarButtonTabsMenu);
-	TabsMenuButton->setObjectName("tabsMenuButton");
-	TabsMenuButton->setAutoRaise(true);
-	TabsMenuButton->setPopupMode(QToolButton::InstantPopup);
-	internal::setButtonIcon(TabsMenuButton, QStyle::SP_TitleBarUnshadeButton, ads::DockAreaMenuIcon);
-	QMenu* TabsMenu = new QMenu(TabsMenuButton);
+//============================================================================
+void DockAreaTitleBarPrivate::createTabsMenu()
+{
+	TabsMenu = new QMenu(TabsMenuButton);
 #ifndef QT_NO_TOOLTIP
 	TabsMenu->setToolTipsVisible(true);
 #endif
 	_this->connect(TabsMenu, SIGNAL(aboutToShow()), SLOT(onTabsMenuAboutToShow()));
-	TabsMenuButton->setMenu(TabsMenu);
-	internal::setToolTip(TabsMenuButton, QObject::tr("List All Tabs"));
-	TabsMenuButton->setSizePolicy(ButtonSizePolicy);
-	Layout->addWidget(TabsMenuButton, 0);
-	_this->connect(TabsMenuButton->menu(), SIGNAL(triggered(QAction*)),
+	_this->connect(TabsMenu, SIGNAL(triggered(QAction*)),
 		SLOT(onTabsMenuActionTriggered(QAction*)));
+	TabsMenuButton->setMenu(TabsMenu);
+}
 
-	// Undock button
-	UndockButton = new CTitleBarButton(testConfigFlag(CDockManager::DockAreaHasUndockButton),
-		true, TitleBarButtonUndock);
-	UndockButton->setObjectName("detachGroupButton");
-	UndockButton->setAutoRaise(true);
-	internal::setToolTip(UndockButton, QObject::tr("Detach Group"));
-	internal::setButtonIcon(UndockButton, QStyle::SP_TitleBarNormalButton, ads::DockAreaUndockIcon);
-	UndockButton->setSizePolicy(ButtonSizePolicy);
-	Layout->addWidget(UndockButton, 0);
-	_this->connect(UndockButton, SIGNAL(clicked()), SLOT(onUndockButtonClicked()));
-
-	// AutoHide Button
-	const auto autoHideEnabled = testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled);
-	AutoHideButton = new CTitleBarButton(testAutoHideConfigFlag(CDockManager::DockAreaHasAutoHideButton) && autoHideEnabled,
-		true, TitleBarButtonAutoHide);
-	AutoHideButton->setObjectName("dockAreaAutoHideButton");
-	AutoHideButton->setAutoRaise(true);
-	internal::setToolTip(AutoHideButton, _this->titleBarButtonToolTip(TitleBarButtonAutoHide));
-	internal::setButtonIcon(AutoHideButton, QStyle::SP_DialogOkButton, ads::AutoHideIcon);
-	AutoHideButton->setSizePolicy(ButtonSizePolicy);
-	AutoHideButton->setCheckable(testAutoHideConfigFlag(CDockManager::AutoHideButtonCheckable));
-	AutoHideButton->setChecked(false);
-	Layout->addWidget(AutoHideButton, 0);
-	_this->connect(AutoHideButton, SIGNAL(clicked()),  SLOT(onAutoHideButtonClicked()));
-
-	// Minimize button
-	MinimizeButton = new CTitleBarButton(testAutoHideConfigFlag(CDockManager::AutoHideHasMinimizeButton),
-		false, TitleBarButtonMinimize);
-	MinimizeButton->setObjectName("dockAreaMinimizeButton");
-	MinimizeButton->setAutoRaise(true);
-	MinimizeButton->setVisible(false);
-	internal::setButtonIcon(MinimizeButton, QStyle::SP_TitleBarMinButton, ads::DockAreaMinimizeIcon);
-	internal::setToolTip(MinimizeButton, QObject::tr("Minimize"));
-	MinimizeButton->setSizePolicy(ButtonSizePolicy);
-	Layout->addWidget(MinimizeButton, 0);
-	_this->connect(MinimizeButton, SIGNAL(clicked()), SLOT(minimizeAutoHideContainer()));
-
-	// Close button
-	CloseButton = new CTitleBarButton(testConfigFlag(CDockManager::DockAreaHasCloseButton),
-		true, TitleBarButtonClose);
-	CloseButton->setObjectName("dockAreaCloseButton");
-	CloseButton->setAutoRaise(true);
-	internal::setButtonIcon(CloseButton, QStyle::SP_TitleBarCloseButton, ads::DockAreaCloseIcon);
-    internal::setToolTip(CloseButton, _this->titleBarButtonToolTip(TitleBarButtonClose));
-	CloseButton->setSizePolicy(ButtonSizePolicy);
-	CloseButton->setIconSize(QSize(16, 16));
-	Layout->addWidget(CloseButton, 0);
-	_this->connect(CloseButton, SIGNAL(clicked()), SLOT(onCloseButtonClicked()));
+
+//============================================================================
+QMenu* DockAreaTitleBarPrivate::contextMenu()
+{
+	const bool isAutoHide = DockArea->isAutoHide();
+	const bool isTopLevelArea = DockArea->isTopLevelArea();
+	const bool AutoHideEnabled = testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled);
+	const auto Features = DockArea->features();
+	const bool IsFloatable = Features.testFlag(CDockWidget::DockWidgetFloatable);
+	const bool IsPinnable = Features.testFlag(CDockWidget::DockWidgetPinnable);
+	const bool IsClosable = Features.testFlag(CDockWidget::DockWidgetClosable);
+	const int Key = int(isAutoHide) | (int(isTopLevelArea) << 1) | (int(AutoHideEnabled) << 2)
+		| (int(IsFloatable) << 3) | (int(IsPinnable) << 4) | (int(IsClosable) << 5);
+	if (ContextMenu && Key == ContextMenuKey)
+	{
+		return ContextMenu;
+	}
+
+	if (!ContextMenu)
+	{
+		ContextMenu = new QMenu(_this);
+	}
+	ContextMenu->clear();
+	ContextMenuKey = Key;
+
+	QAction* Action;
+	QMenu& Menu = *ContextMenu;
+	if (!isTopLevelArea)
+	{
+		Action = Menu.addAction(isAutoHide ? CDockAreaTitleBar::tr("Detach") : CDockAreaTitleBar::tr("Detach Group"),
+			_this, SLOT(onUndockButtonClicked()));
+		Action->setEnabled(IsFloatable);
+		if (AutoHideEnabled)
+		{
+			Action = Menu.addAction(isAutoHide ? CDockAreaTitleBar::tr("Unpin (Dock)") : CDockAreaTitleBar::tr("Pin Group"), _this, SLOT(onAutoHideDockAreaActionClicked()));
+			Action->setEnabled(IsPinnable);
+
+			if (!isAutoHide)
+			{
+				auto menu = Menu.addMenu(CDockAreaTitleBar::tr("Pin Group To..."));
+				menu->setEnabled(IsPinnable);
+				createAutoHideToAction(CDockAreaTitleBar::tr("Top"), SideBarTop, menu);
+				createAutoHideToAction(CDockAreaTitleBar::tr("Left"), SideBarLeft, menu);
+				createAutoHideToAction(CDockAreaTitleBar::tr("Right"), SideBarRight, menu);
+				createAutoHideToAction(CDockAreaTitleBar::tr("Bottom"), SideBarBottom, menu);
+			}
+		}
+		Menu.addSeparator();
+	}
+
+	if (isAutoHide)
+	{
+		Action = Menu.addAction(CDockAreaTitleBar::tr("Minimize"), _this, SLOT(minimizeAutoHideContainer()));
+		Action = Menu.addAction(CDockAreaTitleBar::tr("Close"), _this, SLOT(onAutoHideCloseActionTriggered()));
+	}
+	else
+	{
+		Action = Menu.addAction(isAutoHide ? CDockAreaTitleBar::tr("Close") : CDockAreaTitleBar::tr("Close Group"), _this, SLOT(onCloseButtonClicked()));
+	}
+
+	Action->setEnabled(IsClosable);
+	if (!isAutoHide && !isTopLevelArea)
+	{
+		Action = Menu.addAction(CDockAreaTitleBar::tr("Close Other Groups"), DockArea, SLOT(closeOtherAreas()));
+	}
+	return ContextMenu;
 }
 
 
@@ -287,7 +472,7 @@ IFloatingWidget* DockAreaTitleBarPrivate::makeAreaFloating(const QPoint& Offset,
         {
             DockArea->autoHideDockContainer()->cleanupAndDelete();
         }
-		FloatingWidget = FloatingDockContainer = new CFloatingDockContainer(DockArea);
+		FloatingWidget = FloatingDockContainer = CFloatingDockContainer::create(DockArea);
 	}
 	else
 	{
@@ -340,7 +525,6 @@ CDockAreaTitleBar::CDockAreaTitleBar(CDockAreaWidget* parent) :
 	setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
 
 	d->createTabBar();
-	d->createButtons();
 	d->createAutoHideTitleLabel();
     
     setFocusPolicy(Qt::NoFocus);
@@ -377,7 +561,7 @@ CDockAreaTabBar* CDockAreaTitleBar::tabBar() const
 //============================================================================
 void CDockAreaTitleBar::markTabsMenuOutdated()
 {
-	if(DockAreaTitleBarPrivate::testConfigFlag(CDockManager::DockAreaDynamicTabsMenuButtonVisibility))
+	if(d->testConfigFlag(CDockManager::DockAreaDynamicTabsMenuButtonVisibility))
 	{
 		bool hasElidedTabTitle = false;
 		for (int i = 0; i < d->TabBar->count(); ++i)
@@ -394,7 +578,10 @@ void CDockAreaTitleBar::markTabsMenuOutdated()
 			}
 		}
 		bool visible = (hasElidedTabTitle && (d->TabBar->count() > 1));
-		QMetaObject::invokeMethod(d->TabsMenuButton, "setVisible", Qt::QueuedConnection, Q_ARG(bool, visible));
+		QTimer::singleShot(0, this, [this, visible]()
+		{
+			setButtonVisible(TitleBarButtonTabsMenu, visible);
+		});
 	}
 	d->MenuOutdated = true;
 }
@@ -429,7 +616,7 @@ void CDockAreaTitleBar::onTabsMenuAboutToShow()
 void CDockAreaTitleBar::onCloseButtonClicked()
 {
     ADS_PRINT("CDockAreaTitleBar::onCloseButtonClicked");
-	if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideCloseButtonCollapsesDock) &&
+	if (d->testAutoHideConfigFlag(CDockManager::AutoHideCloseButtonCollapsesDock) &&
 		d->DockArea->autoHideDockContainer())
 	{
 		d->DockArea->autoHideDockContainer()->collapseView(true);
@@ -508,7 +695,8 @@ void CDockAreaTitleBar::updateDockWidgetActionsButtons()
 		return;
 	}
 
-	int InsertIndex = indexOf(d->TabsMenuButton);
+	int InsertIndex = d->TabsMenuButton ? indexOf(d->TabsMenuButton)
+		: d->buttonInsertIndex(TitleBarButtonTabsMenu);
 	for (auto Action : Actions)
 	{
 		auto Button = new CTitleBarButton(true, false, TitleBarButtonTabsMenu, this);
@@ -533,7 +721,7 @@ void CDockAreaTitleBar::onCurrentTabChanged(int Index)
 	if (d->testConfigFlag(CDockManager::DockAreaCloseButtonClosesTab))
 	{
 		CDockWidget* DockWidget = d->TabBar->tab(Index)->dockWidget();
-		d->CloseButton->setEnabled(DockWidget->features().testFlag(CDockWidget::DockWidgetClosable));
+		setButtonEnabled(TitleBarButtonClose, DockWidget->features().testFlag(CDockWidget::DockWidgetClosable));
 	}
 
 	updateDockWidgetActionsButtons();
@@ -543,7 +731,7 @@ void CDockAreaTitleBar::onCurrentTabChanged(int Index)
 //============================================================================
 void CDockAreaTitleBar::onAutoHideButtonClicked()
 {
-	if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideButtonTogglesArea)
+	if (d->testAutoHideConfigFlag(CDockManager::AutoHideButtonTogglesArea)
 	 || qApp->keyboardModifiers().testFlag(Qt::ControlModifier))
 	{
 		d->DockArea->toggleAutoHide();
@@ -573,15 +761,46 @@ void CDockAreaTitleBar::onAutoHideToActionClicked()
 //============================================================================
 CTitleBarButton* CDockAreaTitleBar::button(TitleBarButton which) const
 {
-	switch (which)
+	auto Button = d->button(which);
+	return Button ? Button : d->createButton(which);
+}
+
+
+//============================================================================
+CTitleBarButton* CDockAreaTitleBar::existingButton(TitleBarButton which) const
+{
+	return d->button(which);
+}
+
+
+//============================================================================
+void CDockAreaTitleBar::setButtonVisible(TitleBarButton which, bool Visible)
+{
+	d->HiddenButtons = Visible ? (d->HiddenButtons & ~(1 << which))
+		: (d->HiddenButtons | (1 << which));
+	auto Button = d->button(which);
+	if (!Button)
 	{
-	case TitleBarButtonTabsMenu: return d->TabsMenuButton;
-	case TitleBarButtonUndock: return d->UndockButton;
-	case TitleBarButtonClose: return d->CloseButton;
-	case TitleBarButtonAutoHide: return d->AutoHideButton;
-	case TitleBarButtonMinimize: return d->MinimizeButton;
-	default:
-		return nullptr;
+		// A button that is not shown in the title bar would stay invisible,
+		// so there is no need to create it
+		if (!Visible || !d->showInTitleBar(which))
+		{
+			return;
+		}
+		Button = d->createButton(which);
+	}
+	Button->setVisible(Visible);
+}
+
+
+//============================================================================
+void CDockAreaTitleBar::setButtonEnabled(TitleBarButton which, bool Enabled)
+{
+	d->DisabledButtons = Enabled ? (d->DisabledButtons & ~(1 << which))
+		: (d->DisabledButtons | (1 << which));
+	if (auto Button = d->button(which))
+	{
+		Button->setEnabled(Enabled);
 	}
 }
 
@@ -628,7 +847,7 @@ void CDockAreaTitleBar::mousePressEvent(QMouseEvent* ev)
 		d->DragStartMousePos = ev->pos();
 		d->DragState = DraggingMousePressed;
 
-		if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+		if (d->testConfigFlag(CDockManager::FocusHighlighting))
 		{
 			d->dockManager()->dockFocusController()->setDockWidgetTabFocused(d->TabBar->currentTab());
 		}
@@ -761,50 +980,7 @@ void CDockAreaTitleBar::contextMenuEvent(QContextMenuEvent* ev)
 		return;
 	}
 
-	const bool isAutoHide = d->DockArea->isAutoHide();
-	const bool isTopLevelArea = d->DockArea->isTopLevelArea();
-	QAction* Action;
-	QMenu Menu(this);
-	if (!isTopLevelArea)
-	{
-		Action = Menu.addAction(isAutoHide ? tr("Detach") : tr("Detach Group"),
-			this, SLOT(onUndockButtonClicked()));
-		Action->setEnabled(d->DockArea->features().testFlag(CDockWidget::DockWidgetFloatable));
-		if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
-		{
-			Action = Menu.addAction(isAutoHide ? tr("Unpin (Dock)") : tr("Pin Group"), this, SLOT(onAutoHideDockAreaActionClicked()));
-			auto AreaIsPinnable = d->DockArea->features().testFlag(CDockWidget::DockWidgetPinnable);
-			Action->setEnabled(AreaIsPinnable);
-
-			if (!isAutoHide)
-			{
-				auto menu = Menu.addMenu(tr("Pin Group To..."));
-				menu->setEnabled(AreaIsPinnable);
-				d->createAutoHideToAction(tr("Top"), SideBarTop, menu);
-				d->createAutoHideToAction(tr("Left"), SideBarLeft, menu);
-				d->createAutoHideToAction(tr("Right"), SideBarRight, menu);
-				d->createAutoHideToAction(tr("Bottom"), SideBarBottom, menu);
-			}
-		}
-		Menu.addSeparator();
-	}
-
-	if (isAutoHide)
-	{
-		Action = Menu.addAction(tr("Minimize"), this, SLOT(minimizeAutoHideContainer()));
-		Action = Menu.addAction(tr("Close"), this, SLOT(onAutoHideCloseActionTriggered()));
-	}
-	else
-	{
-		Action = Menu.addAction(isAutoHide ? tr("Close") : tr("Close Group"), this, SLOT(onCloseButtonClicked()));
-	}
-
-	Action->setEnabled(d->DockArea->features().testFlag(CDockWidget::DockWidgetClosable));
-	if (!isAutoHide && !isTopLevelArea)
-	{
-		Action = Menu.addAction(tr("Close Other Groups"), d->DockArea, SLOT(closeOtherAreas()));
-	}
-	Menu.exec(ev->globalPos());
+	d->contextMenu()->exec(ev->globalPos());
 }
 
 
@@ -832,7 +1008,7 @@ QString CDockAreaTitleBar::titleBarButtonToolTip(TitleBarButton Button) const
 			 return tr("Unpin (Dock)");
 		 }
 
-		 if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideButtonTogglesArea))
+		 if (d->testAutoHideConfigFlag(CDockManager::AutoHideButtonTogglesArea))
 		 {
 			 return tr("Pin Group");
 		 }
@@ -845,11 +1021,11 @@ QString CDockAreaTitleBar::titleBarButtonToolTip(TitleBarButton Button) const
 	case TitleBarButtonClose:
 		if (d->DockArea->isAutoHide())
 		{
-			bool Minimize = CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideCloseButtonCollapsesDock);
+			bool Minimize = d->testAutoHideConfigFlag(CDockManager::AutoHideCloseButtonCollapsesDock);
 			return Minimize ? tr("Minimize") : tr("Close");
 		}
 
-		if (CDockManager::testConfigFlag(CDockManager::DockAreaCloseButtonClosesTab))
+		if (d->testConfigFlag(CDockManager::DockAreaCloseButtonClosesTab))
 		{
 			return tr("Close Active Tab");
 		}
@@ -871,7 +1047,7 @@ QString CDockAreaTitleBar::titleBarButtonToolTip(TitleBarButton Button) const
 void CDockAreaTitleBar::showAutoHideControls(bool Show)
 {
 	d->TabBar->setVisible(!Show); // Auto hide toolbar never has tabs
-	d->MinimizeButton->setVisible(Show);
+	setButtonVisible(TitleBarButtonMinimize, Show);
 	d->AutoHideTitleLabel->setVisible(Show);
 }
 
@@ -974,7 +1150,8 @@ bool CTitleBarButton::event(QEvent *ev)
 	{
 		switch (TitleBarButtonId)
         {
-		case TitleBarButtonClose: Show = CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideHasCloseButton); break;
+		case TitleBarButtonClose: Show = CDockManager::testAutoHideConfigFlag(
+			titleBar()->dockAreaWidget()->dockManager(), CDockManager::AutoHideHasCloseButton); break;
 		case TitleBarButtonUndock: Show = false; break;
 		default:
 			break;
@@ -1013,6 +1190,12 @@ CSpacerWidget::CSpacerWidget(QWidget* Parent /*= 0*/) : Super(Parent)
 }
 
 
+//============================================================================
+std::size_t internal::privateDataSize(const CDockAreaTitleBar*)
+{
+	return sizeof(DockAreaTitleBarPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
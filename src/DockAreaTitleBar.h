@@ -181,10 +181,30 @@ public:
 	CDockAreaTabBar* tabBar() const;
 
 	/**
-	 * Returns the button corresponding to the given title bar button identifier
+	 * Returns the button corresponding to the given title bar button identifier.
+	 * The title bar buttons are created on demand, so this function creates
+	 * the button if it does not exist yet.
 	 */
 	CTitleBarButton* button(TitleBarButton which) const;
 
+	/**
+	 * Returns the button corresponding to the given title bar button identifier
+	 * if it has already been created or a nullptr otherwise
+	 */
+	CTitleBarButton* existingButton(TitleBarButton which) const;
+
+	/**
+	 * Shows or hides the given title bar button. A button that does not exist
+	 * yet is only created if it becomes visible.
+	 */
+	void setButtonVisible(TitleBarButton which, bool Visible);
+
+	/**
+	 * Enables or disables the given title bar button. If the button does not
+	 * exist yet, the state is applied when the button is created.
+	 */
+	void setButtonEnabled(TitleBarButton which, bool Enabled);
+
 	/**
 	 * Returns the auto hide title label, used when the dock area is expanded and auto hidden
 	 */
@@ -42,6 +42,7 @@
 #include <QList>
 #include <QPointer>
 
+#include "DockMemoryUsage.h"
 #include "ElidingLabel.h"
 #include "DockContainerWidget.h"
 #include "DockWidget.h"
@@ -51,8 +52,10 @@
 #include "DockSplitter.h"
 #include "DockAreaTitleBar.h"
 #include "DockComponentsFactory.h"
+#include "DockFocusController.h"
 #include "DockWidgetTab.h"
 #include "DockingStateReader.h"
+#include "DockLayoutSnapshot.h"
 
 
 namespace ads
@@ -61,11 +64,11 @@ static const char* const INDEX_PROPERTY = "index";
 static const char* const ACTION_PROPERTY = "action";
 
 /**
- * Check, if auto hide is enabled
+ * Check, if auto hide is enabled for the given dock manager
  */
-static bool isAutoHideFeatureEnabled()
+static bool isAutoHideFeatureEnabled(const CDockManager* DockManager)
 {
-	return CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled);
+	return CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::AutoHideFeatureEnabled);
 }
 
 
@@ -372,20 +375,20 @@ void DockAreaWidgetPrivate::updateTitleBarButtonStates()
 
 	if (_this->isAutoHide())
 	{
-		if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideHasCloseButton))
+		if (CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::AutoHideHasCloseButton))
         {
-			TitleBar->button(TitleBarButtonClose)->setEnabled(
+			TitleBar->setButtonEnabled(TitleBarButtonClose,
 				_this->features().testFlag(CDockWidget::DockWidgetClosable));
         }
 	}
 	else
 	{
-		TitleBar->button(TitleBarButtonUndock)->setEnabled(
+		TitleBar->setButtonEnabled(TitleBarButtonUndock,
 			_this->features().testFlag(CDockWidget::DockWidgetFloatable));
-		TitleBar->button(TitleBarButtonClose)->setEnabled(
+		TitleBar->setButtonEnabled(TitleBarButtonClose,
 			_this->features().testFlag(CDockWidget::DockWidgetClosable));
 	}
-	TitleBar->button(TitleBarButtonAutoHide)->setEnabled(
+	TitleBar->setButtonEnabled(TitleBarButtonAutoHide,
 		_this->features().testFlag(CDockWidget::DockWidgetPinnable));
 	TitleBar->updateDockWidgetActionsButtons();
 	UpdateTitleBarButtons = false;
@@ -404,27 +407,27 @@ void DockAreaWidgetPrivate::updateTitleBarButtonVisibility(bool IsTopLevel)
 	bool IsAutoHide = _this->isAutoHide();
 	if (IsAutoHide)
 	{
-		bool ShowCloseButton = CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideHasCloseButton);
-		TitleBar->button(TitleBarButtonClose)->setVisible(ShowCloseButton);
-		TitleBar->button(TitleBarButtonAutoHide)->setVisible(true);
-		TitleBar->button(TitleBarButtonUndock)->setVisible(false);
-        TitleBar->button(TitleBarButtonTabsMenu)->setVisible(false);
+		bool ShowCloseButton = CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::AutoHideHasCloseButton);
+		TitleBar->setButtonVisible(TitleBarButtonClose, ShowCloseButton);
+		TitleBar->setButtonVisible(TitleBarButtonAutoHide, true);
+		TitleBar->setButtonVisible(TitleBarButtonUndock, false);
+        TitleBar->setButtonVisible(TitleBarButtonTabsMenu, false);
 	}
 	else if (IsTopLevel)
 	{
-		TitleBar->button(TitleBarButtonClose)->setVisible(!container->isFloating());
-		TitleBar->button(TitleBarButtonAutoHide)->setVisible(!container->isFloating());
+		TitleBar->setButtonVisible(TitleBarButtonClose, !container->isFloating());
+		TitleBar->setButtonVisible(TitleBarButtonAutoHide, !container->isFloating());
         // Undock and tabs should never show when auto hidden
-		TitleBar->button(TitleBarButtonUndock)->setVisible(!container->isFloating());
-        TitleBar->button(TitleBarButtonTabsMenu)->setVisible(true);
+		TitleBar->setButtonVisible(TitleBarButtonUndock, !container->isFloating());
+        TitleBar->setButtonVisible(TitleBarButtonTabsMenu, true);
 	}
 	else
 	{
-		TitleBar->button(TitleBarButtonClose)->setVisible(true);
-		bool ShowAutoHideButton = CDockManager::testAutoHideConfigFlag(CDockManager::DockAreaHasAutoHideButton);
-		TitleBar->button(TitleBarButtonAutoHide)->setVisible(ShowAutoHideButton);
-		TitleBar->button(TitleBarButtonUndock)->setVisible(true);
-        TitleBar->button(TitleBarButtonTabsMenu)->setVisible(true);
+		TitleBar->setButtonVisible(TitleBarButtonClose, true);
+		bool ShowAutoHideButton = CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::DockAreaHasAutoHideButton);
+		TitleBar->setButtonVisible(TitleBarButtonAutoHide, ShowAutoHideButton);
+		TitleBar->setButtonVisible(TitleBarButtonUndock, true);
+        TitleBar->setButtonVisible(TitleBarButtonTabsMenu, true);
 	}
 }
 
@@ -458,6 +461,68 @@ CDockAreaWidget::~CDockAreaWidget()
 }
 
 
+//============================================================================
+CDockAreaWidget* CDockAreaWidget::create(CDockManager* DockManager, CDockContainerWidget* parent)
+{
+	return DockManager ? DockManager->takeDockArea(parent)
+		: new CDockAreaWidget(DockManager, parent);
+}
+
+
+//============================================================================
+bool CDockAreaWidget::resetForReuse()
+{
+	if (parent() || isAutoHide() || !d->ContentsLayout->isEmpty())
+	{
+		return false;
+	}
+
+	d->AllowedAreas = DefaultAllowedAreas;
+	d->Flags = DefaultFlags;
+	d->MinSizeHint = QSize();
+	d->UpdateTitleBarButtons = false;
+	d->IsCovered = false;
+	setProperty("currentDockWidget", QVariant());
+	setProperty("focused", QVariant());
+	// The dock manager announces the reused dock area via dockAreaCreated()
+	// again and the dock components connect again when the dock area is
+	// used. Only their connections are removed - connections of the
+	// application and the destroyed() connection of the occlusion tracker
+	// are kept.
+	if (d->DockManager)
+	{
+		for (auto Container : d->DockManager->dockContainers())
+		{
+			disconnect(Container);
+		}
+		for (auto FloatingWidget : d->DockManager->floatingWidgets())
+		{
+			disconnect(FloatingWidget);
+		}
+		if (d->DockManager->dockFocusController())
+		{
+			disconnect(d->DockManager->dockFocusController());
+		}
+	}
+	d->TitleBar->setVisible(true);
+	return true;
+}
+
+
+//============================================================================
+void CDockAreaWidget::prepareReuse(CDockContainerWidget* parent)
+{
+	setParent(parent);
+	// A dock area that has been hidden explicitly before it was released
+	// would not be shown by the splitter it is inserted into
+	setAttribute(Qt::WA_WState_ExplicitShowHide, false);
+	if (d->DockManager)
+	{
+		Q_EMIT d->DockManager->dockAreaCreated(this);
+	}
+}
+
+
 //============================================================================
 CDockManager* CDockAreaWidget::dockManager() const
 {
@@ -604,7 +669,10 @@ void CDockAreaWidget::removeDockWidget(CDockWidget* DockWidget)
 	{
         ADS_PRINT("Dock Area empty");
 		DockContainer->removeDockArea(this);
-		this->deleteLater();
+		if (!d->DockManager || !d->DockManager->recycleDockArea(this))
+		{
+			this->deleteLater();
+		}
 		if(DockContainer->dockAreaCount() == 0)
 		{
 			if(CFloatingDockContainer*  FloatingDockContainer = DockContainer->floatingWidget())
@@ -648,7 +716,7 @@ void CDockAreaWidget::hideAreaWithNoVisibleContent()
 
 	//Hide empty floating widget
 	CDockContainerWidget* Container = this->dockContainer();
-	if (!Container->isFloating() && !CDockManager::testConfigFlag(CDockManager::HideSingleCentralWidgetTitleBar))
+	if (!Container->isFloating() && !CDockManager::testConfigFlag(d->DockManager, CDockManager::HideSingleCentralWidgetTitleBar))
 	{
 		return;
 	}
@@ -887,16 +955,16 @@ void CDockAreaWidget::updateTitleBarVisibility()
     }
 
     bool IsAutoHide = isAutoHide();
-    if (!CDockManager::testConfigFlag(CDockManager::AlwaysShowTabs))
+    if (!CDockManager::testConfigFlag(d->DockManager, CDockManager::AlwaysShowTabs))
     {
 		bool Hidden = Container->hasTopLevelDockWidget() && (Container->isFloating()
-			|| CDockManager::testConfigFlag(CDockManager::HideSingleCentralWidgetTitleBar));
+			|| CDockManager::testConfigFlag(d->DockManager, CDockManager::HideSingleCentralWidgetTitleBar));
 		Hidden |= (d->Flags.testFlag(HideSingleWidgetTitleBar) && openDockWidgetsCount() == 1);
 		Hidden &= !IsAutoHide; // Titlebar must always be visible when auto hidden so it can be dragged
 		d->TitleBar->setVisible(!Hidden);
     }
 
-	if (isAutoHideFeatureEnabled())
+	if (isAutoHideFeatureEnabled(d->DockManager))
 	{
 		d->TitleBar->showAutoHideControls(IsAutoHide);
 		updateTitleBarButtonVisibility(Container->topLevelDockArea() == this);
@@ -917,7 +985,11 @@ void CDockAreaWidget::markTitleBarMenuOutdated()
 //============================================================================
 void CDockAreaWidget::updateAutoHideButtonCheckState()
 {
-	auto autoHideButton = titleBarButton(TitleBarButtonAutoHide);
+	auto autoHideButton = d->TitleBar->existingButton(TitleBarButtonAutoHide);
+	if (!autoHideButton)
+	{
+		return;
+	}
 	autoHideButton->blockSignals(true);
 	autoHideButton->setChecked(isAutoHide());
 	autoHideButton->blockSignals(false);
@@ -934,38 +1006,41 @@ void CDockAreaWidget::updateTitleBarButtonVisibility(bool IsTopLevel) const
 //============================================================================
 void CDockAreaWidget::updateTitleBarButtonsToolTips()
 {
-	internal::setToolTip(titleBarButton(TitleBarButtonClose),
-		titleBar()->titleBarButtonToolTip(TitleBarButtonClose));
-	internal::setToolTip(titleBarButton(TitleBarButtonAutoHide),
-		titleBar()->titleBarButtonToolTip(TitleBarButtonAutoHide));
+	// Buttons that do not exist yet get their tool tip when they are created
+	if (auto Button = d->TitleBar->existingButton(TitleBarButtonClose))
+	{
+		internal::setToolTip(Button, titleBar()->titleBarButtonToolTip(TitleBarButtonClose));
+	}
+	if (auto Button = d->TitleBar->existingButton(TitleBarButtonAutoHide))
+	{
+		internal::setToolTip(Button, titleBar()->titleBarButtonToolTip(TitleBarButtonAutoHide));
+	}
 }
 
 
 //============================================================================
 void CDockAreaWidget::saveState(QXmlStreamWriter& s) const
 {
-	s.writeStartElement("Area");
-	s.writeAttribute("Tabs", QString::number(d->ContentsLayout->count()));
-	auto CurrentDockWidget = currentDockWidget();
-	QString Name = CurrentDockWidget ? CurrentDockWidget->objectName() : "";
-	s.writeAttribute("Current", Name);
+    ADS_PRINT("CDockAreaWidget::saveState TabCount: " << d->ContentsLayout->count()
+            << " Current: " << currentIndex());
+	layoutSnapshot().writeState(s);
+}
 
-	if (d->AllowedAreas != DefaultAllowedAreas)
-	{
-		s.writeAttribute("AllowedAreas", QString::number(d->AllowedAreas, 16));
-	}
 
-	if (d->Flags != DefaultFlags)
-	{
-		s.writeAttribute("Flags", QString::number(d->Flags, 16));
-	}
-    ADS_PRINT("CDockAreaWidget::saveState TabCount: " << d->ContentsLayout->count()
-            << " Current: " << Name);
+//============================================================================
+CDockLayoutSnapshot CDockAreaWidget::layoutSnapshot() const
+{
+	QVector<CDockLayoutSnapshot> DockWidgets;
+	DockWidgets.reserve(d->ContentsLayout->count());
 	for (int i = 0; i < d->ContentsLayout->count(); ++i)
 	{
-		dockWidget(i)->saveState(s);
+		auto DockWidget = dockWidget(i);
+		DockWidgets.append(CDockLayoutSnapshot::createDockWidget(
+			DockWidget->objectName(), DockWidget->isClosed()));
 	}
-	s.writeEndElement();
+
+	return CDockLayoutSnapshot::createDockArea(currentIndex(), int(d->AllowedAreas),
+		int(d->Flags), DockWidgets);
 }
 
 
@@ -983,6 +1058,7 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s, CDockAreaWidget*& Cre
 #endif
 
 	QString CurrentDockWidget = s.attributes().value("Current").toString();
+	int CurrentDockWidgetHandle = -1;
     ADS_PRINT("Restore NodeDockArea Tabs: " << Tabs << " Current: "
             << CurrentDockWidget);
 
@@ -990,7 +1066,7 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s, CDockAreaWidget*& Cre
 	CDockAreaWidget* DockArea = nullptr;
 	if (!Testing)
 	{
-		DockArea = new CDockAreaWidget(DockManager, Container);
+		DockArea = CDockAreaWidget::create(DockManager, Container);
 		const auto AllowedAreasAttribute = s.attributes().value("AllowedAreas");
 		if (!AllowedAreasAttribute.isEmpty())
 		{
@@ -1044,6 +1120,10 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s, CDockAreaWidget*& Cre
 		DockWidget->setClosedState(Closed);
 		DockWidget->setProperty(internal::ClosedProperty, Closed);
 		DockWidget->setProperty(internal::DirtyProperty, false);
+		if (ObjectName == CurrentDockWidget)
+		{
+			CurrentDockWidgetHandle = DockWidget->handle();
+		}
 	}
 
 	if (Testing)
@@ -1053,12 +1133,17 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s, CDockAreaWidget*& Cre
 
 	if (!DockArea->dockWidgetsCount())
 	{
-		delete DockArea;
+		if (!DockManager->recycleDockArea(DockArea))
+		{
+			delete DockArea;
+		}
 		DockArea = nullptr;
 	}
 	else
 	{
-		DockArea->setProperty("currentDockWidget", CurrentDockWidget);
+		// The current dock widget is stored via its handle to avoid a lookup
+		// via object name when the dock area indices are restored
+		DockArea->setProperty("currentDockWidget", CurrentDockWidgetHandle);
 	}
 
 	CreatedWidget = DockArea;
@@ -1356,7 +1441,7 @@ SideBarLocation CDockAreaWidget::calculateSideTabBarArea() const
 //============================================================================
 void CDockAreaWidget::setAutoHide(bool Enable, SideBarLocation Location, int TabIndex)
 {
-	if (!isAutoHideFeatureEnabled())
+	if (!isAutoHideFeatureEnabled(d->DockManager))
 	{
 		return;
 	}
@@ -1398,7 +1483,7 @@ void CDockAreaWidget::setAutoHide(bool Enable, SideBarLocation Location, int Tab
 //============================================================================
 void CDockAreaWidget::toggleAutoHide(SideBarLocation Location)
 {
-	if (!isAutoHideFeatureEnabled())
+	if (!isAutoHideFeatureEnabled(d->DockManager))
 	{
 		return;
 	}
@@ -1497,7 +1582,14 @@ bool CDockAreaWidget::isConvered() const
 
 bool CDockAreaWidget::setCovered(bool value)
 {
-    d->IsCovered = value;
+    if (d->IsCovered != value)
+    {
+        d->IsCovered = value;
+        for (auto DockWidget : dockWidgets())
+        {
+            DockWidget->updateEffectiveVisibility();
+        }
+    }
     
     if (auto container = dockContainer(); container)
     {
@@ -1535,6 +1627,13 @@ bool CDockAreaWidget::event(QEvent *e)
 }
 #endif
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CDockAreaWidget*)
+{
+	return sizeof(DockAreaWidgetPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
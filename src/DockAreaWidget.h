@@ -47,6 +47,7 @@ class CDockContainerWidget;
 class DockContainerWidgetPrivate;
 class CDockAreaTitleBar;
 class CDockingStateReader;
+class CDockLayoutSnapshot;
 class CDockSplitter;
 
 
@@ -174,6 +175,24 @@ protected:
 	 */
 	void updateTitleBarButtonVisibility(bool IsTopLevel) const;
 
+	/**
+	 * Resets the internal state of this empty dock area so that the dock
+	 * manager can keep it in its dock area pool. The connections of the
+	 * dock containers, floating widgets and the focus controller to the
+	 * signals of the dock area are removed. Connections of the application
+	 * are kept, although a reused dock area is announced via
+	 * CDockManager::dockAreaCreated() again.
+	 * Returns false, if the dock area can not be reused because it still
+	 * contains dock widgets, has a parent or is an auto hide dock area.
+	 */
+	bool resetForReuse();
+
+	/**
+	 * Called by the dock manager, if this dock area is taken out of the
+	 * dock area pool
+	 */
+	void prepareReuse(CDockContainerWidget* parent);
+
 protected Q_SLOTS:
 	void toggleView(bool Open);
 
@@ -200,6 +219,14 @@ public:
 	 */
 	virtual ~CDockAreaWidget();
 
+	/**
+	 * Creates a dock area for the given container.
+	 * If recycling is enabled (see
+	 * CDockComponentsFactory::setRecyclingPoolSize()), then a pooled dock
+	 * area of the dock manager is reused instead of creating a new one.
+	 */
+	static CDockAreaWidget* create(CDockManager* DockManager, CDockContainerWidget* parent);
+
 	/**
 	 * Returns the dock manager object this dock area belongs to
 	 */
@@ -308,6 +335,11 @@ public:
 	 */
 	void saveState(QXmlStreamWriter& Stream) const;
 
+	/**
+	 * Returns a snapshot node of this dock area and its dock widgets
+	 */
+	CDockLayoutSnapshot layoutSnapshot() const;
+
     /**
 	 * Restores a dock area.
 	 * \see restoreChildNodes() for details
@@ -0,0 +1,311 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockCommandQueue.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockCommandQueue class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockCommandQueue.h"
+
+#include <QAtomicPointer>
+#include <QMetaObject>
+#include <QPair>
+#include <QSet>
+#include <QVector>
+
+#include "DockManager.h"
+#include "DockWidget.h"
+
+namespace ads
+{
+/**
+ * One queued command. The commands are linked into a lock free stack.
+ */
+struct DockCommand
+{
+	enum eType
+	{
+		ToggleView,
+		SetAsCurrentTab,
+		SetWindowTitle,
+		SetIcon,
+		AddDockWidget,
+		OpenPerspective,
+		Function
+	};
+
+	eType Type;
+	QString Name;
+	QString Title;
+	QIcon Icon;
+	bool Open = true;
+	DockWidgetArea Area = CenterDockWidgetArea;
+	CDockCommandQueue::FactoryFunc Factory;
+	CDockCommandQueue::CommandFunc Func;
+	DockCommand* Next = nullptr;
+
+	DockCommand(eType type, const QString& name = QString()) :
+		Type(type), Name(name) {}
+
+	/**
+	 * Returns true, if only the last command with the same key needs to be
+	 * applied
+	 */
+	bool isCoalescable() const
+	{
+		return Type != AddDockWidget && Type != Function;
+	}
+};
+
+
+/**
+ * Private data class of CDockCommandQueue class (pimpl)
+ */
+struct DockCommandQueuePrivate
+{
+	CDockCommandQueue* _this;
+	CDockManager* DockManager;
+	QAtomicPointer<DockCommand> Head;
+
+	/**
+	 * Private data constructor
+	 */
+	DockCommandQueuePrivate(CDockCommandQueue* _public);
+
+	/**
+	 * Pushes the given command to the queue and schedules processing of
+	 * the queue, if the queue was empty
+	 */
+	void push(DockCommand* Command);
+
+	/**
+	 * Applies the given command
+	 */
+	void apply(const DockCommand* Command);
+
+	/**
+	 * Deletes the given list of commands
+	 */
+	static void deleteCommands(DockCommand* Command);
+};
+// struct DockCommandQueuePrivate
+
+
+//============================================================================
+DockCommandQueuePrivate::DockCommandQueuePrivate(CDockCommandQueue* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void DockCommandQueuePrivate::push(DockCommand* Command)
+{
+	DockCommand* Old = Head.loadAcquire();
+	do
+	{
+		Command->Next = Old;
+	}
+	while (!Head.testAndSetOrdered(Old, Command, Old));
+
+	// Only the first command of a batch schedules the processing - all
+	// other commands are applied by the same call
+	if (!Old)
+	{
+		QMetaObject::invokeMethod(_this, "processCommands", Qt::QueuedConnection);
+	}
+}
+
+
+//============================================================================
+void DockCommandQueuePrivate::apply(const DockCommand* Command)
+{
+	if (Command->Type == DockCommand::AddDockWidget)
+	{
+		auto DockWidget = Command->Factory ? Command->Factory() : nullptr;
+		if (DockWidget)
+		{
+			DockManager->addDockWidget(Command->Area, DockWidget);
+		}
+		return;
+	}
+	else if (Command->Type == DockCommand::OpenPerspective)
+	{
+		DockManager->openPerspective(Command->Name);
+		return;
+	}
+	else if (Command->Type == DockCommand::Function)
+	{
+		if (Command->Func)
+		{
+			Command->Func(DockManager);
+		}
+		return;
+	}
+
+	auto DockWidget = DockManager->findDockWidget(Command->Name);
+	if (!DockWidget)
+	{
+		return;
+	}
+
+	switch (Command->Type)
+	{
+	case DockCommand::ToggleView: DockWidget->toggleView(Command->Open); break;
+	case DockCommand::SetAsCurrentTab: DockWidget->setAsCurrentTab(); break;
+	case DockCommand::SetWindowTitle: DockWidget->setWindowTitle(Command->Title); break;
+	case DockCommand::SetIcon: DockWidget->setIcon(Command->Icon); break;
+	default: break;
+	}
+}
+
+
+//============================================================================
+void DockCommandQueuePrivate::deleteCommands(DockCommand* Command)
+{
+	while (Command)
+	{
+		auto Next = Command->Next;
+		delete Command;
+		Command = Next;
+	}
+}
+
+
+//============================================================================
+CDockCommandQueue::CDockCommandQueue(CDockManager* DockManager) :
+	Super(DockManager),
+	d(new DockCommandQueuePrivate(this))
+{
+	d->DockManager = DockManager;
+}
+
+
+//============================================================================
+CDockCommandQueue::~CDockCommandQueue()
+{
+	d->deleteCommands(d->Head.fetchAndStoreAcquire(nullptr));
+	delete d;
+}
+
+
+//============================================================================
+void CDockCommandQueue::toggleView(const QString& ObjectName, bool Open)
+{
+	auto Command = new DockCommand(DockCommand::ToggleView, ObjectName);
+	Command->Open = Open;
+	d->push(Command);
+}
+
+
+//============================================================================
+void CDockCommandQueue::setAsCurrentTab(const QString& ObjectName)
+{
+	d->push(new DockCommand(DockCommand::SetAsCurrentTab, ObjectName));
+}
+
+
+//============================================================================
+void CDockCommandQueue::setWindowTitle(const QString& ObjectName, const QString& Title)
+{
+	auto Command = new DockCommand(DockCommand::SetWindowTitle, ObjectName);
+	Command->Title = Title;
+	d->push(Command);
+}
+
+
+//============================================================================
+void CDockCommandQueue::setIcon(const QString& ObjectName, const QIcon& Icon)
+{
+	auto Command = new DockCommand(DockCommand::SetIcon, ObjectName);
+	Command->Icon = Icon;
+	d->push(Command);
+}
+
+
+//============================================================================
+void CDockCommandQueue::addDockWidget(DockWidgetArea Area, const FactoryFunc& Factory)
+{
+	auto Command = new DockCommand(DockCommand::AddDockWidget);
+	Command->Area = Area;
+	Command->Factory = Factory;
+	d->push(Command);
+}
+
+
+//============================================================================
+void CDockCommandQueue::openPerspective(const QString& PerspectiveName)
+{
+	d->push(new DockCommand(DockCommand::OpenPerspective, PerspectiveName));
+}
+
+
+//============================================================================
+void CDockCommandQueue::post(const CommandFunc& Function)
+{
+	auto Command = new DockCommand(DockCommand::Function);
+	Command->Func = Function;
+	d->push(Command);
+}
+
+
+//============================================================================
+int CDockCommandQueue::processCommands()
+{
+	// Take all queued commands at once. The list starts with the newest
+	// command, so the first command of each key is the one to keep.
+	DockCommand* List = d->Head.fetchAndStoreAcquire(nullptr);
+	QVector<DockCommand*> Commands;
+	QSet<QPair<int, QString>> Keys;
+	for (auto Command = List; Command; Command = Command->Next)
+	{
+		if (Command->isCoalescable())
+		{
+			// All perspective changes share the same key
+			auto Key = qMakePair(int(Command->Type),
+				(Command->Type == DockCommand::OpenPerspective) ? QString() : Command->Name);
+			if (Keys.contains(Key))
+			{
+				continue;
+			}
+			Keys.insert(Key);
+		}
+		Commands.append(Command);
+	}
+
+	// Apply the remaining commands in the order they have been posted
+	for (int i = Commands.count() - 1; i >= 0; --i)
+	{
+		d->apply(Commands[i]);
+	}
+
+	d->deleteCommands(List);
+	return Commands.count();
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockCommandQueue.cpp
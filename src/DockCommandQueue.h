@@ -0,0 +1,138 @@
+#ifndef DockCommandQueueH
+#define DockCommandQueueH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockCommandQueue.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockCommandQueue class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QIcon>
+#include <QString>
+
+#include <functional>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockCommandQueuePrivate;
+class CDockManager;
+class CDockWidget;
+
+/**
+ * Queue for docking commands posted from worker threads.
+ * All command functions of this class are thread safe and may be called
+ * from any thread. They append the command to a lock free queue and return
+ * immediately. Dock widgets are identified by their object name.
+ * The commands are applied in the GUI thread. The first command that is
+ * posted to an empty queue schedules one single queued call that drains
+ * the complete queue, so the event loop is not flooded with one queued
+ * call per command.
+ * Before the commands are applied, redundant commands are dropped: only
+ * the last title, icon, view toggle and current tab command of each dock
+ * widget and only the last perspective change are applied.
+ * Use CDockManager::commandQueue() to access the queue of a dock manager.
+ */
+class ADS_EXPORT CDockCommandQueue : public QObject
+{
+	Q_OBJECT
+private:
+	DockCommandQueuePrivate* d; ///< private data (pimpl)
+	friend struct DockCommandQueuePrivate;
+
+public:
+	using Super = QObject;
+	using FactoryFunc = std::function<CDockWidget*()>;
+	using CommandFunc = std::function<void(CDockManager*)>;
+
+	/**
+	 * Creates the command queue for the given dock manager
+	 */
+	CDockCommandQueue(CDockManager* DockManager);
+
+	/**
+	 * Virtual Destructor.
+	 * Commands that have not been applied yet are discarded.
+	 */
+	virtual ~CDockCommandQueue();
+
+	/**
+	 * Opens or closes the dock widget with the given object name
+	 * \see CDockWidget::toggleView()
+	 */
+	void toggleView(const QString& ObjectName, bool Open = true);
+
+	/**
+	 * Makes the dock widget with the given object name the current tab of
+	 * its dock area
+	 * \see CDockWidget::setAsCurrentTab()
+	 */
+	void setAsCurrentTab(const QString& ObjectName);
+
+	/**
+	 * Sets the window title of the dock widget with the given object name
+	 */
+	void setWindowTitle(const QString& ObjectName, const QString& Title);
+
+	/**
+	 * Sets the icon of the dock widget with the given object name
+	 * \see CDockWidget::setIcon()
+	 */
+	void setIcon(const QString& ObjectName, const QIcon& Icon);
+
+	/**
+	 * Calls the given factory in the GUI thread and adds the created dock
+	 * widget into the given area of the dock manager. The factory may
+	 * return a nullptr to add nothing.
+	 */
+	void addDockWidget(DockWidgetArea Area, const FactoryFunc& Factory);
+
+	/**
+	 * Opens the perspective with the given name
+	 * \see CDockManager::openPerspective()
+	 */
+	void openPerspective(const QString& PerspectiveName);
+
+	/**
+	 * Calls the given function with the dock manager in the GUI thread.
+	 * Use this for commands that are not covered by the other functions.
+	 * Function commands are never dropped.
+	 */
+	void post(const CommandFunc& Function);
+
+public Q_SLOTS:
+	/**
+	 * Applies all queued commands. This function is called automatically
+	 * in the GUI thread and should only be called from the GUI thread.
+	 * Returns the number of applied commands.
+	 */
+	int processCommands();
+}; // class CDockCommandQueue
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockCommandQueueH
@@ -22,6 +22,8 @@
 namespace ads
 {
 static std::unique_ptr<CDockComponentsFactory> DefaultFactory(new CDockComponentsFactory());
+static int FactoryRevision = 0;
+static int RecyclingPoolSize = 0;
 
 
 //============================================================================
@@ -62,6 +64,7 @@ const CDockComponentsFactory* CDockComponentsFactory::factory()
 void CDockComponentsFactory::setFactory(CDockComponentsFactory* Factory)
 {
 	DefaultFactory.reset(Factory);
+	++FactoryRevision;
 }
 
 
@@ -69,6 +72,28 @@ void CDockComponentsFactory::setFactory(CDockComponentsFactory* Factory)
 void CDockComponentsFactory::resetDefaultFactory()
 {
 	DefaultFactory.reset(new CDockComponentsFactory());
+	++FactoryRevision;
+}
+
+
+//============================================================================
+void CDockComponentsFactory::setRecyclingPoolSize(int Size)
+{
+	RecyclingPoolSize = qMax(0, Size);
+}
+
+
+//============================================================================
+int CDockComponentsFactory::recyclingPoolSize()
+{
+	return RecyclingPoolSize;
+}
+
+
+//============================================================================
+int internal::componentsFactoryRevision()
+{
+	return FactoryRevision;
 }
 } // namespace ads
 
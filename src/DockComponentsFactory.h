@@ -80,6 +80,27 @@ public:
 	 * Resets the current factory to the
 	 */
 	static void resetDefaultFactory();
+
+	/**
+	 * Sets the maximum number of released dock areas and auto hide tabs
+	 * that each dock manager keeps for reuse.
+	 * If the pool size is greater than 0, then empty dock areas (including
+	 * their title bar and tab bar) and the tabs of removed auto hide
+	 * widgets are reset and kept hidden instead of being deleted. New dock
+	 * areas and auto hide tabs are taken from the pool before the factory
+	 * functions are used. Pooled components created by a previous factory
+	 * are not reused. Recycled dock areas are announced via
+	 * CDockManager::dockAreaCreated() again, but connections of the
+	 * application to their signals are kept. Use Qt::UniqueConnection
+	 * for these connections.
+	 * A pool size of 0 (the default) disables recycling.
+	 */
+	static void setRecyclingPoolSize(int Size);
+
+	/**
+	 * Returns the configured recycling pool size
+	 */
+	static int recyclingPoolSize();
 };
 
 
@@ -91,6 +112,15 @@ inline const CDockComponentsFactory* componentsFactory()
 	return CDockComponentsFactory::factory();
 }
 
+namespace internal
+{
+/**
+ * Returns a number that changes each time the components factory is
+ * replaced
+ */
+int componentsFactoryRevision();
+} // namespace internal
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
@@ -32,6 +32,7 @@
 
 #include <QEvent>
 #include <QList>
+#include <QHash>
 #include <QGridLayout>
 #include <QPointer>
 #include <QVariant>
@@ -46,6 +47,7 @@
 
 #include "DockManager.h"
 #include "DockAreaWidget.h"
+#include "DockMemoryUsage.h"
 #include "DockWidget.h"
 #include "DockingStateReader.h"
 #include "FloatingDockContainer.h"
@@ -58,36 +60,11 @@
 #include "AutoHideDockContainer.h"
 #include "AutoHideSideBar.h"
 #include "AutoHideTab.h"
+#include "DockLayoutSnapshot.h"
+#include "DockLayoutSolver.h"
 
 #include <functional>
 
-#if QT_VERSION < 0x050900
-
-inline char toHexLower(uint value)
-{
-    return "0123456789abcdef"[value & 0xF];
-}
-
-QByteArray qByteArrayToHex(const QByteArray& src, char separator)
-{
-    if(src.size() == 0)
-        return QByteArray();
-
-    const int length = separator ? (src.size() * 3 - 1) : (src.size() * 2);
-    QByteArray hex(length, Qt::Uninitialized);
-    char *hexData = hex.data();
-    const uchar *data = reinterpret_cast<const uchar *>(src.data());
-    for (int i = 0, o = 0; i < src.size(); ++i) {
-        hexData[o++] = toHexLower(data[i] >> 4);
-        hexData[o++] = toHexLower(data[i] & 0xf);
-
-        if ((separator) && (o < length))
-            hexData[o++] = separator;
-    }
-    return hex;
-}
-#endif
-
 namespace ads
 {
 static unsigned int zOrderCounter = 0;
@@ -152,6 +129,8 @@ public:
 	QTimer DelayedAutoHideTimer;
 	CAutoHideTab* DelayedAutoHideTab;
 	bool DelayedAutoHideShow = false;
+	QHash<QSplitter*, QList<int>> RestoredSplitterSizes;
+	QRect RestoredRootGeometry;
 
 	/**
 	 * Private data constructor
@@ -234,14 +213,9 @@ public:
 	void appendDockAreas(const QList<CDockAreaWidget*> NewDockAreas);
 
 	/**
-	 * Save state of child nodes
+	 * Returns the snapshot node of the given splitter or dock area widget
 	 */
-	void saveChildNodesState(QXmlStreamWriter& Stream, QWidget* Widget);
-
-	/**
-	 * Save state of auto hide widgets
-	 */
-    void saveAutoHideWidgetsState(QXmlStreamWriter& Stream);
+	CDockLayoutSnapshot childNodesSnapshot(QWidget* Widget) const;
 
     /**
 	 * Restore state of child nodes.
@@ -274,6 +248,15 @@ public:
     bool restoreSideBar(CDockingStateReader& Stream, QWidget*& CreatedWidget,
         bool Testing);
 
+	/**
+	 * Adds the given splitter or dock area widget and all its children to
+	 * the given layout solver. The splitter of each added node is appended
+	 * to Splitters or a nullptr for dock area nodes.
+	 */
+	void addLayoutSolverNodes(CDockLayoutSolver& Solver, QWidget* Widget,
+		int Parent, int Size, Qt::Orientation ParentOrientation,
+		QVector<QSplitter*>& Splitters);
+
 	/**
 	 * Helper function for recursive dumping of layout
 	 */
@@ -341,8 +324,9 @@ public:
 	CDockSplitter* newSplitter(Qt::Orientation orientation, QWidget* parent = nullptr)
 	{
 		CDockSplitter* s = new CDockSplitter(orientation, parent);
-		s->setOpaqueResize(CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize));
+		s->setOpaqueResize(CDockManager::testConfigFlag(DockManager, CDockManager::OpaqueSplitterResize));
 		s->setChildrenCollapsible(false);
+		QObject::connect(s, &QSplitter::splitterMoved, DockManager, &CDockManager::markLayoutDirty);
 		return s;
 	}
 
@@ -695,7 +679,10 @@ void DockContainerWidgetPrivate::moveIntoCenterOfSection(QWidget* Widget, CDockA
 		}
 		TargetArea->setCurrentIndex(TabIndex + NewCurrentIndex);
 		DroppedArea->dockContainer()->removeDockArea(DroppedArea);
-		DroppedArea->deleteLater();
+		if (!DockManager || !DockManager->recycleDockArea(DroppedArea))
+		{
+			DroppedArea->deleteLater();
+		}
 	}
 
 	TargetArea->updateTitleBarVisibility();
@@ -721,7 +708,7 @@ void DockContainerWidgetPrivate::moveToNewSection(QWidget* Widget, CDockAreaWidg
 	CDockAreaWidget* NewDockArea;
 	if (DroppedDockWidget)
 	{
-		NewDockArea = new CDockAreaWidget(DockManager, _this);
+		NewDockArea = CDockAreaWidget::create(DockManager, _this);
 		CDockAreaWidget* OldDockArea = DroppedDockWidget->dockAreaWidget();
 		if (OldDockArea)
 		{
@@ -857,7 +844,7 @@ void DockContainerWidgetPrivate::moveToContainer(QWidget* Widget, DockWidgetArea
 
 	if (DroppedDockWidget)
 	{
-		NewDockArea = new CDockAreaWidget(DockManager, _this);
+		NewDockArea = CDockAreaWidget::create(DockManager, _this);
 		CDockAreaWidget* OldDockArea = DroppedDockWidget->dockAreaWidget();
 		if (OldDockArea)
 		{
@@ -904,8 +891,8 @@ void DockContainerWidgetPrivate::addDockAreasToList(const QList<CDockAreaWidget*
 	// likely hidden. We need to ensure, that it is visible
 	for (auto DockArea : NewDockAreas)
 	{
-		DockArea->titleBarButton(TitleBarButtonClose)->setVisible(true);
-		DockArea->titleBarButton(TitleBarButtonAutoHide)->setVisible(true);
+		DockArea->titleBar()->setButtonVisible(TitleBarButtonClose, true);
+		DockArea->titleBar()->setButtonVisible(TitleBarButtonAutoHide, true);
 	}
 
 	// We need to ensure, that the dock area title bar is visible. The title bar
@@ -942,52 +929,27 @@ void DockContainerWidgetPrivate::appendDockAreas(const QList<CDockAreaWidget*> N
 
 
 //============================================================================
-void DockContainerWidgetPrivate::saveChildNodesState(QXmlStreamWriter& s, QWidget* Widget)
+CDockLayoutSnapshot DockContainerWidgetPrivate::childNodesSnapshot(QWidget* Widget) const
 {
 	QSplitter* Splitter = qobject_cast<QSplitter*>(Widget);
 	if (Splitter)
 	{
-		s.writeStartElement("Splitter");
-		s.writeAttribute("Orientation", (Splitter->orientation() == Qt::Horizontal) ? "|" : "-");
-		s.writeAttribute("Count", QString::number(Splitter->count()));
-        ADS_PRINT("NodeSplitter orient: " << Splitter->orientation()
-            << " WidgetCont: " << Splitter->count());
-			for (int i = 0; i < Splitter->count(); ++i)
-			{
-				saveChildNodesState(s, Splitter->widget(i));
-			}
-
-			s.writeStartElement("Sizes");
-			for (auto Size : Splitter->sizes())
+		QVector<CDockLayoutSnapshot> Children;
+		Children.reserve(Splitter->count());
+		for (int i = 0; i < Splitter->count(); ++i)
+		{
+			auto Child = childNodesSnapshot(Splitter->widget(i));
+			if (Child.isValid())
 			{
-				s.writeCharacters(QString::number(Size) + " ");
+				Children.append(Child);
 			}
-			s.writeEndElement();
-		s.writeEndElement();
-	}
-	else
-	{
-		CDockAreaWidget* DockArea = qobject_cast<CDockAreaWidget*>(Widget);
-		if (DockArea)
-		{
-			DockArea->saveState(s);
 		}
+		return CDockLayoutSnapshot::createSplitter(Splitter->orientation(),
+			Splitter->sizes(), Children);
 	}
-}
 
-
-//============================================================================
-void DockContainerWidgetPrivate::saveAutoHideWidgetsState(QXmlStreamWriter& s)
-{
-	for (const auto sideTabBar : SideTabBarWidgets.values())
-    {
-		if (!sideTabBar->count())
-		{
-			continue;
-		}
-
-		sideTabBar->saveState(s);
-    }
+	CDockAreaWidget* DockArea = qobject_cast<CDockAreaWidget*>(Widget);
+	return DockArea ? DockArea->layoutSnapshot() : CDockLayoutSnapshot();
 }
 
 
@@ -1093,7 +1055,9 @@ bool DockContainerWidgetPrivate::restoreSplitter(CDockingStateReader& s,
 		}
 		else
 		{
-			Splitter->setSizes(Sizes);
+			// The sizes are applied by applyRestoredSplitterSizes() when the
+			// complete layout has been restored
+			RestoredSplitterSizes.insert(Splitter, Sizes);
 			Splitter->setVisible(Visible);
 		}
 		CreatedWidget = Splitter;
@@ -1122,6 +1086,50 @@ bool DockContainerWidgetPrivate::restoreDockArea(CDockingStateReader& s,
 }
 
 
+//============================================================================
+void DockContainerWidgetPrivate::addLayoutSolverNodes(CDockLayoutSolver& Solver,
+	QWidget* Widget, int Parent, int Size, Qt::Orientation ParentOrientation,
+	QVector<QSplitter*>& Splitters)
+{
+	QSizePolicy Policy = Widget->sizePolicy();
+	int Stretch = (ParentOrientation == Qt::Horizontal) ? Policy.horizontalStretch()
+		: Policy.verticalStretch();
+
+	QSplitter* Splitter = qobject_cast<QSplitter*>(Widget);
+	if (Splitter)
+	{
+		int Index = Solver.addSplitter(Parent, Splitter->orientation(), Size);
+		Solver.setStretchFactor(Index, Stretch);
+		Splitters.append(Splitter);
+		const auto Sizes = RestoredSplitterSizes.value(Splitter, Splitter->sizes());
+		for (int i = 0; i < Splitter->count(); ++i)
+		{
+			addLayoutSolverNodes(Solver, Splitter->widget(i), Index,
+				(i < Sizes.count()) ? Sizes[i] : 0, Splitter->orientation(), Splitters);
+		}
+		return;
+	}
+
+	// Like qSmartMinSize() for widgets with a shrinkable size policy
+	QSize MinimumSize = Widget->minimumSize();
+	QSize MinimumSizeHint = Widget->minimumSizeHint();
+	if (MinimumSize.width() <= 0)
+	{
+		MinimumSize.setWidth(qMax(0, MinimumSizeHint.width()));
+	}
+	if (MinimumSize.height() <= 0)
+	{
+		MinimumSize.setHeight(qMax(0, MinimumSizeHint.height()));
+	}
+
+	int Index = Solver.addDockArea(Parent, Size, MinimumSize);
+	Solver.setMaximumSize(Index, Widget->maximumSize());
+	Solver.setStretchFactor(Index, Stretch);
+	Solver.setVisible(Index, !Widget->isHidden());
+	Splitters.append(nullptr);
+}
+
+
 //============================================================================
 bool DockContainerWidgetPrivate::restoreSideBar(CDockingStateReader& s,
 	QWidget*& CreatedWidget, bool Testing)
@@ -1129,7 +1137,7 @@ bool DockContainerWidgetPrivate::restoreSideBar(CDockingStateReader& s,
 	Q_UNUSED(CreatedWidget)
 	// Simply ignore side bar auto hide widgets from saved state if
 	// auto hide support is disabled
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
+	if (!CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::AutoHideFeatureEnabled))
 	{
 		return true;
 	}
@@ -1234,7 +1242,7 @@ bool DockContainerWidgetPrivate::restoreChildNodes(CDockingStateReader& s,
 CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToContainer(DockWidgetArea area,
 	CDockWidget* Dockwidget)
 {
-	CDockAreaWidget* NewDockArea = new CDockAreaWidget(DockManager, _this);
+	CDockAreaWidget* NewDockArea = CDockAreaWidget::create(DockManager, _this);
 	NewDockArea->addDockWidget(Dockwidget);
 	addDockArea(NewDockArea, area);
 	NewDockArea->updateTitleBarVisibility();
@@ -1357,7 +1365,7 @@ CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToDockArea(DockWidgetA
 		return TargetDockArea;
 	}
 
-	CDockAreaWidget* NewDockArea = new CDockAreaWidget(DockManager, _this);
+	CDockAreaWidget* NewDockArea = CDockAreaWidget::create(DockManager, _this);
 	NewDockArea->addDockWidget(Dockwidget);
 	auto InsertParam = internal::dockAreaInsertParameters(area);
 
@@ -1369,7 +1377,7 @@ CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToDockArea(DockWidgetA
 		TargetAreaSplitter->insertWidget(index + InsertParam.insertOffset(), NewDockArea);
         updateSplitterHandles(TargetAreaSplitter);
         // do nothing, if flag is not enabled
-		if (CDockManager::testConfigFlag(CDockManager::EqualSplitOnInsertion))
+		if (CDockManager::testConfigFlag(DockManager, CDockManager::EqualSplitOnInsertion))
 		{
 			adjustSplitterSizesOnInsertion(TargetAreaSplitter);
 		}
@@ -1385,7 +1393,7 @@ CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToDockArea(DockWidgetA
         updateSplitterHandles(NewSplitter);
         TargetAreaSplitter->insertWidget(index, NewSplitter);
         updateSplitterHandles(TargetAreaSplitter);
-        if (CDockManager::testConfigFlag(CDockManager::EqualSplitOnInsertion))
+        if (CDockManager::testConfigFlag(DockManager, CDockManager::EqualSplitOnInsertion))
         {
 			TargetAreaSplitter->setSizes(TargetAreaSizes);
 			adjustSplitterSizesOnInsertion(NewSplitter);
@@ -1479,7 +1487,7 @@ CDockAreaWidget* CDockContainerWidget::addDockWidget(DockWidgetArea area, CDockW
 CAutoHideDockContainer* CDockContainerWidget::createAndSetupAutoHideContainer(
 	SideBarLocation area, CDockWidget* DockWidget, int TabIndex)
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
+	if (!CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHideFeatureEnabled))
 	{
 		Q_ASSERT_X(false, "CDockContainerWidget::createAndInitializeDockWidgetOverlayContainer",
 			"Requested area does not exist in config");
@@ -1651,6 +1659,22 @@ QList<QPointer<CDockAreaWidget>> CDockContainerWidget::removeAllDockAreas()
 }
 
 
+//============================================================================
+void CDockContainerWidget::resetRootSplitter()
+{
+	d->VisibleDockAreaCount = -1;
+	d->DockAreas.clear();
+	std::fill(std::begin(d->LastAddedAreaCache),std::end(d->LastAddedAreaCache), nullptr);
+	auto NewRootSplitter = d->newSplitter(Qt::Horizontal);
+	QLayoutItem* li = d->Layout->replaceWidget(d->RootSplitter, NewRootSplitter);
+	auto OldRoot = d->RootSplitter;
+	d->RootSplitter = NewRootSplitter;
+	OldRoot->hide();
+	OldRoot->deleteLater();
+	delete li;
+}
+
+
 //============================================================================
 CDockAreaWidget* CDockContainerWidget::dockAreaAt(const QPoint& GlobalPos) const
 {
@@ -1864,21 +1888,26 @@ void CDockContainerWidget::saveState(QXmlStreamWriter& s) const
     ADS_PRINT("CDockContainerWidget::saveState isFloating "
         << isFloating());
 
-	s.writeStartElement("Container");
-	s.writeAttribute("Floating", QString::number(isFloating() ? 1 : 0));
-	if (isFloating())
+	layoutSnapshot().writeState(s);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockContainerWidget::layoutSnapshot() const
+{
+	QVector<CDockLayoutSnapshot> Children;
+	Children.reserve(d->SideTabBarWidgets.count() + 1);
+	Children.append(d->childNodesSnapshot(d->RootSplitter));
+	for (const auto SideTabBar : d->SideTabBarWidgets)
 	{
-		CFloatingDockContainer* FloatingWidget = floatingWidget();
-		QByteArray Geometry = FloatingWidget->saveGeometry();
-#if QT_VERSION < 0x050900
-        s.writeTextElement("Geometry", qByteArrayToHex(Geometry, ' '));
-#else
-		s.writeTextElement("Geometry", Geometry.toHex(' '));
-#endif
+		if (SideTabBar->count())
+		{
+			Children.append(SideTabBar->layoutSnapshot());
+		}
 	}
-	d->saveChildNodesState(s, d->RootSplitter);
-	d->saveAutoHideWidgetsState(s);
-	s.writeEndElement();
+
+	return CDockLayoutSnapshot::createContainer(isFloating(),
+		isFloating() ? floatingWidget()->savedGeometry() : QByteArray(), Children);
 }
 
 
@@ -1893,6 +1922,7 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
 	{
 		d->VisibleDockAreaCount = -1;// invalidate the dock area count
 		d->DockAreas.clear();
+		d->RestoredSplitterSizes.clear();
 		std::fill(std::begin(d->LastAddedAreaCache),std::end(d->LastAddedAreaCache), nullptr);
 	}
 
@@ -1916,7 +1946,10 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
 			CFloatingDockContainer* FloatingWidget = floatingWidget();
 			if (FloatingWidget)
 			{
-				FloatingWidget->restoreGeometry(Geometry);
+				// Applying the geometry is deferred until the floating widget
+				// is shown. Floating widgets restored as hidden then do not
+				// need a native window.
+				FloatingWidget->restoreGeometryDeferred(Geometry);
 			}
 		}
 	}
@@ -1938,6 +1971,12 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
 		NewRootSplitter = d->newSplitter(Qt::Horizontal);
 	}
 
+	// The new root splitter replaces the old one in the layout, so the
+	// geometry of the old one is the final geometry of the new one. If the
+	// container has not been laid out yet or if it is floating and its
+	// geometry is restored later, the final geometry is not known here.
+	d->RestoredRootGeometry = (!isFloating() && d->RootSplitter->testAttribute(Qt::WA_Resized))
+		? d->RootSplitter->geometry() : QRect();
 	QLayoutItem* li = d->Layout->replaceWidget(d->RootSplitter, NewRootSplitter);
 	auto OldRoot = d->RootSplitter;
 	d->RootSplitter = qobject_cast<CDockSplitter*>(NewRootSplitter);
@@ -1948,6 +1987,72 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
 }
 
 
+//============================================================================
+void CDockContainerWidget::applyRestoredSplitterSizes()
+{
+	if (d->RestoredSplitterSizes.isEmpty())
+	{
+		return;
+	}
+
+	CDockLayoutSolver Solver;
+	QVector<QSplitter*> Splitters;
+	Solver.setHandleWidth(d->RootSplitter->handleWidth());
+	d->addLayoutSolverNodes(Solver, d->RootSplitter, -1, 0, Qt::Horizontal, Splitters);
+	const QRect& Rect = d->RestoredRootGeometry;
+	const bool Solve = Rect.isValid() && !Rect.isEmpty();
+	if (Solve)
+	{
+		Solver.solve(Rect);
+	}
+
+	// Apply the sizes top down - the nodes of parent splitters precede the
+	// nodes of their children. Each splitter gets its final geometry from
+	// its parent before its own sizes are set, so each widget is resized
+	// only once.
+	const bool UpdatesEnabled = updatesEnabled();
+	setUpdatesEnabled(false);
+	if (Solve)
+	{
+		d->RootSplitter->setGeometry(Rect);
+	}
+	for (int i = 0; i < Splitters.count(); ++i)
+	{
+		auto Splitter = Splitters[i];
+		if (!Splitter)
+		{
+			continue;
+		}
+
+		auto Sizes = d->RestoredSplitterSizes.value(Splitter, Splitter->sizes());
+		if (Solve && Solver.isVisible(i))
+		{
+			// Hidden children keep their restored sizes for the time they
+			// are shown again
+			const auto SolvedSizes = Solver.sizes(i);
+			const auto Children = Solver.children(i);
+			for (int j = 0; j < SolvedSizes.count() && j < Sizes.count(); ++j)
+			{
+				if (Solver.isVisible(Children[j]))
+				{
+					Sizes[j] = SolvedSizes[j];
+				}
+			}
+		}
+		Splitter->setSizes(Sizes);
+	}
+	setUpdatesEnabled(UpdatesEnabled);
+	d->RestoredSplitterSizes.clear();
+}
+
+
+//============================================================================
+void CDockContainerWidget::discardRestoredSplitterSizes()
+{
+	d->RestoredSplitterSizes.clear();
+}
+
+
 //============================================================================
 CDockSplitter* CDockContainerWidget::rootSplitter() const
 {
@@ -1970,7 +2075,8 @@ void CDockContainerWidget::createRootSplitter()
 //============================================================================
 void CDockContainerWidget::createSideTabBarWidgets()
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
+	if (!CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHideFeatureEnabled)
+	 || d->SideTabBarWidgets.contains(SideBarLeft))
 	{
 		return;
 	}
@@ -2206,7 +2312,7 @@ CDockManager* CDockContainerWidget::dockManager() const
 //===========================================================================
 void CDockContainerWidget::handleAutoHideWidgetEvent(QEvent* e, QWidget* w)
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideShowOnMouseOver))
+	if (!CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHideShowOnMouseOver))
 	{
 		return;
 	}
@@ -2224,6 +2330,14 @@ void CDockContainerWidget::handleAutoHideWidgetEvent(QEvent* e, QWidget* w)
 		case QEvent::Enter:
 			 if (!AutoHideTab->dockWidget()->isVisible())
 			 {
+				 // Use the show delay to lay out the content, if this has not
+				 // been done in idle time already
+				 auto AutoHideContainer = AutoHideTab->dockWidget()->autoHideDockContainer();
+				 if (AutoHideContainer
+				  && CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHidePrewarmContent))
+				 {
+					 AutoHideContainer->prewarm();
+				 }
 				 d->DelayedAutoHideTab = AutoHideTab;
 				 d->DelayedAutoHideShow = true;
 				 d->DelayedAutoHideTimer.start();
@@ -2283,6 +2397,14 @@ void CDockContainerWidget::handleAutoHideWidgetEvent(QEvent* e, QWidget* w)
 		return;
 	}
 }
+
+
+//============================================================================
+std::size_t internal::privateDataSize(const CDockContainerWidget*)
+{
+	return sizeof(DockContainerWidgetPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
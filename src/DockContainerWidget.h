@@ -54,6 +54,7 @@ class CDockingStateReader;
 class CAutoHideSideBar;
 class CAutoHideTab;
 class CDockSplitter;
+class CDockLayoutSnapshot;
 struct AutoHideTabPrivate;
 struct AutoHideDockContainerPrivate;
 
@@ -143,11 +144,24 @@ protected:
 	 */
 	QList<QPointer<CDockAreaWidget>> removeAllDockAreas();
 
+	/**
+	 * Removes all dock areas from the internal list of dock areas and
+	 * replaces the root splitter with a new, empty root splitter.
+	 * The old root splitter and all its remaining content are deleted later.
+	 * This is used to reset floating widgets before they are reused.
+	 */
+	void resetRootSplitter();
+
 	/**
 	 * Saves the state into the given stream
 	 */
 	void saveState(QXmlStreamWriter& Stream) const;
 
+	/**
+	 * Returns a snapshot node of this container and its complete content
+	 */
+	CDockLayoutSnapshot layoutSnapshot() const;
+
 	/**
 	 * Restores the state from given stream.
 	 * If Testing is true, the function only parses the data from the given
@@ -156,6 +170,22 @@ protected:
 	 */
 	bool restoreState(CDockingStateReader& Stream, bool Testing);
 
+	/**
+	 * Applies the sizes of all splitters restored by restoreState().
+	 * The final geometry of the complete splitter tree is computed first
+	 * and then applied top down in one single pass with disabled updates.
+	 * Call this function after the visibility of the restored dock areas
+	 * has been restored.
+	 */
+	void applyRestoredSplitterSizes();
+
+	/**
+	 * Drops the splitter sizes recorded by restoreState() without applying
+	 * them. Call this function if restoring the state failed, because the
+	 * recorded splitters may already be deleted.
+	 */
+	void discardRestoredSplitterSizes();
+
 	/**
 	 * This function returns the last added dock area widget for the given
 	 * area identifier or 0 if no dock area widget has been added for the given
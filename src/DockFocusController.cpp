@@ -12,6 +12,7 @@
 #include "DockFocusController.h"
 
 #include <QPointer>
+#include <QHash>
 #include <QApplication>
 #include <QAbstractButton>
 #include <QWindow>
@@ -30,7 +31,16 @@
 
 namespace ads
 {
-static const char* const FocusedDockWidgetProperty = "FocusedDockWidget";
+static const int MaxCachedContentRoots = 1024;
+
+/**
+ * The last focused dock widget of a window or floating widget
+ */
+struct FocusRecord
+{
+	QPointer<QObject> Object;
+	QPointer<CDockWidget> DockWidget;
+};
 
 /**
  * Private data class of CDockFocusController class (pimpl)
@@ -38,6 +48,9 @@ static const char* const FocusedDockWidgetProperty = "FocusedDockWidget";
 struct DockFocusControllerPrivate
 {
 	CDockFocusController *_this;
+	QHash<QWidget*, QPointer<CDockWidget>> ContentRoots;
+	QHash<QObject*, FocusRecord> FocusRecords;
+	bool FocusStyleValid = false;
 	QPointer<CDockWidget> FocusedDockWidget = nullptr;
 	QPointer<CDockAreaWidget> FocusedArea = nullptr;
 	QPointer<CDockWidget> OldFocusedDockWidget = nullptr;
@@ -58,6 +71,31 @@ struct DockFocusControllerPrivate
 	 * the dock area that it belongs to
 	 */
 	void updateDockWidgetFocus(CDockWidget* DockWidget);
+
+	/**
+	 * Returns the dock widget that contains the given focus widget.
+	 * The content widgets of the dock widgets are cached as content roots,
+	 * so the parent chain of a focus widget in the content of a dock
+	 * widget is only walked up to the content root.
+	 */
+	CDockWidget* dockWidgetOf(QWidget* Widget);
+
+	/**
+	 * Adds the content widget of the given dock widget to the content roots
+	 */
+	void addContentRoot(CDockWidget* DockWidget);
+
+	/**
+	 * Stores the given dock widget as the last focused dock widget of the
+	 * given window or floating widget
+	 */
+	void setFocusRecord(QObject* Object, CDockWidget* DockWidget);
+
+	/**
+	 * Returns the last focused dock widget of the given window or floating
+	 * widget
+	 */
+	CDockWidget* focusRecord(QObject* Object) const;
 }; // struct DockFocusControllerPrivate
 
 
@@ -109,6 +147,101 @@ DockFocusControllerPrivate::DockFocusControllerPrivate(
 }
 
 
+//============================================================================
+CDockWidget* DockFocusControllerPrivate::dockWidgetOf(QWidget* Widget)
+{
+	for (auto w = Widget; w; w = w->parentWidget())
+	{
+		// A root is only valid as long as it is still the content of its
+		// dock widget - this also detects reused addresses of deleted roots
+		auto it = ContentRoots.constFind(w);
+		if (it != ContentRoots.constEnd() && it.value() && it.value()->widget() == w)
+		{
+			return it.value();
+		}
+
+		// Focus widgets outside of the content, like the tab or the title
+		// bar, and nested dock widgets are resolved via their dock widget
+		auto DockWidget = qobject_cast<CDockWidget*>(w);
+		if (DockWidget)
+		{
+			addContentRoot(DockWidget);
+			return DockWidget;
+		}
+	}
+	return nullptr;
+}
+
+
+//============================================================================
+void DockFocusControllerPrivate::addContentRoot(CDockWidget* DockWidget)
+{
+	auto Root = DockWidget->widget();
+	if (!Root)
+	{
+		return;
+	}
+
+	if (ContentRoots.count() >= MaxCachedContentRoots)
+	{
+		for (auto it = ContentRoots.begin(); it != ContentRoots.end();)
+		{
+			if (!it.value() || it.value()->widget() != it.key())
+			{
+				it = ContentRoots.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		if (ContentRoots.count() >= MaxCachedContentRoots)
+		{
+			ContentRoots.clear();
+		}
+	}
+	ContentRoots.insert(Root, DockWidget);
+}
+
+
+//============================================================================
+void DockFocusControllerPrivate::setFocusRecord(QObject* Object, CDockWidget* DockWidget)
+{
+	auto it = FocusRecords.find(Object);
+	if (it != FocusRecords.end() && it->Object == Object)
+	{
+		it->DockWidget = DockWidget;
+		return;
+	}
+
+	// Remove the records of deleted windows before a new record is added
+	for (auto Record = FocusRecords.begin(); Record != FocusRecords.end();)
+	{
+		if (Record->Object)
+		{
+			++Record;
+		}
+		else
+		{
+			Record = FocusRecords.erase(Record);
+		}
+	}
+	FocusRecords.insert(Object, FocusRecord{Object, DockWidget});
+}
+
+
+//============================================================================
+CDockWidget* DockFocusControllerPrivate::focusRecord(QObject* Object) const
+{
+	auto it = FocusRecords.constFind(Object);
+	if (it == FocusRecords.constEnd() || it->Object != Object)
+	{
+		return nullptr;
+	}
+	return it->DockWidget;
+}
+
+
 //============================================================================
 void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 {
@@ -127,7 +260,7 @@ void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 
 	if (Window)
 	{
-        Window->setProperty(FocusedDockWidgetProperty, QVariant::fromValue(QPointer<CDockWidget>(DockWidget)));
+		setFocusRecord(Window, DockWidget);
 	}
 	CDockAreaWidget* NewFocusedDockArea = nullptr;
 	if (FocusedDockWidget)
@@ -138,6 +271,7 @@ void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 	CDockWidget* old = FocusedDockWidget;
 	FocusedDockWidget = DockWidget;
 	updateDockWidgetFocusStyle(FocusedDockWidget, true);
+	FocusStyleValid = true;
 	NewFocusedDockArea = FocusedDockWidget->dockAreaWidget();
 	if (NewFocusedDockArea && (FocusedArea != NewFocusedDockArea))
 	{
@@ -163,7 +297,7 @@ void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 
     if (NewFloatingWidget)
     {
-        NewFloatingWidget->setProperty(FocusedDockWidgetProperty, QVariant::fromValue(QPointer<CDockWidget>(DockWidget)));
+        setFocusRecord(NewFloatingWidget, DockWidget);
     }
 
 
@@ -238,20 +372,26 @@ CDockFocusController::~CDockFocusController()
 
 
 //============================================================================
-void CDockFocusController::onFocusWindowChanged(QWindow *focusWindow)
+void CDockFocusController::notifyDockWidgetContentChanged(CDockWidget* DockWidget)
 {
-	if (!focusWindow)
+	auto Root = DockWidget->widget();
+	auto it = d->ContentRoots.find(Root);
+	if (Root && it != d->ContentRoots.end() && it.value() == DockWidget)
 	{
-		return;
+		d->ContentRoots.erase(it);
 	}
+}
 
-    auto vDockWidget = focusWindow->property(FocusedDockWidgetProperty);
-	if (!vDockWidget.isValid())
+
+//============================================================================
+void CDockFocusController::onFocusWindowChanged(QWindow *focusWindow)
+{
+	if (!focusWindow)
 	{
 		return;
 	}
 
-    auto DockWidget = vDockWidget.value<QPointer<CDockWidget>>();
+	auto DockWidget = d->focusRecord(focusWindow);
 	if (!DockWidget)
 	{
 		return;
@@ -280,11 +420,7 @@ void CDockFocusController::onApplicationFocusChanged(QWidget* focusedOld, QWidge
 		return;
 	}
 
-    CDockWidget* DockWidget = qobject_cast<CDockWidget*>(focusedNow);
-	if (!DockWidget)
-	{
-		DockWidget = internal::findParent<CDockWidget*>(focusedNow);
-	}
+	CDockWidget* DockWidget = d->dockWidgetOf(focusedNow);
 
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
     if (!DockWidget)
@@ -298,6 +434,13 @@ void CDockFocusController::onApplicationFocusChanged(QWidget* focusedOld, QWidge
 	}
 #endif
 
+	// Focus changes within the focused dock widget do not change anything
+	if (DockWidget == d->FocusedDockWidget && d->FocusStyleValid
+	 && !d->ForceFocusChangedSignal && DockWidget->dockAreaWidget() == d->FocusedArea)
+	{
+		return;
+	}
+
 	d->updateDockWidgetFocus(DockWidget);
 }
 
@@ -320,6 +463,10 @@ void CDockFocusController::clearDockWidgetFocus(CDockWidget* dockWidget)
 {
 	dockWidget->clearFocus();
 	updateDockWidgetFocusStyle(dockWidget, false);
+	if (dockWidget == d->FocusedDockWidget)
+	{
+		d->FocusStyleValid = false;
+	}
 }
 
 
@@ -390,13 +537,7 @@ void CDockFocusController::notifyFloatingWidgetDrop(CFloatingDockContainer* Floa
 		return;
 	}
 
-    auto vDockWidget = FloatingWidget->property(FocusedDockWidgetProperty);
-	if (!vDockWidget.isValid())
-	{
-		return;
-	}
-
-    auto DockWidget = vDockWidget.value<QPointer<CDockWidget>>();
+	auto DockWidget = d->focusRecord(FloatingWidget);
 	if (DockWidget)
 	{
 		DockWidget->dockAreaWidget()->setCurrentDockWidget(DockWidget);
@@ -412,6 +553,7 @@ void CDockFocusController::onStateRestored()
 	{
 		updateDockWidgetFocusStyle(d->FocusedDockWidget, false);
 	}
+	d->FocusStyleValid = false;
 }
 
 
@@ -63,6 +63,13 @@ public:
 	 */
 	void notifyFloatingWidgetDrop(CFloatingDockContainer* FloatingWidget);
 
+	/**
+	 * A dock widget needs to call this function before its content widget
+	 * is removed or before it leaves the dock manager. The focus controller
+	 * then drops the cached content root of the dock widget.
+	 */
+	void notifyDockWidgetContentChanged(CDockWidget* DockWidget);
+
 	/**
 	 * Returns the dock widget that has focus style in the ui or a nullptr if
 	 * not dock widget is painted focused.
@@ -0,0 +1,482 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayoutSnapshot.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockLayoutSnapshot class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockLayoutSnapshot.h"
+
+#include <QHash>
+#include <QXmlStreamWriter>
+
+#include "DockAreaWidget.h"
+
+#if QT_VERSION < 0x050900
+
+inline char toHexLower(uint value)
+{
+    return "0123456789abcdef"[value & 0xF];
+}
+
+QByteArray qByteArrayToHex(const QByteArray& src, char separator)
+{
+    if(src.size() == 0)
+        return QByteArray();
+
+    const int length = separator ? (src.size() * 3 - 1) : (src.size() * 2);
+    QByteArray hex(length, Qt::Uninitialized);
+    char *hexData = hex.data();
+    const uchar *data = reinterpret_cast<const uchar *>(src.data());
+    for (int i = 0, o = 0; i < src.size(); ++i) {
+        hexData[o++] = toHexLower(data[i] >> 4);
+        hexData[o++] = toHexLower(data[i] & 0xf);
+
+        if ((separator) && (o < length))
+            hexData[o++] = separator;
+    }
+    return hex;
+}
+#endif
+
+namespace ads
+{
+/**
+ * Private data class of CDockLayoutSnapshot class (pimpl)
+ * The data is never modified after the hash value has been calculated.
+ */
+struct DockLayoutSnapshotPrivate
+{
+	CDockLayoutSnapshot::eNodeType Type = CDockLayoutSnapshot::InvalidNode;
+	QVector<CDockLayoutSnapshot> Children;
+	QByteArray Geometry;
+	QList<int> Sizes;
+	QString Name;
+	int Value = -1;
+	int AllowedAreas = 0;
+	int Flags = 0;
+	bool Flag = false;
+	int DockWidgetCount = 0;
+	uint Hash = 0;
+
+	/**
+	 * Mixes the given value into the hash value
+	 */
+	void combine(uint v)
+	{
+		Hash ^= v + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+	}
+
+	/**
+	 * Calculates the hash value and the dock widget count from the node
+	 * data and the already calculated values of the child nodes
+	 */
+	void finalize();
+
+	/**
+	 * Finalizes the given node data and wraps it into a snapshot
+	 */
+	static CDockLayoutSnapshot create(DockLayoutSnapshotPrivate* Data);
+
+	/**
+	 * Compares the node data without the child nodes
+	 */
+	bool equalNode(const DockLayoutSnapshotPrivate& other) const
+	{
+		return Type == other.Type && Value == other.Value
+			&& AllowedAreas == other.AllowedAreas && Flags == other.Flags
+			&& Flag == other.Flag && Name == other.Name && Sizes == other.Sizes
+			&& Geometry == other.Geometry && Children.count() == other.Children.count();
+	}
+};
+// struct DockLayoutSnapshotPrivate
+
+
+//============================================================================
+void DockLayoutSnapshotPrivate::finalize()
+{
+	combine(uint(Type));
+	combine(uint(Value));
+	combine(uint(AllowedAreas));
+	combine(uint(Flags));
+	combine(uint(Flag));
+	combine(uint(qHash(Name)));
+	combine(uint(qHash(Geometry)));
+	for (auto Size : Sizes)
+	{
+		combine(uint(Size));
+	}
+
+	DockWidgetCount = (Type == CDockLayoutSnapshot::DockWidgetNode) ? 1 : 0;
+	for (const auto& Child : Children)
+	{
+		combine(Child.hash());
+		DockWidgetCount += Child.dockWidgetCount();
+	}
+}
+
+
+//============================================================================
+CDockLayoutSnapshot DockLayoutSnapshotPrivate::create(DockLayoutSnapshotPrivate* Data)
+{
+	Data->finalize();
+	return CDockLayoutSnapshot(QSharedPointer<const DockLayoutSnapshotPrivate>(Data));
+}
+
+
+//============================================================================
+CDockLayoutSnapshot::CDockLayoutSnapshot()
+{
+
+}
+
+
+//============================================================================
+CDockLayoutSnapshot::CDockLayoutSnapshot(const QSharedPointer<const DockLayoutSnapshotPrivate>& Data) :
+	d(Data)
+{
+
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createLayout(const QVector<CDockLayoutSnapshot>& Containers)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = LayoutNode;
+	Data->Children = Containers;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createContainer(bool Floating,
+	const QByteArray& Geometry, const QVector<CDockLayoutSnapshot>& Children)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = ContainerNode;
+	Data->Flag = Floating;
+	Data->Geometry = Geometry;
+	Data->Children = Children;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createSplitter(Qt::Orientation Orientation,
+	const QList<int>& Sizes, const QVector<CDockLayoutSnapshot>& Children)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = SplitterNode;
+	Data->Value = Orientation;
+	Data->Sizes = Sizes;
+	Data->Children = Children;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createDockArea(int CurrentIndex,
+	int AllowedAreas, int Flags, const QVector<CDockLayoutSnapshot>& DockWidgets)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = DockAreaNode;
+	Data->Value = CurrentIndex;
+	Data->AllowedAreas = AllowedAreas;
+	Data->Flags = Flags;
+	Data->Children = DockWidgets;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createSideBar(SideBarLocation Location,
+	const QVector<CDockLayoutSnapshot>& DockWidgets)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = SideBarNode;
+	Data->Value = Location;
+	Data->Children = DockWidgets;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockLayoutSnapshot::createDockWidget(const QString& Name,
+	bool Closed, int Size)
+{
+	auto Data = new DockLayoutSnapshotPrivate();
+	Data->Type = DockWidgetNode;
+	Data->Name = Name;
+	Data->Flag = Closed;
+	Data->Value = Size;
+	return DockLayoutSnapshotPrivate::create(Data);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot::eNodeType CDockLayoutSnapshot::type() const
+{
+	return d ? d->Type : InvalidNode;
+}
+
+
+//============================================================================
+bool CDockLayoutSnapshot::isValid() const
+{
+	return type() != InvalidNode;
+}
+
+
+//============================================================================
+QVector<CDockLayoutSnapshot> CDockLayoutSnapshot::children() const
+{
+	return d ? d->Children : QVector<CDockLayoutSnapshot>();
+}
+
+
+//============================================================================
+int CDockLayoutSnapshot::dockWidgetCount() const
+{
+	return d ? d->DockWidgetCount : 0;
+}
+
+
+//============================================================================
+bool CDockLayoutSnapshot::isFloating() const
+{
+	return type() == ContainerNode && d->Flag;
+}
+
+
+//============================================================================
+QByteArray CDockLayoutSnapshot::geometry() const
+{
+	return d ? d->Geometry : QByteArray();
+}
+
+
+//============================================================================
+Qt::Orientation CDockLayoutSnapshot::orientation() const
+{
+	return (type() == SplitterNode) ? Qt::Orientation(d->Value) : Qt::Horizontal;
+}
+
+
+//============================================================================
+QList<int> CDockLayoutSnapshot::sizes() const
+{
+	return d ? d->Sizes : QList<int>();
+}
+
+
+//============================================================================
+int CDockLayoutSnapshot::currentIndex() const
+{
+	return (type() == DockAreaNode) ? d->Value : -1;
+}
+
+
+//============================================================================
+int CDockLayoutSnapshot::allowedAreas() const
+{
+	return d ? d->AllowedAreas : 0;
+}
+
+
+//============================================================================
+int CDockLayoutSnapshot::flags() const
+{
+	return d ? d->Flags : 0;
+}
+
+
+//============================================================================
+SideBarLocation CDockLayoutSnapshot::sideBarLocation() const
+{
+	return (type() == SideBarNode) ? SideBarLocation(d->Value) : SideBarNone;
+}
+
+
+//============================================================================
+QString CDockLayoutSnapshot::name() const
+{
+	return d ? d->Name : QString();
+}
+
+
+//============================================================================
+bool CDockLayoutSnapshot::isClosed() const
+{
+	return type() == DockWidgetNode && d->Flag;
+}
+
+
+//============================================================================
+int CDockLayoutSnapshot::size() const
+{
+	return (type() == DockWidgetNode) ? d->Value : -1;
+}
+
+
+//============================================================================
+uint CDockLayoutSnapshot::hash() const
+{
+	return d ? d->Hash : 0;
+}
+
+
+//============================================================================
+bool CDockLayoutSnapshot::isSharedWith(const CDockLayoutSnapshot& other) const
+{
+	return d == other.d;
+}
+
+
+//============================================================================
+bool CDockLayoutSnapshot::operator==(const CDockLayoutSnapshot& other) const
+{
+	if (d == other.d)
+	{
+		return true;
+	}
+
+	if (!d || !other.d || d->Hash != other.d->Hash || !d->equalNode(*other.d))
+	{
+		return false;
+	}
+
+	for (int i = 0; i < d->Children.count(); ++i)
+	{
+		if (d->Children[i] != other.d->Children[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+//============================================================================
+void CDockLayoutSnapshot::writeState(QXmlStreamWriter& s) const
+{
+	const auto Children = children();
+	switch (type())
+	{
+	case LayoutNode:
+		for (const auto& Child : Children)
+		{
+			Child.writeState(s);
+		}
+		break;
+
+	case ContainerNode:
+		s.writeStartElement("Container");
+		s.writeAttribute("Floating", QString::number(isFloating() ? 1 : 0));
+		if (isFloating())
+		{
+#if QT_VERSION < 0x050900
+			s.writeTextElement("Geometry", qByteArrayToHex(geometry(), ' '));
+#else
+			s.writeTextElement("Geometry", geometry().toHex(' '));
+#endif
+		}
+		for (const auto& Child : Children)
+		{
+			Child.writeState(s);
+		}
+		s.writeEndElement();
+		break;
+
+	case SplitterNode:
+		s.writeStartElement("Splitter");
+		s.writeAttribute("Orientation", (orientation() == Qt::Horizontal) ? "|" : "-");
+		s.writeAttribute("Count", QString::number(Children.count()));
+		for (const auto& Child : Children)
+		{
+			Child.writeState(s);
+		}
+		s.writeStartElement("Sizes");
+		for (auto Size : sizes())
+		{
+			s.writeCharacters(QString::number(Size) + " ");
+		}
+		s.writeEndElement();
+		s.writeEndElement();
+		break;
+
+	case DockAreaNode:
+		{
+			s.writeStartElement("Area");
+			s.writeAttribute("Tabs", QString::number(Children.count()));
+			int Current = currentIndex();
+			s.writeAttribute("Current", (Current >= 0 && Current < Children.count())
+				? Children[Current].name() : QString());
+			if (allowedAreas() != AllDockAreas)
+			{
+				s.writeAttribute("AllowedAreas", QString::number(allowedAreas(), 16));
+			}
+			if (flags() != CDockAreaWidget::DefaultFlags)
+			{
+				s.writeAttribute("Flags", QString::number(flags(), 16));
+			}
+			for (const auto& Child : Children)
+			{
+				Child.writeState(s);
+			}
+			s.writeEndElement();
+		}
+		break;
+
+	case SideBarNode:
+		s.writeStartElement("SideBar");
+		s.writeAttribute("Area", QString::number(sideBarLocation()));
+		s.writeAttribute("Tabs", QString::number(Children.count()));
+		for (const auto& Child : Children)
+		{
+			Child.writeState(s);
+		}
+		s.writeEndElement();
+		break;
+
+	case DockWidgetNode:
+		s.writeStartElement("Widget");
+		s.writeAttribute("Name", name());
+		s.writeAttribute("Closed", QString::number(isClosed() ? 1 : 0));
+		if (size() >= 0)
+		{
+			s.writeAttribute("Size", QString::number(size()));
+		}
+		s.writeEndElement();
+		break;
+
+	default:
+		break;
+	}
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockLayoutSnapshot.cpp
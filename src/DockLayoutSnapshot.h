@@ -0,0 +1,252 @@
+#ifndef DockLayoutSnapshotH
+#define DockLayoutSnapshotH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayoutSnapshot.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockLayoutSnapshot class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "ads_globals.h"
+
+QT_FORWARD_DECLARE_CLASS(QXmlStreamWriter)
+
+namespace ads
+{
+struct DockLayoutSnapshotPrivate;
+
+/**
+ * Immutable description of a dock layout.
+ * A snapshot is a tree of nodes. The root node describes the complete
+ * layout of a dock manager and contains one node for each dock container.
+ * A container node contains the node of its root splitter followed by the
+ * nodes of its auto hide side bars. Splitter nodes contain splitter and
+ * dock area nodes and dock area and side bar nodes contain the nodes of
+ * their dock widgets.
+ * The nodes are implicitly shared and never modified after creation. So
+ * copying a snapshot is cheap, unchanged subtrees can be shared between
+ * snapshots and a snapshot can be passed to and read from any thread.
+ * The hash value of each node is calculated once when the node is created.
+ * Use CDockManager::layoutSnapshot() to create a snapshot of the current
+ * layout.
+ * The snapshot is also the only serializer of the dock layout. The
+ * saveState() functions of the dock manager and of all dock components
+ * write the snapshot of the component via writeState().
+ */
+class ADS_EXPORT CDockLayoutSnapshot
+{
+private:
+	QSharedPointer<const DockLayoutSnapshotPrivate> d; ///< private data (pimpl)
+	friend struct DockLayoutSnapshotPrivate;
+
+	CDockLayoutSnapshot(const QSharedPointer<const DockLayoutSnapshotPrivate>& Data);
+
+public:
+	/**
+	 * The type of a snapshot node
+	 */
+	enum eNodeType
+	{
+		InvalidNode,
+		LayoutNode,
+		ContainerNode,
+		SplitterNode,
+		DockAreaNode,
+		SideBarNode,
+		DockWidgetNode
+	};
+
+	/**
+	 * Creates an invalid snapshot
+	 */
+	CDockLayoutSnapshot();
+
+	/**
+	 * Creates the root node of a layout with the given container nodes
+	 */
+	static CDockLayoutSnapshot createLayout(const QVector<CDockLayoutSnapshot>& Containers);
+
+	/**
+	 * Creates a container node. The Geometry is the saved geometry of
+	 * the floating widget of a floating container.
+	 */
+	static CDockLayoutSnapshot createContainer(bool Floating, const QByteArray& Geometry,
+		const QVector<CDockLayoutSnapshot>& Children);
+
+	/**
+	 * Creates a splitter node with the given orientation, sizes and
+	 * child nodes
+	 */
+	static CDockLayoutSnapshot createSplitter(Qt::Orientation Orientation,
+		const QList<int>& Sizes, const QVector<CDockLayoutSnapshot>& Children);
+
+	/**
+	 * Creates a dock area node. The AllowedAreas and Flags values are
+	 * the integer values of the dock area properties.
+	 */
+	static CDockLayoutSnapshot createDockArea(int CurrentIndex, int AllowedAreas,
+		int Flags, const QVector<CDockLayoutSnapshot>& DockWidgets);
+
+	/**
+	 * Creates an auto hide side bar node for the given side bar location
+	 */
+	static CDockLayoutSnapshot createSideBar(SideBarLocation Location,
+		const QVector<CDockLayoutSnapshot>& DockWidgets);
+
+	/**
+	 * Creates a dock widget node. The Size is the size of the auto hide
+	 * container for dock widgets in a side bar and -1 otherwise.
+	 */
+	static CDockLayoutSnapshot createDockWidget(const QString& Name, bool Closed,
+		int Size = -1);
+
+	/**
+	 * Returns the type of this node
+	 */
+	eNodeType type() const;
+
+	/**
+	 * Returns true, if this is not an invalid node
+	 */
+	bool isValid() const;
+
+	/**
+	 * Returns the child nodes
+	 */
+	QVector<CDockLayoutSnapshot> children() const;
+
+	/**
+	 * Returns the number of dock widget nodes in the subtree of this node
+	 */
+	int dockWidgetCount() const;
+
+	/**
+	 * Returns true, if this is a floating container node
+	 */
+	bool isFloating() const;
+
+	/**
+	 * Returns the saved geometry of a floating container node
+	 */
+	QByteArray geometry() const;
+
+	/**
+	 * Returns the orientation of a splitter node
+	 */
+	Qt::Orientation orientation() const;
+
+	/**
+	 * Returns the sizes of a splitter node
+	 */
+	QList<int> sizes() const;
+
+	/**
+	 * Returns the index of the current dock widget of a dock area node
+	 */
+	int currentIndex() const;
+
+	/**
+	 * Returns the allowed areas of a dock area node
+	 */
+	int allowedAreas() const;
+
+	/**
+	 * Returns the flags of a dock area node
+	 */
+	int flags() const;
+
+	/**
+	 * Returns the location of a side bar node
+	 */
+	SideBarLocation sideBarLocation() const;
+
+	/**
+	 * Returns the object name of a dock widget node
+	 */
+	QString name() const;
+
+	/**
+	 * Returns the closed state of a dock widget node
+	 */
+	bool isClosed() const;
+
+	/**
+	 * Returns the auto hide size of a dock widget node in a side bar or -1
+	 */
+	int size() const;
+
+	/**
+	 * Writes the subtree of this node in the XML format of
+	 * CDockManager::saveState(). A layout node writes all its container
+	 * nodes.
+	 */
+	void writeState(QXmlStreamWriter& Stream) const;
+
+	/**
+	 * Returns the hash value of the subtree of this node
+	 */
+	uint hash() const;
+
+	/**
+	 * Returns true, if both snapshots share the same node. Shared nodes
+	 * are always equal, so this is a cheap early out for comparisons.
+	 */
+	bool isSharedWith(const CDockLayoutSnapshot& other) const;
+
+	/**
+	 * Compares the complete subtrees of both nodes
+	 */
+	bool operator==(const CDockLayoutSnapshot& other) const;
+
+	/**
+	 * Returns true, if the subtrees of both nodes differ
+	 */
+	bool operator!=(const CDockLayoutSnapshot& other) const
+	{
+		return !(*this == other);
+	}
+}; // class CDockLayoutSnapshot
+
+/**
+ * Hash function for using snapshots as QHash or QSet keys
+ */
+#if QT_VERSION >= 0x060000
+inline size_t qHash(const CDockLayoutSnapshot& Snapshot, size_t Seed = 0)
+#else
+inline uint qHash(const CDockLayoutSnapshot& Snapshot, uint Seed = 0)
+#endif
+{
+	return Snapshot.hash() ^ Seed;
+}
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockLayoutSnapshotH
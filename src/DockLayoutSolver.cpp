@@ -0,0 +1,830 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayoutSolver.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockLayoutSolver class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockLayoutSolver.h"
+
+#include <algorithm>
+
+#include "DockLayoutSnapshot.h"
+
+namespace ads
+{
+/**
+ * Same value as QWIDGETSIZE_MAX, which is not available without including
+ * the widget headers
+ */
+static const int MaxWidgetSize = (1 << 24) - 1;
+
+/**
+ * Fixed point arithmetic used by the Qt layout engine for distributing
+ * space without accumulating rounding errors
+ */
+typedef qint64 Fixed64;
+static inline Fixed64 toFixed(int i) { return Fixed64(i) * 256; }
+static inline int fRound(Fixed64 i)
+{
+	return (i % 256 < 128) ? int(i / 256) : 1 + int(i / 256);
+}
+
+
+/**
+ * Private data class of CDockLayoutSolver class (pimpl)
+ */
+struct DockLayoutSolverPrivate
+{
+	/**
+	 * One splitter or dock area node
+	 */
+	struct Node
+	{
+		CDockLayoutSolver::eNodeType Type;
+		int Parent;
+		Qt::Orientation Orientation = Qt::Horizontal;
+		QVector<int> Children;
+		int Size = 0;
+		int Stretch = 0;
+		bool Visible = true;
+		QSize MinimumSize = QSize(0, 0);
+		QSize MaximumSize = QSize(MaxWidgetSize, MaxWidgetSize);
+		QRect Geometry;
+	};
+
+	/**
+	 * One item of the layout chain of a splitter. The chain contains the
+	 * handle and the widget of each splitter child.
+	 */
+	struct ChainItem
+	{
+		int MinimumSize;
+		int SizeHint;
+		int MaximumSize;
+		int Stretch;
+		bool Expansive;
+		bool Empty;
+		bool Done;
+		int Size;
+		int Pos;
+
+		int smartSizeHint() const
+		{
+			return (Stretch > 0) ? MinimumSize : SizeHint;
+		}
+	};
+
+	CDockLayoutSolver* _this;
+	QVector<Node> Nodes;
+	int HandleWidth = 4;
+	QVector<ChainItem> Chain;
+	QVector<int> SortBuffer;
+
+	/**
+	 * Private data constructor
+	 */
+	DockLayoutSolverPrivate(CDockLayoutSolver* _public);
+
+	/**
+	 * Adds a new node and returns its index
+	 */
+	int addNode(int Parent, CDockLayoutSolver::eNodeType Type, int Size);
+
+	/**
+	 * Returns true, if the given index is a valid node index
+	 */
+	bool isValid(int Index) const
+	{
+		return Index >= 0 && Index < Nodes.count();
+	}
+
+	/**
+	 * Computes the visibility and the minimum size of the given splitter
+	 * from its children
+	 */
+	void computeMinimumSize(Node& Splitter);
+
+	/**
+	 * Adds the nodes of the given snapshot node
+	 */
+	int addSnapshot(const CDockLayoutSnapshot& Snapshot, int Parent, int Size,
+		const QSize& MinimumSize);
+
+	/**
+	 * Distributes the space of the given splitter between its children
+	 */
+	void layoutSplitter(const Node& Splitter);
+
+	/**
+	 * Distributes Space between the items of the chain like qGeomCalc()
+	 * does for QSplitter
+	 */
+	void geomCalc(int Pos, int Space);
+};
+// struct DockLayoutSolverPrivate
+
+
+//============================================================================
+DockLayoutSolverPrivate::DockLayoutSolverPrivate(CDockLayoutSolver* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+int DockLayoutSolverPrivate::addNode(int Parent, CDockLayoutSolver::eNodeType Type,
+	int Size)
+{
+	if (Parent != -1 && (!isValid(Parent) || Nodes[Parent].Type != CDockLayoutSolver::SplitterNode))
+	{
+		return -1;
+	}
+
+	Node n;
+	n.Type = Type;
+	n.Parent = Parent;
+	n.Size = qMax(Size, 0);
+	int Index = Nodes.count();
+	Nodes.append(n);
+	if (Parent != -1)
+	{
+		Nodes[Parent].Children.append(Index);
+	}
+	return Index;
+}
+
+
+//============================================================================
+void DockLayoutSolverPrivate::computeMinimumSize(Node& Splitter)
+{
+	// Same calculation as QSplitter::minimumSizeHint()
+	int Along = 0;
+	int Across = 0;
+	bool First = true;
+	for (auto Index : Splitter.Children)
+	{
+		const auto& Child = Nodes[Index];
+		if (!Child.Visible)
+		{
+			continue;
+		}
+
+		if (!First)
+		{
+			Along += HandleWidth;
+		}
+		First = false;
+		if (Splitter.Orientation == Qt::Horizontal)
+		{
+			Along += Child.MinimumSize.width();
+			Across = qMax(Across, Child.MinimumSize.height());
+		}
+		else
+		{
+			Along += Child.MinimumSize.height();
+			Across = qMax(Across, Child.MinimumSize.width());
+		}
+	}
+
+	Splitter.Visible = !First;
+	Splitter.MinimumSize = (Splitter.Orientation == Qt::Horizontal)
+		? QSize(Along, Across) : QSize(Across, Along);
+}
+
+
+//============================================================================
+int DockLayoutSolverPrivate::addSnapshot(const CDockLayoutSnapshot& Snapshot,
+	int Parent, int Size, const QSize& MinimumSize)
+{
+	switch (Snapshot.type())
+	{
+	case CDockLayoutSnapshot::ContainerNode:
+		for (const auto& Child : Snapshot.children())
+		{
+			if (Child.type() == CDockLayoutSnapshot::SplitterNode)
+			{
+				return addSnapshot(Child, Parent, Size, MinimumSize);
+			}
+		}
+		return -1;
+
+	case CDockLayoutSnapshot::SplitterNode:
+		{
+			int Index = addNode(Parent, CDockLayoutSolver::SplitterNode, Size);
+			if (Index < 0)
+			{
+				return -1;
+			}
+			Nodes[Index].Orientation = Snapshot.orientation();
+			const auto Children = Snapshot.children();
+			const auto Sizes = Snapshot.sizes();
+			for (int i = 0; i < Children.count(); ++i)
+			{
+				addSnapshot(Children[i], Index, i < Sizes.count() ? Sizes[i] : 0,
+					MinimumSize);
+			}
+			return Index;
+		}
+
+	case CDockLayoutSnapshot::DockAreaNode:
+		{
+			int Index = addNode(Parent, CDockLayoutSolver::DockAreaNode, Size);
+			if (Index < 0)
+			{
+				return -1;
+			}
+			bool Visible = false;
+			for (const auto& DockWidget : Snapshot.children())
+			{
+				Visible = Visible || !DockWidget.isClosed();
+			}
+			Nodes[Index].Visible = Visible;
+			Nodes[Index].MinimumSize = MinimumSize;
+			return Index;
+		}
+
+	default:
+		return -1;
+	}
+}
+
+
+//============================================================================
+void DockLayoutSolverPrivate::layoutSplitter(const Node& Splitter)
+{
+	const bool Horizontal = Splitter.Orientation == Qt::Horizontal;
+	const QRect& r = Splitter.Geometry;
+
+	// Like QSplitter, all children resize with the splitter if no stretch
+	// factor is set
+	bool NoStretchFactorsSet = true;
+	for (auto Index : Splitter.Children)
+	{
+		if (Nodes[Index].Stretch)
+		{
+			NoStretchFactorsSet = false;
+			break;
+		}
+	}
+
+	// Build the chain from the handle and the widget of each child like
+	// QSplitterPrivate::doResize()
+	Chain.resize(Splitter.Children.count() * 2);
+	bool First = true;
+	int j = 0;
+	for (auto Index : Splitter.Children)
+	{
+		const auto& Child = Nodes[Index];
+		ChainItem& Handle = Chain[j++];
+		Handle.Stretch = 0;
+		Handle.Expansive = false;
+		Handle.Done = false;
+		Handle.Size = 0;
+		if (!Child.Visible || First)
+		{
+			Handle.MinimumSize = Handle.SizeHint = Handle.MaximumSize = 0;
+			Handle.Empty = true;
+		}
+		else
+		{
+			Handle.MinimumSize = Handle.SizeHint = Handle.MaximumSize = HandleWidth;
+			Handle.Empty = false;
+		}
+
+		ChainItem& Item = Chain[j++];
+		Item.Stretch = 0;
+		Item.Expansive = false;
+		Item.Done = false;
+		Item.Size = 0;
+		if (!Child.Visible)
+		{
+			Item.MinimumSize = Item.SizeHint = Item.MaximumSize = 0;
+			Item.Empty = true;
+			continue;
+		}
+
+		First = false;
+		Item.Empty = false;
+		Item.MinimumSize = Horizontal ? Child.MinimumSize.width() : Child.MinimumSize.height();
+		Item.MaximumSize = Horizontal ? Child.MaximumSize.width() : Child.MaximumSize.height();
+		if (NoStretchFactorsSet || Child.Stretch)
+		{
+			Item.Stretch = Child.Size;
+			Item.SizeHint = Item.MinimumSize;
+			Item.Expansive = true;
+		}
+		else
+		{
+			Item.SizeHint = qMax(Child.Size, Item.MinimumSize);
+		}
+	}
+
+	geomCalc(Horizontal ? r.left() : r.top(), Horizontal ? r.width() : r.height());
+
+	j = 1;
+	for (auto Index : Splitter.Children)
+	{
+		const ChainItem& Item = Chain[j];
+		j += 2;
+		auto& Child = Nodes[Index];
+		if (!Child.Visible)
+		{
+			Child.Geometry = QRect();
+			continue;
+		}
+
+		Child.Geometry = Horizontal
+			? QRect(Item.Pos, r.top(), Item.Size, r.height())
+			: QRect(r.left(), Item.Pos, r.width(), Item.Size);
+	}
+}
+
+
+//============================================================================
+void DockLayoutSolverPrivate::geomCalc(int Pos, int Space)
+{
+	const int Count = Chain.count();
+	if (!Count)
+	{
+		return;
+	}
+
+	int cHint = 0;
+	int cMin = 0;
+	int NonEmptyCount = 0;
+	for (const auto& Item : Chain)
+	{
+		cHint += Item.smartSizeHint();
+		cMin += Item.MinimumSize;
+		NonEmptyCount += Item.Empty ? 0 : 1;
+	}
+
+	int ExtraSpace = 0;
+	if (Space <= 0)
+	{
+		for (auto& Item : Chain)
+		{
+			Item.Size = 0;
+		}
+	}
+	else if (Space < cMin)
+	{
+		// Less space than the minimum size - take from the biggest first
+		SortBuffer.resize(Count);
+		for (int i = 0; i < Count; ++i)
+		{
+			SortBuffer[i] = Chain[i].MinimumSize;
+		}
+		std::sort(SortBuffer.begin(), SortBuffer.end());
+
+		int Sum = 0;
+		int Idx = 0;
+		int SpaceUsed = 0;
+		int Current = 0;
+		while (Idx < Count && SpaceUsed < Space)
+		{
+			Current = SortBuffer[Idx];
+			SpaceUsed = Sum + Current * (Count - Idx);
+			Sum += Current;
+			++Idx;
+		}
+		--Idx;
+		int Deficit = SpaceUsed - Space;
+		int Items = Count - Idx;
+		int DeficitPerItem = Deficit / Items;
+		int Remainder = Deficit % Items;
+		int MaxVal = Current - DeficitPerItem;
+		int Rest = 0;
+		for (auto& Item : Chain)
+		{
+			int MaxV = MaxVal;
+			Rest += Remainder;
+			if (Rest >= Items)
+			{
+				MaxV--;
+				Rest -= Items;
+			}
+			Item.Size = qMax(0, qMin(Item.MinimumSize, MaxV));
+			Item.Done = true;
+		}
+	}
+	else if (Space < cHint)
+	{
+		// Less space than the size hint but more than the minimum size -
+		// take space equally from each item
+		int n = Count;
+		int Overdraft = cHint - Space;
+		for (auto& Item : Chain)
+		{
+			if (Item.MinimumSize >= Item.smartSizeHint())
+			{
+				Item.Size = Item.smartSizeHint();
+				Item.Done = true;
+				n--;
+			}
+		}
+
+		bool Finished = (n == 0);
+		while (!Finished)
+		{
+			Finished = true;
+			Fixed64 fpOver = toFixed(Overdraft);
+			Fixed64 fpW = 0;
+			for (auto& Item : Chain)
+			{
+				if (Item.Done)
+				{
+					continue;
+				}
+
+				fpW += fpOver / n;
+				int w = fRound(fpW);
+				Item.Size = Item.smartSizeHint() - w;
+				fpW -= toFixed(w);
+				if (Item.Size < Item.MinimumSize)
+				{
+					Item.Done = true;
+					Item.Size = Item.MinimumSize;
+					Finished = false;
+					Overdraft -= Item.smartSizeHint() - Item.MinimumSize;
+					n--;
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		// Extra space - distribute the space according to the stretch
+		// factors and respect the maximum sizes
+		int n = Count;
+		int SpaceLeft = Space;
+		int SumStretch = 0;
+		int ExpandingCount = 0;
+		for (auto& Item : Chain)
+		{
+			if (Item.MaximumSize <= Item.smartSizeHint())
+			{
+				Item.Size = Item.MaximumSize;
+				Item.Done = true;
+				SpaceLeft -= Item.MaximumSize;
+				n--;
+			}
+			else
+			{
+				SumStretch += Item.Stretch;
+				ExpandingCount += Item.Expansive ? 1 : 0;
+			}
+		}
+
+		int Surplus;
+		int Deficit;
+		do
+		{
+			Surplus = Deficit = 0;
+			Fixed64 fpSpace = toFixed(SpaceLeft);
+			Fixed64 fpW = 0;
+			for (auto& Item : Chain)
+			{
+				if (Item.Done)
+				{
+					continue;
+				}
+
+				if (SumStretch > 0)
+				{
+					fpW += (fpSpace * Item.Stretch) / SumStretch;
+				}
+				else if (ExpandingCount > 0)
+				{
+					fpW += (fpSpace * (Item.Expansive ? 1 : 0)) / ExpandingCount;
+				}
+				else
+				{
+					fpW += fpSpace / n;
+				}
+				int w = fRound(fpW);
+				Item.Size = w;
+				fpW -= toFixed(w);
+				if (w < Item.smartSizeHint())
+				{
+					Deficit += Item.smartSizeHint() - w;
+				}
+				else if (w > Item.MaximumSize)
+				{
+					Surplus += w - Item.MaximumSize;
+				}
+			}
+
+			if (Deficit > 0 && Surplus <= Deficit)
+			{
+				// Give to the ones that have too little
+				for (auto& Item : Chain)
+				{
+					if (!Item.Done && Item.Size < Item.smartSizeHint())
+					{
+						Item.Size = Item.smartSizeHint();
+						Item.Done = true;
+						SpaceLeft -= Item.smartSizeHint();
+						SumStretch -= Item.Stretch;
+						ExpandingCount -= Item.Expansive ? 1 : 0;
+						n--;
+					}
+				}
+			}
+
+			if (Surplus > 0 && Surplus >= Deficit)
+			{
+				// Take from the ones that have too much
+				for (auto& Item : Chain)
+				{
+					if (!Item.Done && Item.Size > Item.MaximumSize)
+					{
+						Item.Size = Item.MaximumSize;
+						Item.Done = true;
+						SpaceLeft -= Item.MaximumSize;
+						SumStretch -= Item.Stretch;
+						ExpandingCount -= Item.Expansive ? 1 : 0;
+						n--;
+					}
+				}
+			}
+		} while (n > 0 && Surplus != Deficit);
+
+		if (n == 0)
+		{
+			ExtraSpace = SpaceLeft;
+		}
+	}
+
+	// If all items reached their maximum size, the remaining space is
+	// distributed around the items
+	int Extra = ExtraSpace / (NonEmptyCount + 1);
+	int p = Pos + Extra;
+	for (auto& Item : Chain)
+	{
+		Item.Pos = p;
+		p += Item.Size;
+		if (!Item.Empty)
+		{
+			p += Extra;
+		}
+	}
+}
+
+
+//============================================================================
+CDockLayoutSolver::CDockLayoutSolver() :
+	d(new DockLayoutSolverPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CDockLayoutSolver::~CDockLayoutSolver()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CDockLayoutSolver::clear()
+{
+	d->Nodes.clear();
+}
+
+
+//============================================================================
+void CDockLayoutSolver::reserve(int Count)
+{
+	d->Nodes.reserve(Count);
+}
+
+
+//============================================================================
+int CDockLayoutSolver::addSplitter(int Parent, Qt::Orientation Orientation, int Size)
+{
+	int Index = d->addNode(Parent, SplitterNode, Size);
+	if (Index >= 0)
+	{
+		d->Nodes[Index].Orientation = Orientation;
+	}
+	return Index;
+}
+
+
+//============================================================================
+int CDockLayoutSolver::addDockArea(int Parent, int Size, const QSize& MinimumSize)
+{
+	int Index = d->addNode(Parent, DockAreaNode, Size);
+	if (Index >= 0)
+	{
+		d->Nodes[Index].MinimumSize = MinimumSize;
+	}
+	return Index;
+}
+
+
+//============================================================================
+int CDockLayoutSolver::addSnapshot(const CDockLayoutSnapshot& Snapshot, int Parent,
+	const QSize& MinimumSize)
+{
+	return d->addSnapshot(Snapshot, Parent, 0, MinimumSize);
+}
+
+
+//============================================================================
+void CDockLayoutSolver::setMaximumSize(int Node, const QSize& MaximumSize)
+{
+	if (d->isValid(Node) && d->Nodes[Node].Type == DockAreaNode)
+	{
+		d->Nodes[Node].MaximumSize = MaximumSize.boundedTo(QSize(MaxWidgetSize, MaxWidgetSize));
+	}
+}
+
+
+//============================================================================
+void CDockLayoutSolver::setStretchFactor(int Node, int Stretch)
+{
+	if (d->isValid(Node))
+	{
+		d->Nodes[Node].Stretch = Stretch;
+	}
+}
+
+
+//============================================================================
+void CDockLayoutSolver::setVisible(int Node, bool Visible)
+{
+	if (d->isValid(Node) && d->Nodes[Node].Type == DockAreaNode)
+	{
+		d->Nodes[Node].Visible = Visible;
+	}
+}
+
+
+//============================================================================
+void CDockLayoutSolver::setSize(int Node, int Size)
+{
+	if (d->isValid(Node))
+	{
+		d->Nodes[Node].Size = qMax(Size, 0);
+	}
+}
+
+
+//============================================================================
+void CDockLayoutSolver::setHandleWidth(int Width)
+{
+	d->HandleWidth = qMax(Width, 0);
+}
+
+
+//============================================================================
+int CDockLayoutSolver::handleWidth() const
+{
+	return d->HandleWidth;
+}
+
+
+//============================================================================
+void CDockLayoutSolver::solve(const QRect& Rect)
+{
+	// Children always follow their parents, so iterating backwards visits
+	// all children before their parent
+	for (int i = d->Nodes.count() - 1; i >= 0; --i)
+	{
+		auto& Node = d->Nodes[i];
+		if (Node.Type == SplitterNode)
+		{
+			d->computeMinimumSize(Node);
+		}
+	}
+
+	// Iterating forwards visits all parents before their children
+	for (int i = 0; i < d->Nodes.count(); ++i)
+	{
+		auto& Node = d->Nodes[i];
+		if (Node.Parent == -1)
+		{
+			Node.Geometry = Node.Visible ? Rect : QRect();
+		}
+
+		if (Node.Type == SplitterNode && Node.Visible)
+		{
+			d->layoutSplitter(Node);
+		}
+		else if (Node.Type == SplitterNode)
+		{
+			for (auto Child : Node.Children)
+			{
+				d->Nodes[Child].Geometry = QRect();
+			}
+		}
+	}
+}
+
+
+//============================================================================
+int CDockLayoutSolver::count() const
+{
+	return d->Nodes.count();
+}
+
+
+//============================================================================
+CDockLayoutSolver::eNodeType CDockLayoutSolver::type(int Node) const
+{
+	return d->isValid(Node) ? d->Nodes[Node].Type : DockAreaNode;
+}
+
+
+//============================================================================
+int CDockLayoutSolver::parent(int Node) const
+{
+	return d->isValid(Node) ? d->Nodes[Node].Parent : -1;
+}
+
+
+//============================================================================
+QVector<int> CDockLayoutSolver::children(int Node) const
+{
+	return d->isValid(Node) ? d->Nodes[Node].Children : QVector<int>();
+}
+
+
+//============================================================================
+bool CDockLayoutSolver::isVisible(int Node) const
+{
+	return d->isValid(Node) && d->Nodes[Node].Visible;
+}
+
+
+//============================================================================
+QSize CDockLayoutSolver::minimumSize(int Node) const
+{
+	return d->isValid(Node) ? d->Nodes[Node].MinimumSize : QSize();
+}
+
+
+//============================================================================
+QRect CDockLayoutSolver::geometry(int Node) const
+{
+	return d->isValid(Node) ? d->Nodes[Node].Geometry : QRect();
+}
+
+
+//============================================================================
+QList<int> CDockLayoutSolver::sizes(int Node) const
+{
+	QList<int> Result;
+	if (!d->isValid(Node) || d->Nodes[Node].Type != SplitterNode)
+	{
+		return Result;
+	}
+
+	const auto& Splitter = d->Nodes[Node];
+	for (auto Index : Splitter.Children)
+	{
+		const auto& Geometry = d->Nodes[Index].Geometry;
+		if (!d->Nodes[Index].Visible)
+		{
+			Result.append(0);
+		}
+		else
+		{
+			Result.append(Splitter.Orientation == Qt::Horizontal
+				? Geometry.width() : Geometry.height());
+		}
+	}
+	return Result;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockLayoutSolver.cpp
@@ -0,0 +1,211 @@
+#ifndef DockLayoutSolverH
+#define DockLayoutSolverH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayoutSolver.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockLayoutSolver class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockLayoutSolverPrivate;
+class CDockLayoutSnapshot;
+
+/**
+ * Widget free geometry engine for dock layouts.
+ * The solver works on a tree of splitter and dock area nodes and computes
+ * the final geometry of each node for a given root rectangle. It
+ * distributes the space of a splitter between its children in the same way
+ * CDockSplitter does, taking the splitter handle width, the current sizes
+ * of the children, their stretch factors and their minimum and maximum
+ * sizes into account. Splitters without visible content are hidden like
+ * in CDockContainerWidget.
+ * The nodes are stored in a flat array and children always follow their
+ * parents. So solve() computes all minimum sizes in one bottom up pass and
+ * all geometries in one top down pass without any recursion or memory
+ * allocations and can be called on each resize, even for layouts with
+ * thousands of dock areas.
+ */
+class ADS_EXPORT CDockLayoutSolver
+{
+private:
+	DockLayoutSolverPrivate* d; ///< private data (pimpl)
+	friend struct DockLayoutSolverPrivate;
+
+public:
+	/**
+	 * The type of a solver node
+	 */
+	enum eNodeType
+	{
+		SplitterNode,
+		DockAreaNode
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CDockLayoutSolver();
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockLayoutSolver();
+
+	/**
+	 * Removes all nodes
+	 */
+	void clear();
+
+	/**
+	 * Reserves memory for the given number of nodes
+	 */
+	void reserve(int Count);
+
+	/**
+	 * Adds a splitter node to the given parent splitter and returns the
+	 * index of the new node. A Parent value of -1 adds a root node.
+	 * The Size is the current size of the node in its parent splitter like
+	 * it is passed to QSplitter::setSizes().
+	 * Returns -1, if Parent is not a splitter node.
+	 */
+	int addSplitter(int Parent, Qt::Orientation Orientation, int Size = 0);
+
+	/**
+	 * Adds a dock area node with the given current size and minimum size
+	 * to the given parent splitter and returns the index of the new node.
+	 * Returns -1, if Parent is not a splitter node.
+	 */
+	int addDockArea(int Parent, int Size = 0, const QSize& MinimumSize = QSize(0, 0));
+
+	/**
+	 * Adds the splitter and dock area nodes of the given snapshot node to
+	 * the given parent and returns the index of the added node.
+	 * For a container node, its root splitter is added. Dock areas without
+	 * open dock widgets are added as hidden nodes. The snapshot does not
+	 * contain any size limits, so all dock areas get the given minimum size.
+	 * Returns -1, if the snapshot node contains no splitter or dock area.
+	 */
+	int addSnapshot(const CDockLayoutSnapshot& Snapshot, int Parent = -1,
+		const QSize& MinimumSize = QSize(0, 0));
+
+	/**
+	 * Sets the maximum size of the given dock area node
+	 */
+	void setMaximumSize(int Node, const QSize& MaximumSize);
+
+	/**
+	 * Sets the stretch factor of the given node like
+	 * QSplitter::setStretchFactor(). If any child of a splitter has a non
+	 * zero stretch factor, only the children with a non zero stretch
+	 * factor are resized if the splitter is resized.
+	 */
+	void setStretchFactor(int Node, int Stretch);
+
+	/**
+	 * Shows or hides the given dock area node.
+	 * The visibility of splitter nodes depends on their content.
+	 */
+	void setVisible(int Node, bool Visible);
+
+	/**
+	 * Sets the current size of the given node in its parent splitter
+	 */
+	void setSize(int Node, int Size);
+
+	/**
+	 * Sets the width of the splitter handles.
+	 * The default value is 4. Pass QSplitter::handleWidth() of a dock
+	 * splitter to match the handle width of the current style.
+	 */
+	void setHandleWidth(int Width);
+
+	/**
+	 * Returns the width of the splitter handles
+	 */
+	int handleWidth() const;
+
+	/**
+	 * Computes the geometry of all nodes. All root nodes are laid out into
+	 * the given rectangle.
+	 */
+	void solve(const QRect& Rect);
+
+	/**
+	 * Returns the number of nodes
+	 */
+	int count() const;
+
+	/**
+	 * Returns the type of the given node
+	 */
+	eNodeType type(int Node) const;
+
+	/**
+	 * Returns the parent of the given node or -1 for a root node
+	 */
+	int parent(int Node) const;
+
+	/**
+	 * Returns the children of the given splitter node
+	 */
+	QVector<int> children(int Node) const;
+
+	/**
+	 * Returns true, if the given node is visible. A splitter is only
+	 * visible, if it contains a visible dock area. Valid after solve().
+	 */
+	bool isVisible(int Node) const;
+
+	/**
+	 * Returns the minimum size of the given node. Valid after solve().
+	 */
+	QSize minimumSize(int Node) const;
+
+	/**
+	 * Returns the computed geometry of the given node in the coordinates
+	 * of the rectangle passed to solve()
+	 */
+	QRect geometry(int Node) const;
+
+	/**
+	 * Returns the computed sizes of the children of the given splitter
+	 * node. The sizes can be passed to QSplitter::setSizes() to apply
+	 * the computed geometry.
+	 */
+	QList<int> sizes(int Node) const;
+}; // class CDockLayoutSolver
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockLayoutSolverH
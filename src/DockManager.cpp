@@ -29,6 +29,7 @@
 //                                   INCLUDES
 //============================================================================
 #include "AutoHideDockContainer.h"
+#include "DockMemoryUsage.h"
 #include "DockWidgetTab.h"
 #include "DockManager.h"
 
@@ -42,12 +43,18 @@
 #include <QFile>
 #include <QAction>
 #include <QXmlStreamWriter>
+#include <QBuffer>
 #include <QSettings>
 #include <QMenu>
 #include <QApplication>
 #include <QWindow>
 #include <QToolBar>
 #include <QWindowStateChangeEvent>
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSet>
 
 #include "FloatingDockContainer.h"
 #include "DockOverlay.h"
@@ -56,12 +63,21 @@
 #include "DockAreaWidget.h"
 #include "IconProvider.h"
 #include "DockingStateReader.h"
+#include "DockingStateStream.h"
+#include "PerspectiveLibrary.h"
+#include "LayoutSubtreeStore.h"
 #include "DockAreaTitleBar.h"
 #include "DockFocusController.h"
+#include "DockCommandQueue.h"
+#include "DockOcclusionTracker.h"
+#include "DockQuickOpen.h"
 #include "DockSplitter.h"
+#include "DockComponentsFactory.h"
+#include "AutoHideTab.h"
 
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
 #include "linux/FloatingWidgetTitleBar.h"
+#include "linux/FloatingStackingManager.h"
 #endif
 
 
@@ -97,6 +113,26 @@ static CDockManager::AutoHideFlags StaticAutoHideConfigFlags; // auto hide featu
 
 static QString FloatingContainersTitle;
 
+/**
+ * A dock widget handle contains the index of its slot in the handle table
+ * in the lower bits and a generation counter in the upper bits. The
+ * generation changes each time a slot is reused, so a stale handle never
+ * resolves to another dock widget.
+ */
+static const int DockWidgetHandleIndexBits = 20;
+static const int DockWidgetHandleIndexMask = (1 << DockWidgetHandleIndexBits) - 1;
+static const int DockWidgetHandleGenerationMask = 0x7ff;
+
+/**
+ * One slot of the dock widget handle table
+ */
+struct DockWidgetHandleSlot
+{
+	CDockWidget* DockWidget = nullptr;
+	int Handle = -1;
+	int Generation = 0;
+};
+
 /**
  * Private data class of CDockManager class (pimpl)
  */
@@ -106,16 +142,35 @@ struct DockManagerPrivate
 	QList<QPointer<CFloatingDockContainer>> FloatingWidgets;
 	QList<QPointer<CFloatingDockContainer>> HiddenFloatingWidgets;
 	QList<CDockContainerWidget*> Containers;
-	CDockOverlay* ContainerOverlay;
-	CDockOverlay* DockAreaOverlay;
+	CDockOverlay* ContainerOverlay = nullptr;
+	CDockOverlay* DockAreaOverlay = nullptr;
 	QMap<QString, CDockWidget*> DockWidgetsMap;
+	QVector<DockWidgetHandleSlot> DockWidgetHandles;
+	QVector<int> FreeDockWidgetHandles;
 	QMap<QString, QByteArray> Perspectives;
+	CPerspectiveLibrary* PerspectiveLibrary = nullptr;
+	CLayoutSubtreeStore PerspectiveSubtrees;
+	quint64 LayoutGeneration = 0;
+	quint64 AutosavedGeneration = 0;
+	bool AutosaveRunning = false;
+	QString AutosaveFileName;
+	int AutosaveVersion = 0;
+	int AutosaveInterval = 5000;
+	QTimer* AutosaveTimer = nullptr;
+	QThreadPool AutosaveThreadPool;
 	QMap<QString, QMenu*> ViewMenuGroups;
 	QMenu* ViewMenu;
 	CDockManager::eViewMenuInsertionOrder MenuInsertionOrder = CDockManager::MenuAlphabeticallySorted;
 	bool RestoringState = false;
 	QVector<CFloatingDockContainer*> UninitializedFloatingWidgets;
 	CDockFocusController* FocusController = nullptr;
+	CDockCommandQueue* CommandQueue = nullptr;
+	CDockOcclusionTracker* OcclusionTracker = nullptr;
+	CDockWidgetIndex* DockWidgetIndex = nullptr;
+	CDockManager::ConfigFlags ConfigFlags;
+	CDockManager::AutoHideFlags AutoHideConfigFlags;
+	bool HasConfigFlags = false;
+	bool HasAutoHideConfigFlags = false;
     CDockWidget* CentralWidget = nullptr;
     bool IsLeavingMinimized = false;
 	Qt::ToolButtonStyle ToolBarStyleDocked = Qt::ToolButtonIconOnly;
@@ -123,29 +178,105 @@ struct DockManagerPrivate
 	QSize ToolBarIconSizeDocked = QSize(16, 16);
 	QSize ToolBarIconSizeFloating = QSize(24, 24);
 	CDockWidget::DockWidgetFeatures LockedDockWidgetFeatures;
+	QList<CFloatingDockContainer*> FloatingWidgetPool;
+	int FloatingWidgetPoolSize = 0;
+	bool FillingFloatingWidgetPool = false;
+	bool FloatingWidgetPoolFillPending = false;
+	QList<CDockAreaWidget*> DockAreaPool;
+	QList<CAutoHideTab*> AutoHideTabPool;
+	QList<QPointer<CDockAreaWidget>> RecycledDockAreas;
+	QList<QPair<QPointer<CAutoHideTab>, QPointer<CDockWidget>>> RecycledAutoHideTabs;
+	int ComponentsFactoryRevision = 0;
+	bool ComponentRecyclingPending = false;
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+	CFloatingStackingManager StackingManager;
+#endif
 
 	/**
 	 * Private data constructor
 	 */
 	DockManagerPrivate(CDockManager* _public);
 
+	/**
+	 * Creates the overlays on first use. Most dock managers never take
+	 * part in a drag operation, so the overlay windows are not created
+	 * together with the dock manager.
+	 */
+	void createOverlays();
+
+	/**
+	 * Creates the focus controller and the auto hide side bars, if the
+	 * configuration flags of this dock manager require them
+	 */
+	void applyConfigFlags();
+
+	/**
+	 * Schedules the creation of pooled floating widgets for the next
+	 * time the event loop becomes idle
+	 */
+	void scheduleFloatingWidgetPoolFill();
+
+	/**
+	 * Creates one pooled floating widget and reschedules itself until the
+	 * pool is full. Creating the widgets one by one keeps the event loop
+	 * responsive
+	 */
+	void fillFloatingWidgetPool();
+
+	/**
+	 * Resets the recycled dock areas and auto hide tabs in the next event
+	 * loop iteration. The components may still be used by the code that
+	 * released them until then.
+	 */
+	void scheduleComponentRecycling();
+
+	/**
+	 * Resets the recycled components and moves them into the pools or
+	 * deletes them, if the pools are full
+	 */
+	void recycleComponents();
+
+	/**
+	 * Deletes the pooled components, if the components factory has been
+	 * replaced since they have been created
+	 */
+	void dropOutdatedComponents();
+
 	/**
 	 * Checks if the given data stream is a valid docking system state
 	 * file.
 	 */
-	bool checkFormat(const QByteArray &state, int version);
+	bool checkFormat(QIODevice* Device, int version);
 
 	/**
-	 * Restores the state
+	 * Restores the state from the uncompressed or chunk compressed data
+	 * in the given device
 	 */
-	bool restoreStateFromXml(const QByteArray &state, int version, bool Testing = internal::Restore);
+	bool restoreStateFromXml(QIODevice* Device, int version, bool Testing = internal::Restore);
 
 	/**
 	 * Restore state
 	 */
-	bool restoreState(const QByteArray &state, int version);
+	bool restoreState(QIODevice* Device, int version);
+
+	/**
+	 * Restores the state from the given random access device that contains
+	 * uncompressed or chunk compressed data
+	 */
+	bool restoreStateFromDevice(QIODevice* Device, int version);
+
+	/**
+	 * Writes the complete state into the given XML stream writer
+	 */
+	void saveState(QXmlStreamWriter& s, int version) const;
 
 	void restoreDockWidgetsOpenState();
+
+	/**
+	 * Connects the layout change signals of the given container to
+	 * markLayoutDirty()
+	 */
+	void trackLayoutChanges(CDockContainerWidget* DockContainer);
 	void restoreDockAreasIndices();
 	void emitTopLevelEvents();
 
@@ -161,6 +292,32 @@ struct DockManagerPrivate
 		}
 	}
 
+	/**
+	 * Adds the given dock widget to the dock widgets map and assigns a
+	 * handle, if it does not have a valid handle yet
+	 */
+	void registerDockWidget(CDockWidget* DockWidget);
+
+	/**
+	 * Removes the given dock widget from the dock widgets map and releases
+	 * its handle
+	 */
+	void unregisterDockWidget(CDockWidget* DockWidget);
+
+	/**
+	 * Returns the dock widget with the given handle or nullptr
+	 */
+	CDockWidget* dockWidgetFromHandle(int Handle) const
+	{
+		int Index = Handle & DockWidgetHandleIndexMask;
+		if (Handle < 0 || Index >= DockWidgetHandles.count()
+		 || DockWidgetHandles[Index].Handle != Handle)
+		{
+			return nullptr;
+		}
+		return DockWidgetHandles[Index].DockWidget;
+	}
+
 	void markDockWidgetsDirty()
 	{
 		for (auto DockWidget : DockWidgetsMap)
@@ -190,10 +347,112 @@ struct DockManagerPrivate
 DockManagerPrivate::DockManagerPrivate(CDockManager* _public) :
 	_this(_public)
 {
+	// Autosave files are written one after the other
+	AutosaveThreadPool.setMaxThreadCount(1);
+}
+
+
+//============================================================================
+void DockManagerPrivate::trackLayoutChanges(CDockContainerWidget* DockContainer)
+{
+	// Containers of reused floating widgets are registered multiple times
+	QObject::connect(DockContainer, &CDockContainerWidget::dockAreasAdded,
+		_this, &CDockManager::markLayoutDirty, Qt::UniqueConnection);
+	QObject::connect(DockContainer, &CDockContainerWidget::dockAreasRemoved,
+		_this, &CDockManager::markLayoutDirty, Qt::UniqueConnection);
+	QObject::connect(DockContainer, &CDockContainerWidget::dockAreaViewToggled,
+		_this, &CDockManager::markLayoutDirty, Qt::UniqueConnection);
+}
+
 
+/**
+ * Writes the complete dock manager state document for the given layout
+ * snapshot. This is used by saveState() and by the autosave task, so both
+ * write the state via CDockLayoutSnapshot::writeState().
+ */
+static void writeLayoutState(QXmlStreamWriter& s, const CDockLayoutSnapshot& Layout,
+	int Version, const QString& CentralWidget)
+{
+	s.writeStartDocument();
+	s.writeStartElement("QtAdvancedDockingSystem");
+	s.writeAttribute("Version", QString::number(CurrentVersion));
+	s.writeAttribute("UserVersion", QString::number(Version));
+	s.writeAttribute("Containers", QString::number(Layout.children().count()));
+	if (!CentralWidget.isEmpty())
+	{
+		s.writeAttribute("CentralWidget", CentralWidget);
+	}
+	Layout.writeState(s);
+	s.writeEndElement();
+	s.writeEndDocument();
 }
 
 
+/**
+ * Serializes, compresses and writes a layout snapshot into the autosave
+ * file. The snapshot is immutable, so the complete serialization runs in
+ * the autosave thread pool. The task reports the result back to the dock
+ * manager via a queued call.
+ */
+class CAutosaveTask : public QRunnable
+{
+public:
+	CAutosaveTask(CDockManager* DockManager, const CDockLayoutSnapshot& Snapshot,
+		const QString& CentralWidget, int Version, bool AutoFormatting,
+		const QString& FileName, bool Compress, quint64 Generation) :
+		DockManager(DockManager),
+		Snapshot(Snapshot),
+		CentralWidget(CentralWidget),
+		Version(Version),
+		AutoFormatting(AutoFormatting),
+		FileName(FileName),
+		Compress(Compress),
+		Generation(Generation)
+	{}
+
+	virtual void run() override
+	{
+		QSaveFile File(FileName);
+		bool Result = File.open(QIODevice::WriteOnly);
+		if (Result && Compress)
+		{
+			CDockingStateCompressor Compressor(&File);
+			Result = Compressor.open(QIODevice::WriteOnly) && writeState(&Compressor);
+			Compressor.close();
+			Result = Result && !Compressor.hasError();
+		}
+		else if (Result)
+		{
+			Result = writeState(&File);
+		}
+		Result = Result && File.commit();
+		QMetaObject::invokeMethod(DockManager, "onAutosaveFinished",
+			Qt::QueuedConnection, Q_ARG(quint64, Generation), Q_ARG(bool, Result));
+	}
+
+private:
+	/**
+	 * Writes the snapshot in the format of DockManagerPrivate::saveState()
+	 */
+	bool writeState(QIODevice* Device) const
+	{
+		QXmlStreamWriter s(Device);
+		s.setAutoFormatting(AutoFormatting);
+		writeLayoutState(s, Snapshot, Version, CentralWidget);
+		return !s.hasError();
+	}
+
+	CDockManager* DockManager;
+	CDockLayoutSnapshot Snapshot;
+	QString CentralWidget;
+	int Version;
+	bool AutoFormatting;
+	QString FileName;
+	bool Compress;
+	quint64 Generation;
+};
+
+
 //============================================================================
 void DockManagerPrivate::loadStylesheet()
 {
@@ -215,6 +474,180 @@ void DockManagerPrivate::loadStylesheet()
 }
 
 
+//============================================================================
+void DockManagerPrivate::scheduleFloatingWidgetPoolFill()
+{
+	if (FloatingWidgetPoolFillPending
+	 || FloatingWidgetPool.count() >= FloatingWidgetPoolSize)
+	{
+		return;
+	}
+
+	FloatingWidgetPoolFillPending = true;
+	QTimer::singleShot(0, _this, [this]{ fillFloatingWidgetPool(); });
+}
+
+
+//============================================================================
+void DockManagerPrivate::fillFloatingWidgetPool()
+{
+	FloatingWidgetPoolFillPending = false;
+	if (FloatingWidgetPool.count() >= FloatingWidgetPoolSize)
+	{
+		return;
+	}
+
+	// The floating widget registers itself in the constructor - the flag
+	// prevents that pooled floating widgets become visible to the rest
+	// of the docking system
+	FillingFloatingWidgetPool = true;
+	auto FloatingWidget = new CFloatingDockContainer(_this);
+	FillingFloatingWidgetPool = false;
+	FloatingWidget->resetForReuse();
+	// Create the native window now, because this is the expensive part
+	// we would like to save when the floating widget is reused
+	FloatingWidget->winId();
+	FloatingWidgetPool.append(FloatingWidget);
+	scheduleFloatingWidgetPoolFill();
+}
+
+
+//============================================================================
+void DockManagerPrivate::scheduleComponentRecycling()
+{
+	if (ComponentRecyclingPending)
+	{
+		return;
+	}
+
+	ComponentRecyclingPending = true;
+	QTimer::singleShot(0, _this, [this]{ recycleComponents(); });
+}
+
+
+//============================================================================
+void DockManagerPrivate::recycleComponents()
+{
+	ComponentRecyclingPending = false;
+	dropOutdatedComponents();
+	int PoolSize = CDockComponentsFactory::recyclingPoolSize();
+	for (auto DockArea : RecycledDockAreas)
+	{
+		if (!DockArea)
+		{
+			continue;
+		}
+
+		if (DockAreaPool.count() < PoolSize && DockArea->resetForReuse())
+		{
+			DockAreaPool.append(DockArea);
+		}
+		else
+		{
+			DockArea->deleteLater();
+		}
+	}
+	RecycledDockAreas.clear();
+
+	for (const auto& Recycled : RecycledAutoHideTabs)
+	{
+		auto Tab = Recycled.first.data();
+		if (!Tab)
+		{
+			continue;
+		}
+
+		if (AutoHideTabPool.count() < PoolSize && !Tab->parent())
+		{
+			// The dock widget is an auto hide widget as long as it has a
+			// side tab
+			auto DockWidget = Recycled.second.data();
+			if (DockWidget && DockWidget->sideTabWidget() == Tab)
+			{
+				DockWidget->setSideTabWidget(nullptr);
+			}
+			Tab->resetForReuse();
+			AutoHideTabPool.append(Tab);
+		}
+		else
+		{
+			Tab->deleteLater();
+		}
+	}
+	RecycledAutoHideTabs.clear();
+}
+
+
+//============================================================================
+void DockManagerPrivate::dropOutdatedComponents()
+{
+	int Revision = internal::componentsFactoryRevision();
+	if (Revision == ComponentsFactoryRevision)
+	{
+		return;
+	}
+
+	ComponentsFactoryRevision = Revision;
+	for (auto DockArea : DockAreaPool)
+	{
+		DockArea->deleteLater();
+	}
+	DockAreaPool.clear();
+	for (auto Tab : AutoHideTabPool)
+	{
+		Tab->deleteLater();
+	}
+	AutoHideTabPool.clear();
+}
+
+
+//============================================================================
+void DockManagerPrivate::registerDockWidget(CDockWidget* DockWidget)
+{
+	DockWidgetsMap.insert(DockWidget->objectName(), DockWidget);
+	if (dockWidgetFromHandle(DockWidget->handle()) == DockWidget)
+	{
+		return;
+	}
+
+	int Index;
+	if (FreeDockWidgetHandles.isEmpty())
+	{
+		Index = DockWidgetHandles.count();
+		Q_ASSERT(Index <= DockWidgetHandleIndexMask);
+		DockWidgetHandles.append(DockWidgetHandleSlot());
+	}
+	else
+	{
+		Index = FreeDockWidgetHandles.takeLast();
+	}
+
+	auto& Slot = DockWidgetHandles[Index];
+	Slot.Generation = (Slot.Generation + 1) & DockWidgetHandleGenerationMask;
+	Slot.Handle = (Slot.Generation << DockWidgetHandleIndexBits) | Index;
+	Slot.DockWidget = DockWidget;
+	DockWidget->setHandle(Slot.Handle);
+}
+
+
+//============================================================================
+void DockManagerPrivate::unregisterDockWidget(CDockWidget* DockWidget)
+{
+	DockWidgetsMap.remove(DockWidget->objectName());
+	int Handle = DockWidget->handle();
+	DockWidget->setHandle(-1);
+	if (dockWidgetFromHandle(Handle) != DockWidget)
+	{
+		return;
+	}
+
+	int Index = Handle & DockWidgetHandleIndexMask;
+	DockWidgetHandles[Index].DockWidget = nullptr;
+	DockWidgetHandles[Index].Handle = -1;
+	FreeDockWidgetHandles.append(Index);
+}
+
+
 //============================================================================
 bool DockManagerPrivate::restoreContainer(int Index, CDockingStateReader& stream, bool Testing)
 {
@@ -226,7 +659,7 @@ bool DockManagerPrivate::restoreContainer(int Index, CDockingStateReader& stream
 	bool Result = false;
 	if (Index >= Containers.count())
 	{
-		CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(_this);
+		CFloatingDockContainer* FloatingWidget = _this->takeFloatingWidget();
 		Result = FloatingWidget->restoreState(stream, Testing);
 	}
 	else
@@ -248,23 +681,33 @@ bool DockManagerPrivate::restoreContainer(int Index, CDockingStateReader& stream
 
 
 //============================================================================
-bool DockManagerPrivate::checkFormat(const QByteArray &state, int version)
+bool DockManagerPrivate::checkFormat(QIODevice* Device, int version)
 {
-    return restoreStateFromXml(state, version, internal::RestoreTesting);
+    return restoreStateFromXml(Device, version, internal::RestoreTesting);
 }
 
 
 //============================================================================
-bool DockManagerPrivate::restoreStateFromXml(const QByteArray &state,  int version,
+bool DockManagerPrivate::restoreStateFromXml(QIODevice* Device,  int version,
 	bool Testing)
 {
 	Q_UNUSED(version);
 
-    if (state.isEmpty())
+    if (Device->atEnd())
     {
         return false;
     }
-    CDockingStateReader s(state);
+
+    CDockingStateDecompressor Decompressor(Device);
+    if (CDockingStateCompressor::isCompressedStream(Device->peek(CDockingStateCompressor::headerSize())))
+    {
+    	if (!Decompressor.open(QIODevice::ReadOnly))
+    	{
+    		return false;
+    	}
+    	Device = &Decompressor;
+    }
+    CDockingStateReader s(Device);
     s.readNextStartElement();
     if (s.name() != QLatin1String("QtAdvancedDockingSystem"))
     {
@@ -333,14 +776,18 @@ bool DockManagerPrivate::restoreStateFromXml(const QByteArray &state,  int versi
 
     if (!Testing)
     {
-		// Delete remaining empty floating widgets
+		// Delete remaining empty floating widgets. Recycling a floating widget
+		// removes it from FloatingWidgets, so we iterate over a copy
 		int FloatingWidgetIndex = DockContainerCount - 1;
-		for (int i = FloatingWidgetIndex; i < FloatingWidgets.count(); ++i)
+		const auto RemainingFloatingWidgets = FloatingWidgets.mid(FloatingWidgetIndex);
+		for (auto floatingWidget : RemainingFloatingWidgets)
 		{
-			CFloatingDockContainer* floatingWidget = FloatingWidgets[i];
 			if (!floatingWidget) continue;
 			_this->removeDockContainer(floatingWidget->dockContainer());
-			floatingWidget->deleteLater();
+			if (!_this->recycleFloatingWidget(floatingWidget))
+			{
+				floatingWidget->deleteLater();
+			}
 		}
     }
 
@@ -389,12 +836,9 @@ void DockManagerPrivate::restoreDockAreasIndices()
     	for (int i = 0; i < DockContainer->dockAreaCount(); ++i)
     	{
     		CDockAreaWidget* DockArea = DockContainer->dockArea(i);
-    		QString DockWidgetName = DockArea->property("currentDockWidget").toString();
-    		CDockWidget* DockWidget = nullptr;
-    		if (!DockWidgetName.isEmpty())
-    		{
-    			DockWidget = _this->findDockWidget(DockWidgetName);
-    		}
+    		bool Ok;
+    		int Handle = DockArea->property("currentDockWidget").toInt(&Ok);
+    		CDockWidget* DockWidget = Ok ? dockWidgetFromHandle(Handle) : nullptr;
 
     		if (!DockWidget || DockWidget->isClosed())
     		{
@@ -441,27 +885,64 @@ void DockManagerPrivate::emitTopLevelEvents()
 
 
 //============================================================================
-bool DockManagerPrivate::restoreState(const QByteArray& State, int version)
+bool DockManagerPrivate::restoreState(QIODevice* Device, int version)
+{
+	// Uncompressed and chunk compressed data can be read directly from
+	// random access devices. Restoring needs two passes over the data, so
+	// sequential devices are read into memory. Data compressed with
+	// qCompress() can only be decompressed as a whole.
+	const QByteArray Header = Device->peek(qMax(5, CDockingStateCompressor::headerSize()));
+	const bool Streamable = Header.startsWith("<?xml")
+		|| CDockingStateCompressor::isCompressedStream(Header);
+	if (Streamable && !Device->isSequential())
+	{
+		return restoreStateFromDevice(Device, version);
+	}
+
+	QBuffer Buffer;
+	Buffer.setData(Streamable ? Device->readAll() : qUncompress(Device->readAll()));
+	Buffer.open(QIODevice::ReadOnly);
+	return restoreStateFromDevice(&Buffer, version);
+}
+
+
+//============================================================================
+bool DockManagerPrivate::restoreStateFromDevice(QIODevice* Device, int version)
 {
-	QByteArray state = State.startsWith("<?xml") ? State : qUncompress(State);
-    if (!checkFormat(state, version))
+	const qint64 StartPos = Device->pos();
+    if (!checkFormat(Device, version))
     {
         ADS_PRINT("checkFormat: Error checking format!!!!!!!");
     	return false;
     }
 
+    if (!Device->seek(StartPos))
+    {
+    	return false;
+    }
+
     // Hide updates of floating widgets from use
     hideFloatingWidgets();
     markDockWidgetsDirty();
 
-    if (!restoreStateFromXml(state, version))
+    if (!restoreStateFromXml(Device, version))
     {
         ADS_PRINT("restoreState: Error restoring state!!!!!!!");
+        for (auto Container : Containers)
+        {
+        	Container->discardRestoredSplitterSizes();
+        }
     	return false;
     }
 
     restoreDockWidgetsOpenState();
     restoreDockAreasIndices();
+    // The visibility of all dock areas is known now, so the final splitter
+    // geometry can be computed and applied in one single pass
+    for (auto Container : Containers)
+    {
+    	Container->applyRestoredSplitterSizes();
+    }
     emitTopLevelEvents();
     _this->dumpLayout();
 
@@ -511,15 +992,14 @@ CDockManager::CDockManager(QWidget *parent) :
 	}
 
 	d->ViewMenu = new QMenu(tr("Show View"), this);
-	d->ContainerOverlay = new CDockOverlay(this, CDockOverlay::ModeContainerOverlay);
-    d->DockAreaOverlay = d->ContainerOverlay; // todo: do properly:   new CDockOverlay(this, CDockOverlay::ModeContainerOverlay); // ModeDockAreaOverlay
 	d->Containers.append(this);
+	d->trackLayoutChanges(this);
 	d->loadStylesheet();
+	d->applyConfigFlags();
 
-	if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
-	{
-		d->FocusController = new CDockFocusController(this);
-	}
+	// The command queue is created here and not on first use, because it
+	// is accessed from worker threads
+	d->CommandQueue = new CDockCommandQueue(this);
 
 
 	window()->installEventFilter(this);
@@ -540,6 +1020,16 @@ CDockManager::CDockManager(QWidget *parent) :
 //============================================================================
 CDockManager::~CDockManager()
 {
+	// Stop occlusion tracking before the widgets are deleted
+	delete d->OcclusionTracker;
+	d->OcclusionTracker = nullptr;
+	delete d->DockWidgetIndex;
+	d->DockWidgetIndex = nullptr;
+
+	// Stop autosaving and wait for a running autosave task
+	d->AutosaveFileName.clear();
+	d->AutosaveThreadPool.waitForDone();
+
     // fix memory leaks, see https://github.com/githubuser0xFFFF/Qt-Advanced-Docking-System/issues/307
 	std::vector<QPointer<ads::CDockAreaWidget>> areas;
 	for (int i = 0; i != dockAreaCount(); ++i)
@@ -569,6 +1059,20 @@ CDockManager::~CDockManager()
 		FloatingWidget->deleteContent();
 		delete FloatingWidget;
 	}
+	qDeleteAll(d->FloatingWidgetPool);
+	d->FloatingWidgetPool.clear();
+
+	// Pooled and recycled components do not have a parent
+	qDeleteAll(d->DockAreaPool);
+	qDeleteAll(d->AutoHideTabPool);
+	for (auto DockArea : d->RecycledDockAreas)
+	{
+		delete DockArea.data();
+	}
+	for (const auto& Recycled : d->RecycledAutoHideTabs)
+	{
+		delete Recycled.first.data();
+	}
 
 	// Delete Dock Widgets before Areas so widgets can access them late (like dtor)
 	for ( auto area : areas )
@@ -583,52 +1087,49 @@ CDockManager::~CDockManager()
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
 bool CDockManager::eventFilter(QObject *obj, QEvent *e)
 {
+	// Floating widgets are filtered to track their geometry for autosave
+	// and their visibility for the stacking manager. The window of the dock
+	// manager may be a floating widget itself, so it is handled below, too.
+	auto FloatingWidget = qobject_cast<CFloatingDockContainer*>(obj);
+	if (FloatingWidget)
+	{
+		if (e->type() == QEvent::Move || e->type() == QEvent::Resize)
+		{
+			markLayoutDirty();
+		}
+		else if (e->type() == QEvent::Hide)
+		{
+			d->StackingManager.floatingWidgetHidden(FloatingWidget);
+		}
+	}
+
+	if (obj != window())
+	{
+		return Super::eventFilter(obj, e);
+	}
+
 	// Emulate Qt:Tool behaviour.
 	// Required because on some WMs Tool windows can't be maximized.
 
 	// Window always on top of the MainWindow.
-	if (e->type() == QEvent::WindowActivate)
-	{
-        for (auto _window : d->FloatingWidgets)
-		{
-			if (!_window->isVisible() || window()->isMinimized())
-			{
-				continue;
-			}
-			// setWindowFlags(Qt::WindowStaysOnTopHint) will hide the window and thus requires a show call.
-			// This then leads to flickering and a nasty endless loop (also buggy behaviour on Ubuntu).
-			// So we just do it ourself.
-            if(QGuiApplication::platformName() == QLatin1String("xcb"))
-			{
-				internal::xcb_update_prop(true, _window->window()->winId(),
-                    "_NET_WM_STATE", "_NET_WM_STATE_ABOVE", "_NET_WM_STATE_STAYS_ON_TOP");
-			}
-			else
-			{
-                    _window->setWindowFlag(Qt::WindowStaysOnTopHint, true);
-			}
-        }
-	}
-	else if (e->type() == QEvent::WindowDeactivate)
+	// setWindowFlags(Qt::WindowStaysOnTopHint) will hide the window and thus requires a show call.
+	// This then leads to flickering and a nasty endless loop (also buggy behaviour on Ubuntu).
+	// So we just do it ourself. The stacking manager only sends the required
+	// state transitions and flushes them in one batch.
+	if (e->type() == QEvent::WindowActivate || e->type() == QEvent::WindowDeactivate)
 	{
-        for (auto _window : d->FloatingWidgets)
+		const bool Above = (e->type() == QEvent::WindowActivate);
+		if (!window()->isMinimized())
 		{
-			if (!_window->isVisible() || window()->isMinimized())
-			{
-				continue;
-			}
-
-            if(QGuiApplication::platformName() == QLatin1String("xcb"))
-			{
-				internal::xcb_update_prop(false, _window->window()->winId(),
-                    "_NET_WM_STATE", "_NET_WM_STATE_ABOVE", "_NET_WM_STATE_STAYS_ON_TOP");
-			}
-            else
+			for (auto _window : d->FloatingWidgets)
 			{
-				_window->setWindowFlag(Qt::WindowStaysOnTopHint, false);
+				if (_window && _window->isVisible())
+				{
+					d->StackingManager.requestAbove(_window, Above);
+				}
 			}
-			_window->raise();
 		}
+		d->StackingManager.flush();
 	}
 
 	// Sync minimize with MainWindow
@@ -661,6 +1162,20 @@ bool CDockManager::eventFilter(QObject *obj, QEvent *e)
 //============================================================================
 bool CDockManager::eventFilter(QObject *obj, QEvent *e)
 {
+	// Floating widgets are filtered to track their geometry for autosave.
+	// The window of the dock manager may be a floating widget itself, so it
+	// is handled below, too.
+	if ((e->type() == QEvent::Move || e->type() == QEvent::Resize)
+	 && qobject_cast<CFloatingDockContainer*>(obj))
+	{
+		markLayoutDirty();
+	}
+
+	if (obj != window())
+	{
+		return Super::eventFilter(obj, e);
+	}
+
 	if (e->type() == QEvent::WindowStateChange)
 	{
 		QWindowStateChangeEvent* ev = static_cast<QWindowStateChangeEvent*>(e);
@@ -693,7 +1208,14 @@ bool CDockManager::isLeavingMinimizedState() const
 //============================================================================
 void CDockManager::registerFloatingWidget(CFloatingDockContainer* FloatingWidget)
 {
+	if (d->FillingFloatingWidgetPool)
+	{
+		return;
+	}
+
 	d->FloatingWidgets.append(FloatingWidget);
+	// Track geometry changes of the floating widget for autosave
+	FloatingWidget->installEventFilter(this);
 	Q_EMIT floatingWidgetCreated(FloatingWidget);
     ADS_PRINT("d->FloatingWidgets.count() " << d->FloatingWidgets.count());
 }
@@ -703,14 +1225,23 @@ void CDockManager::registerFloatingWidget(CFloatingDockContainer* FloatingWidget
 void CDockManager::removeFloatingWidget(CFloatingDockContainer* FloatingWidget)
 {
 	d->FloatingWidgets.removeAll(FloatingWidget);
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+	d->StackingManager.removeFloatingWidget(FloatingWidget);
+#endif
 }
 
 //============================================================================
 void CDockManager::registerDockContainer(CDockContainerWidget* DockContainer)
 {
-	d->Containers.append(DockContainer);
-}
-
+	if (d->FillingFloatingWidgetPool)
+	{
+		return;
+	}
+
+	d->Containers.append(DockContainer);
+	d->trackLayoutChanges(DockContainer);
+}
+
 
 //============================================================================
 void CDockManager::removeDockContainer(CDockContainerWidget* DockContainer)
@@ -722,9 +1253,170 @@ void CDockManager::removeDockContainer(CDockContainerWidget* DockContainer)
 }
 
 
+//============================================================================
+CFloatingDockContainer* CDockManager::takeFloatingWidget()
+{
+	if (d->FloatingWidgetPool.isEmpty())
+	{
+		return new CFloatingDockContainer(this);
+	}
+
+	auto FloatingWidget = d->FloatingWidgetPool.takeLast();
+	FloatingWidget->prepareReuse();
+	registerDockContainer(FloatingWidget->dockContainer());
+	registerFloatingWidget(FloatingWidget);
+	d->scheduleFloatingWidgetPoolFill();
+	return FloatingWidget;
+}
+
+
+//============================================================================
+bool CDockManager::recycleFloatingWidget(CFloatingDockContainer* FloatingWidget)
+{
+	if (!FloatingWidget
+	 || d->FloatingWidgetPool.count() >= d->FloatingWidgetPoolSize
+	 || d->FloatingWidgetPool.contains(FloatingWidget))
+	{
+		return false;
+	}
+
+	// Auto hide widgets are not transferred when a floating widget is
+	// dropped, so a floating widget that still has some can not be reused
+	if (!FloatingWidget->dockContainer()->autoHideWidgets().isEmpty())
+	{
+		return false;
+	}
+
+	removeFloatingWidget(FloatingWidget);
+	removeDockContainer(FloatingWidget->dockContainer());
+	d->HiddenFloatingWidgets.removeAll(FloatingWidget);
+	d->UninitializedFloatingWidgets.removeAll(FloatingWidget);
+	FloatingWidget->resetForReuse();
+	d->FloatingWidgetPool.append(FloatingWidget);
+	return true;
+}
+
+
+//============================================================================
+CDockAreaWidget* CDockManager::takeDockArea(CDockContainerWidget* Parent)
+{
+	d->dropOutdatedComponents();
+	if (d->DockAreaPool.isEmpty())
+	{
+		return new CDockAreaWidget(this, Parent);
+	}
+
+	auto DockArea = d->DockAreaPool.takeLast();
+	DockArea->prepareReuse(Parent);
+	return DockArea;
+}
+
+
+//============================================================================
+bool CDockManager::recycleDockArea(CDockAreaWidget* DockArea)
+{
+	if (!DockArea
+	 || CDockComponentsFactory::recyclingPoolSize() <= 0
+	 || DockArea->dockManager() != this
+	 || DockArea->isAutoHide())
+	{
+		return false;
+	}
+
+	// The dock area is reset later, but it should not be found as a child
+	// of its former parent anymore
+	DockArea->setParent(nullptr);
+	d->RecycledDockAreas.append(DockArea);
+	d->scheduleComponentRecycling();
+	return true;
+}
+
+
+//============================================================================
+CAutoHideTab* CDockManager::takeAutoHideTab()
+{
+	d->dropOutdatedComponents();
+	if (d->AutoHideTabPool.isEmpty())
+	{
+		return componentsFactory()->createDockWidgetSideTab(nullptr);
+	}
+
+	return d->AutoHideTabPool.takeLast();
+}
+
+
+//============================================================================
+bool CDockManager::recycleAutoHideTab(CAutoHideTab* Tab)
+{
+	if (!Tab || CDockComponentsFactory::recyclingPoolSize() <= 0)
+	{
+		return false;
+	}
+
+	d->RecycledAutoHideTabs.append(qMakePair(QPointer<CAutoHideTab>(Tab),
+		QPointer<CDockWidget>(Tab->dockWidget())));
+	d->scheduleComponentRecycling();
+	return true;
+}
+
+
+//============================================================================
+void CDockManager::setFloatingWidgetPoolSize(int Size)
+{
+	d->FloatingWidgetPoolSize = qMax(0, Size);
+	while (d->FloatingWidgetPool.count() > d->FloatingWidgetPoolSize)
+	{
+		d->FloatingWidgetPool.takeLast()->deleteLater();
+	}
+	d->scheduleFloatingWidgetPoolFill();
+}
+
+
+//============================================================================
+int CDockManager::floatingWidgetPoolSize() const
+{
+	return d->FloatingWidgetPoolSize;
+}
+
+
+//============================================================================
+void DockManagerPrivate::createOverlays()
+{
+	if (ContainerOverlay)
+	{
+		return;
+	}
+
+	ContainerOverlay = new CDockOverlay(_this, CDockOverlay::ModeContainerOverlay);
+    DockAreaOverlay = ContainerOverlay; // todo: do properly:   new CDockOverlay(this, CDockOverlay::ModeContainerOverlay); // ModeDockAreaOverlay
+}
+
+
+//============================================================================
+void DockManagerPrivate::applyConfigFlags()
+{
+	bool FocusHighlighting = _this->testManagerConfigFlag(CDockManager::FocusHighlighting);
+	if (!FocusController && FocusHighlighting)
+	{
+		FocusController = new CDockFocusController(_this);
+	}
+	else if (FocusController && !FocusHighlighting)
+	{
+		FocusController->deleteLater();
+		FocusController = nullptr;
+	}
+
+	for (auto Container : Containers)
+	{
+		Container->createSideTabBarWidgets();
+	}
+}
+
+
 //============================================================================
 CDockOverlay* CDockManager::containerOverlay() const
 {
+	d->createOverlays();
 	return d->ContainerOverlay;
 }
 
@@ -732,6 +1424,7 @@ CDockOverlay* CDockManager::containerOverlay() const
 //============================================================================
 CDockOverlay* CDockManager::dockAreaOverlay() const
 {
+	d->createOverlays();
 	return d->DockAreaOverlay;
 }
 
@@ -762,37 +1455,60 @@ unsigned int CDockManager::zOrderIndex() const
 }
 
 
+//============================================================================
+void DockManagerPrivate::saveState(QXmlStreamWriter& s, int version) const
+{
+	s.setAutoFormatting(_this->testManagerConfigFlag(CDockManager::XmlAutoFormattingEnabled));
+	writeLayoutState(s, _this->layoutSnapshot(), version,
+		CentralWidget ? CentralWidget->objectName() : QString());
+}
+
+
 //============================================================================
 QByteArray CDockManager::saveState(int version) const
 {
     QByteArray xmldata;
     QXmlStreamWriter s(&xmldata);
-    auto ConfigFlags = CDockManager::configFlags();
-	s.setAutoFormatting(ConfigFlags.testFlag(XmlAutoFormattingEnabled));
-    s.writeStartDocument();
-		s.writeStartElement("QtAdvancedDockingSystem");
-		s.writeAttribute("Version", QString::number(CurrentVersion));
-		s.writeAttribute("UserVersion", QString::number(version));
-		s.writeAttribute("Containers", QString::number(d->Containers.count()));
-		if (d->CentralWidget)
-		{
-			s.writeAttribute("CentralWidget", d->CentralWidget->objectName());
-		}
-		for (auto Container : d->Containers)
-		{
-			Container->saveState(s);
-		}
+    d->saveState(s, version);
+    return testManagerConfigFlag(XmlCompressionEnabled)
+    	? qCompress(xmldata, 9) : xmldata;
+}
 
-		s.writeEndElement();
-    s.writeEndDocument();
 
-    return ConfigFlags.testFlag(XmlCompressionEnabled)
-    	? qCompress(xmldata, 9) : xmldata;
+//============================================================================
+bool CDockManager::saveState(QIODevice* Device, int version) const
+{
+	if (!testManagerConfigFlag(XmlCompressionEnabled))
+	{
+		QXmlStreamWriter s(Device);
+		d->saveState(s, version);
+		return !s.hasError();
+	}
+
+	CDockingStateCompressor Compressor(Device);
+	if (!Compressor.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+	QXmlStreamWriter s(&Compressor);
+	d->saveState(s, version);
+	Compressor.close();
+	return !s.hasError() && !Compressor.hasError();
 }
 
 
 //============================================================================
 bool CDockManager::restoreState(const QByteArray &state, int version)
+{
+	QBuffer Buffer;
+	Buffer.setData(state);
+	Buffer.open(QIODevice::ReadOnly);
+	return restoreState(&Buffer, version);
+}
+
+
+//============================================================================
+bool CDockManager::restoreState(QIODevice* Device, int version)
 {
 	// Prevent multiple calls as long as state is not restore. This may
 	// happen, if QApplication::processEvents() is called somewhere
@@ -816,7 +1532,7 @@ bool CDockManager::restoreState(const QByteArray &state, int version)
 	}
 	d->RestoringState = true;
 	Q_EMIT restoringState();
-	bool Result = d->restoreState(state, version);
+	bool Result = d->restoreState(Device, version);
 	d->RestoringState = false;
 	if (!IsHidden)
 	{
@@ -830,7 +1546,7 @@ bool CDockManager::restoreState(const QByteArray &state, int version)
 //============================================================================
 CFloatingDockContainer* CDockManager::addDockWidgetFloating(CDockWidget* Dockwidget)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
+	d->registerDockWidget(Dockwidget);
 	CDockAreaWidget* OldDockArea = Dockwidget->dockAreaWidget();
 	if (OldDockArea)
 	{
@@ -838,7 +1554,7 @@ CFloatingDockContainer* CDockManager::addDockWidgetFloating(CDockWidget* Dockwid
 	}
 
 	Dockwidget->setDockManager(this);
-	CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(Dockwidget);
+	CFloatingDockContainer* FloatingWidget = CFloatingDockContainer::create(Dockwidget);
 	FloatingWidget->resize(Dockwidget->size());
 	if (isVisible())
 	{
@@ -897,7 +1613,7 @@ void CDockManager::restoreHiddenFloatingWidgets()
 		// it here for now to make sure changes to fix Issue #380 does not impact existing behaviours
 		for (auto dockWidget : FloatingWidget->dockWidgets())
 		{
-			if (dockWidget->toggleViewAction()->isChecked())
+			if (dockWidget->isToggleViewActionChecked())
 			{
 				dockWidget->toggleView(true);
 				hasDockWidgetVisible = true;
@@ -917,7 +1633,7 @@ void CDockManager::restoreHiddenFloatingWidgets()
 CDockAreaWidget* CDockManager::addDockWidget(DockWidgetArea area,
 	CDockWidget* Dockwidget, CDockAreaWidget* DockAreaWidget, int Index)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
+	d->registerDockWidget(Dockwidget);
 	auto Container = DockAreaWidget ? DockAreaWidget->dockContainer() : this;
 	auto AreaOfAddedDockWidget = Container->addDockWidget(area, Dockwidget, DockAreaWidget, Index);
 	Q_EMIT dockWidgetAdded(Dockwidget);
@@ -928,7 +1644,7 @@ CDockAreaWidget* CDockManager::addDockWidget(DockWidgetArea area,
 CDockAreaWidget* CDockManager::addDockWidgetToContainer(DockWidgetArea area,
 	CDockWidget* Dockwidget, CDockContainerWidget* DockContainerWidget)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
+	d->registerDockWidget(Dockwidget);
 	auto AreaOfAddedDockWidget = DockContainerWidget->addDockWidget(area, Dockwidget);
 	Q_EMIT dockWidgetAdded(Dockwidget);
 	return AreaOfAddedDockWidget;
@@ -944,7 +1660,7 @@ CAutoHideDockContainer* CDockManager::addAutoHideDockWidget(SideBarLocation area
 CAutoHideDockContainer* CDockManager::addAutoHideDockWidgetToContainer(SideBarLocation area, CDockWidget* Dockwidget,
 	CDockContainerWidget* DockContainerWidget)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
+	d->registerDockWidget(Dockwidget);
 	auto container = DockContainerWidget->createAndSetupAutoHideContainer(area, Dockwidget);
 	container->collapseView(true);
 
@@ -983,11 +1699,18 @@ CDockWidget* CDockManager::findDockWidget(const QString& ObjectName) const
 	return d->DockWidgetsMap.value(ObjectName, nullptr);
 }
 
+
+//============================================================================
+CDockWidget* CDockManager::findDockWidget(int Handle) const
+{
+	return d->dockWidgetFromHandle(Handle);
+}
+
 //============================================================================
 void CDockManager::removeDockWidget(CDockWidget* Dockwidget)
 {
 	Q_EMIT dockWidgetAboutToBeRemoved(Dockwidget);
-	d->DockWidgetsMap.remove(Dockwidget->objectName());
+	d->unregisterDockWidget(Dockwidget);
 	CDockContainerWidget::removeDockWidget(Dockwidget);
 	Dockwidget->setDockManager(nullptr);
 	Q_EMIT dockWidgetRemoved(Dockwidget);
@@ -1000,10 +1723,107 @@ QMap<QString, CDockWidget*> CDockManager::dockWidgetsMap() const
 }
 
 
+//============================================================================
+/**
+ * Reads the shared perspective subtrees from the PerspectiveSubtrees group
+ */
+static QMap<QByteArray, QByteArray> readPerspectiveSubtrees(QSettings& Settings)
+{
+	QMap<QByteArray, QByteArray> Subtrees;
+	Settings.beginGroup("PerspectiveSubtrees");
+	const auto Keys = Settings.childKeys();
+	for (const auto& Key : Keys)
+	{
+		Subtrees.insert(Key.toLatin1(), Settings.value(Key).toByteArray());
+	}
+	Settings.endGroup();
+	return Subtrees;
+}
+
+
+//============================================================================
+/**
+ * Writes the shared perspective subtrees into the PerspectiveSubtrees group.
+ * Subtrees are keyed by the hash of their content, so only subtrees that
+ * are not stored yet are written and subtrees that are not used anymore
+ * are removed.
+ */
+static void writePerspectiveSubtrees(QSettings& Settings,
+	const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	Settings.beginGroup("PerspectiveSubtrees");
+	QSet<QString> Stored;
+	const auto Keys = Settings.childKeys();
+	for (const auto& Key : Keys)
+	{
+		if (Subtrees.contains(Key.toLatin1()))
+		{
+			Stored.insert(Key);
+		}
+		else
+		{
+			Settings.remove(Key);
+		}
+	}
+	const auto Groups = Settings.childGroups();
+	for (const auto& Group : Groups)
+	{
+		Settings.remove(Group);
+	}
+
+	for (auto it = Subtrees.constBegin(); it != Subtrees.constEnd(); ++it)
+	{
+		auto Key = QString::fromLatin1(it.key());
+		if (!Stored.contains(Key))
+		{
+			Settings.setValue(Key, it.value());
+		}
+	}
+	Settings.endGroup();
+}
+
+
 //============================================================================
 void CDockManager::addPerspective(const QString& UniquePrespectiveName)
 {
-	d->Perspectives.insert(UniquePrespectiveName, saveState());
+	if (d->PerspectiveLibrary)
+	{
+		QByteArray State = saveState();
+		QMap<QByteArray, QByteArray> Subtrees;
+		if (testManagerConfigFlag(PerspectiveDeduplication))
+		{
+			// The library stores each subtree only once, so only subtrees
+			// that are new in this perspective are written
+			CLayoutSubtreeStore Store;
+			QByteArray Document = Store.insert(State);
+			if (!Document.isEmpty())
+			{
+				State = Document;
+				Subtrees = Store.subtrees();
+			}
+		}
+		d->PerspectiveLibrary->setState(UniquePrespectiveName, State, Subtrees);
+	}
+	else
+	{
+		QByteArray State = saveState();
+		if (testManagerConfigFlag(PerspectiveDeduplication))
+		{
+			// Insert before releasing the old perspective, to keep subtrees
+			// that are shared with the old perspective
+			QByteArray Document = d->PerspectiveSubtrees.insert(State);
+			if (!Document.isEmpty())
+			{
+				State = Document;
+			}
+		}
+		QByteArray OldState = d->Perspectives.value(UniquePrespectiveName);
+		if (CLayoutSubtreeStore::isReferenceDocument(OldState))
+		{
+			d->PerspectiveSubtrees.release(OldState);
+		}
+		d->Perspectives.insert(UniquePrespectiveName, State);
+	}
 	Q_EMIT perspectiveListChanged();
 }
 
@@ -1019,9 +1839,26 @@ void CDockManager::removePerspective(const QString& Name)
 void CDockManager::removePerspectives(const QStringList& Names)
 {
 	int Count = 0;
-	for (const auto& Name : Names)
+	if (d->PerspectiveLibrary)
+	{
+		Count = d->PerspectiveLibrary->remove(Names);
+	}
+	else
 	{
-		Count += d->Perspectives.remove(Name);
+		for (const auto& Name : Names)
+		{
+			auto it = d->Perspectives.find(Name);
+			if (it == d->Perspectives.end())
+			{
+				continue;
+			}
+			if (CLayoutSubtreeStore::isReferenceDocument(it.value()))
+			{
+				d->PerspectiveSubtrees.release(it.value());
+			}
+			d->Perspectives.erase(it);
+			++Count;
+		}
 	}
 
 	if (Count)
@@ -1035,21 +1872,43 @@ void CDockManager::removePerspectives(const QStringList& Names)
 //============================================================================
 QStringList CDockManager::perspectiveNames() const
 {
-	return d->Perspectives.keys();
+	return d->PerspectiveLibrary ? d->PerspectiveLibrary->names()
+		: d->Perspectives.keys();
 }
 
 
 //============================================================================
 void CDockManager::openPerspective(const QString& PerspectiveName)
 {
-	const auto Iterator = d->Perspectives.find(PerspectiveName);
-	if (d->Perspectives.end() == Iterator)
+	QByteArray State;
+	if (d->PerspectiveLibrary)
+	{
+		auto Library = d->PerspectiveLibrary;
+		State = Library->state(PerspectiveName);
+		if (CLayoutSubtreeStore::isReferenceDocument(State))
+		{
+			State = CLayoutSubtreeStore::resolve(State, [Library](const QByteArray& Hash)
+				{
+					return Library->subtree(Hash);
+				});
+		}
+	}
+	else
+	{
+		State = d->Perspectives.value(PerspectiveName);
+		if (CLayoutSubtreeStore::isReferenceDocument(State))
+		{
+			State = d->PerspectiveSubtrees.resolve(State);
+		}
+	}
+
+	if (State.isEmpty())
 	{
 		return;
 	}
 
 	Q_EMIT openingPerspective(PerspectiveName);
-	restoreState(Iterator.value());
+	restoreState(State);
 	Q_EMIT perspectiveOpened(PerspectiveName);
 }
 
@@ -1057,6 +1916,22 @@ void CDockManager::openPerspective(const QString& PerspectiveName)
 //============================================================================
 void CDockManager::savePerspectives(QSettings& Settings) const
 {
+	if (d->PerspectiveLibrary)
+	{
+		const auto Names = d->PerspectiveLibrary->names();
+		Settings.beginWriteArray("Perspectives", Names.size());
+		for (int i = 0; i < Names.size(); ++i)
+		{
+			Settings.setArrayIndex(i);
+			Settings.setValue("Name", Names[i]);
+			Settings.setValue("State", d->PerspectiveLibrary->state(Names[i]));
+		}
+		Settings.endArray();
+		writePerspectiveSubtrees(Settings, d->PerspectiveLibrary->subtrees());
+		return;
+	}
+
+	writePerspectiveSubtrees(Settings, d->PerspectiveSubtrees.subtrees());
 	Settings.beginWriteArray("Perspectives", d->Perspectives.size());
 	int i = 0;
 	for (auto it = d->Perspectives.constBegin(); it != d->Perspectives.constEnd(); ++it)
@@ -1073,14 +1948,28 @@ void CDockManager::savePerspectives(QSettings& Settings) const
 //============================================================================
 void CDockManager::loadPerspectives(QSettings& Settings)
 {
-	d->Perspectives.clear();
+	// Settings without perspectives must not wipe the persistent library
 	int Size = Settings.beginReadArray("Perspectives");
+	Settings.endArray();
+	if (!Size && d->PerspectiveLibrary)
+	{
+		return;
+	}
+
+	d->Perspectives.clear();
 	if (!Size)
 	{
-		Settings.endArray();
+		d->PerspectiveSubtrees.clear();
 		return;
 	}
 
+	const auto Subtrees = readPerspectiveSubtrees(Settings);
+	if (!d->PerspectiveLibrary)
+	{
+		d->PerspectiveSubtrees.restoreSubtrees(Subtrees);
+	}
+
+	Settings.beginReadArray("Perspectives");
 	for (int i = 0; i < Size; ++i)
 	{
 		Settings.setArrayIndex(i);
@@ -1091,15 +1980,220 @@ void CDockManager::loadPerspectives(QSettings& Settings)
 			continue;
 		}
 
+		if (!d->PerspectiveLibrary && CLayoutSubtreeStore::isReferenceDocument(Data))
+		{
+			d->PerspectiveSubtrees.acquire(Data);
+		}
 		d->Perspectives.insert(Name, Data);
 	}
 
 	Settings.endArray();
+	if (d->PerspectiveLibrary)
+	{
+		// Replace the library content only after the settings have been read.
+		// Import all perspectives and their subtrees with one single index
+		// update - subtrees that are already in the library are not written
+		d->PerspectiveLibrary->replaceStates(d->Perspectives, Subtrees);
+		d->Perspectives.clear();
+	}
+	else
+	{
+		d->PerspectiveSubtrees.removeUnreferenced();
+	}
 	Q_EMIT perspectiveListChanged();
 	Q_EMIT perspectiveListLoaded();
 }
 
 
+//============================================================================
+void CDockManager::setPerspectiveLibrary(CPerspectiveLibrary* Library)
+{
+	if (d->PerspectiveLibrary == Library)
+	{
+		return;
+	}
+
+	d->PerspectiveLibrary = Library;
+	Q_EMIT perspectiveListChanged();
+	Q_EMIT perspectiveListLoaded();
+}
+
+
+//============================================================================
+CPerspectiveLibrary* CDockManager::perspectiveLibrary() const
+{
+	return d->PerspectiveLibrary;
+}
+
+
+//============================================================================
+CDockCommandQueue* CDockManager::commandQueue() const
+{
+	return d->CommandQueue;
+}
+
+
+//============================================================================
+CDockOcclusionTracker* CDockManager::occlusionTracker()
+{
+	if (!d->OcclusionTracker)
+	{
+		d->OcclusionTracker = new CDockOcclusionTracker(this);
+	}
+	return d->OcclusionTracker;
+}
+
+
+//============================================================================
+CDockWidgetIndex* CDockManager::dockWidgetIndex()
+{
+	if (!d->DockWidgetIndex)
+	{
+		d->DockWidgetIndex = new CDockWidgetIndex(this);
+	}
+	return d->DockWidgetIndex;
+}
+
+
+//============================================================================
+CDockMemoryUsage CDockManager::memoryUsage() const
+{
+	return CDockMemoryUsage::collect(this);
+}
+
+
+//============================================================================
+CDockLayoutSnapshot CDockManager::layoutSnapshot() const
+{
+	QVector<CDockLayoutSnapshot> Containers;
+	Containers.reserve(d->Containers.count());
+	for (auto Container : d->Containers)
+	{
+		Containers.append(Container->layoutSnapshot());
+	}
+	return CDockLayoutSnapshot::createLayout(Containers);
+}
+
+
+//============================================================================
+quint64 CDockManager::layoutGeneration() const
+{
+	return d->LayoutGeneration;
+}
+
+
+//============================================================================
+void CDockManager::setAutosaveFile(const QString& FileName, int version)
+{
+	d->AutosaveFileName = FileName;
+	d->AutosaveVersion = version;
+	if (FileName.isEmpty())
+	{
+		if (d->AutosaveTimer)
+		{
+			d->AutosaveTimer->stop();
+		}
+		return;
+	}
+
+	if (!d->AutosaveTimer)
+	{
+		d->AutosaveTimer = new QTimer(this);
+		d->AutosaveTimer->setSingleShot(true);
+		d->AutosaveTimer->setInterval(d->AutosaveInterval);
+		connect(d->AutosaveTimer, &QTimer::timeout, this, &CDockManager::autosave);
+	}
+
+	if (d->LayoutGeneration != d->AutosavedGeneration)
+	{
+		d->AutosaveTimer->start();
+	}
+}
+
+
+//============================================================================
+QString CDockManager::autosaveFile() const
+{
+	return d->AutosaveFileName;
+}
+
+
+//============================================================================
+void CDockManager::setAutosaveInterval(int Interval)
+{
+	d->AutosaveInterval = Interval;
+	if (d->AutosaveTimer)
+	{
+		d->AutosaveTimer->setInterval(Interval);
+	}
+}
+
+
+//============================================================================
+int CDockManager::autosaveInterval() const
+{
+	return d->AutosaveInterval;
+}
+
+
+//============================================================================
+void CDockManager::markLayoutDirty()
+{
+	++d->LayoutGeneration;
+	if (d->AutosaveTimer && !d->AutosaveFileName.isEmpty()
+	 && !d->AutosaveTimer->isActive())
+	{
+		d->AutosaveTimer->start();
+	}
+}
+
+
+//============================================================================
+void CDockManager::autosave()
+{
+	if (d->AutosaveFileName.isEmpty() || d->AutosaveRunning
+	 || d->LayoutGeneration == d->AutosavedGeneration)
+	{
+		return;
+	}
+
+	if (d->RestoringState)
+	{
+		d->AutosaveTimer->start();
+		return;
+	}
+
+	// The GUI thread only captures the immutable layout snapshot. The
+	// snapshot can be read from any thread, so the XML serialization,
+	// compression and writing runs in the worker thread.
+	d->AutosaveRunning = true;
+	d->AutosaveThreadPool.start(new CAutosaveTask(this, layoutSnapshot(),
+		d->CentralWidget ? d->CentralWidget->objectName() : QString(),
+		d->AutosaveVersion, testManagerConfigFlag(XmlAutoFormattingEnabled),
+		d->AutosaveFileName, testManagerConfigFlag(XmlCompressionEnabled),
+		d->LayoutGeneration));
+}
+
+
+//============================================================================
+void CDockManager::onAutosaveFinished(quint64 Generation, bool Success)
+{
+	d->AutosaveRunning = false;
+	if (Success)
+	{
+		d->AutosavedGeneration = Generation;
+	}
+
+	// Save the changes that happened while the autosave task was running
+	if (d->AutosaveTimer && !d->AutosaveFileName.isEmpty()
+	 && d->LayoutGeneration != d->AutosavedGeneration)
+	{
+		d->AutosaveTimer->start();
+	}
+	Q_EMIT autosaveFinished(d->AutosaveFileName, Success);
+}
+
+
 //============================================================================
 CDockWidget* CDockManager::centralWidget() const
 {
@@ -1152,6 +2246,17 @@ QAction* CDockManager::addToggleViewActionToMenu(QAction* ToggleViewAction,
 	bool AlphabeticallySorted = (MenuAlphabeticallySorted == d->MenuInsertionOrder);
 	if (!Group.isEmpty())
 	{
+		// The group is searchable via the dock widget index
+		auto DockWidget = qobject_cast<CDockWidget*>(ToggleViewAction->parent());
+		if (DockWidget)
+		{
+			DockWidget->setProperty(internal::ViewMenuGroupProperty, Group);
+			if (d->DockWidgetIndex)
+			{
+				d->DockWidgetIndex->updateDockWidget(DockWidget);
+			}
+		}
+
 		QMenu* GroupMenu = d->ViewMenuGroups.value(Group, nullptr);
 		if (!GroupMenu)
 		{
@@ -1257,6 +2362,100 @@ bool CDockManager::testAutoHideConfigFlag(eAutoHideFlag Flag)
 }
 
 
+//===========================================================================
+bool CDockManager::testConfigFlag(const CDockManager* DockManager, eConfigFlag Flag)
+{
+	return DockManager ? DockManager->testManagerConfigFlag(Flag) : testConfigFlag(Flag);
+}
+
+
+//===========================================================================
+bool CDockManager::testAutoHideConfigFlag(const CDockManager* DockManager, eAutoHideFlag Flag)
+{
+	return DockManager ? DockManager->testManagerAutoHideConfigFlag(Flag) : testAutoHideConfigFlag(Flag);
+}
+
+
+//===========================================================================
+CDockManager::ConfigFlags CDockManager::managerConfigFlags() const
+{
+	return d->HasConfigFlags ? d->ConfigFlags : StaticConfigFlags;
+}
+
+
+//===========================================================================
+CDockManager::AutoHideFlags CDockManager::managerAutoHideConfigFlags() const
+{
+	return d->HasAutoHideConfigFlags ? d->AutoHideConfigFlags : StaticAutoHideConfigFlags;
+}
+
+
+//===========================================================================
+void CDockManager::setManagerConfigFlags(const ConfigFlags Flags)
+{
+	d->ConfigFlags = Flags;
+	d->HasConfigFlags = true;
+	d->applyConfigFlags();
+}
+
+
+//===========================================================================
+void CDockManager::setManagerAutoHideConfigFlags(const AutoHideFlags Flags)
+{
+	d->AutoHideConfigFlags = Flags;
+	d->HasAutoHideConfigFlags = true;
+	d->applyConfigFlags();
+}
+
+
+//===========================================================================
+void CDockManager::setManagerConfigFlag(eConfigFlag Flag, bool On)
+{
+	auto Flags = managerConfigFlags();
+	internal::setFlag(Flags, Flag, On);
+	setManagerConfigFlags(Flags);
+}
+
+
+//===========================================================================
+void CDockManager::setManagerAutoHideConfigFlag(eAutoHideFlag Flag, bool On)
+{
+	auto Flags = managerAutoHideConfigFlags();
+	internal::setFlag(Flags, Flag, On);
+	setManagerAutoHideConfigFlags(Flags);
+}
+
+
+//===========================================================================
+bool CDockManager::testManagerConfigFlag(eConfigFlag Flag) const
+{
+	return managerConfigFlags().testFlag(Flag);
+}
+
+
+//===========================================================================
+bool CDockManager::testManagerAutoHideConfigFlag(eAutoHideFlag Flag) const
+{
+	return managerAutoHideConfigFlags().testFlag(Flag);
+}
+
+
+//===========================================================================
+bool CDockManager::hasManagerConfigFlags() const
+{
+	return d->HasConfigFlags || d->HasAutoHideConfigFlags;
+}
+
+
+//===========================================================================
+void CDockManager::resetManagerConfigFlags()
+{
+	d->HasConfigFlags = false;
+	d->HasAutoHideConfigFlags = false;
+	d->applyConfigFlags();
+}
+
+
 //===========================================================================
 CIconProvider& CDockManager::iconProvider()
 {
@@ -1268,6 +2467,7 @@ CIconProvider& CDockManager::iconProvider()
 //===========================================================================
 void CDockManager::notifyWidgetOrAreaRelocation(QWidget* DroppedWidget)
 {
+	markLayoutDirty();
 	if (d->FocusController)
 	{
 		d->FocusController->notifyWidgetOrAreaRelocation(DroppedWidget);
@@ -1278,6 +2478,7 @@ void CDockManager::notifyWidgetOrAreaRelocation(QWidget* DroppedWidget)
 //===========================================================================
 void CDockManager::notifyFloatingWidgetDrop(CFloatingDockContainer* FloatingWidget)
 {
+	markLayoutDirty();
 	if (d->FocusController)
 	{
 		d->FocusController->notifyFloatingWidgetDrop(FloatingWidget);
@@ -1308,7 +2509,7 @@ void CDockManager::hideManagerAndFloatingWidgets()
 			QList<CDockWidget*> VisibleWidgets;
 			for ( auto dockWidget : FloatingWidget->dockWidgets() )
 			{
-				if ( dockWidget->toggleViewAction()->isChecked() )
+				if ( dockWidget->isToggleViewActionChecked() )
 					VisibleWidgets.push_back( dockWidget );
 			}
 
@@ -1321,7 +2522,7 @@ void CDockManager::hideManagerAndFloatingWidgets()
 			// when CDockManager will be shown back
 			for ( auto dockWidget : VisibleWidgets )
 			{
-				dockWidget->toggleViewAction()->setChecked(true);
+				dockWidget->setToggleViewActionChecked(true);
 			}
 		}
 		}
@@ -1476,6 +2677,12 @@ CDockWidget::DockWidgetFeatures CDockManager::globallyLockedDockWidgetFeatures()
 }
 
 
+//============================================================================
+std::size_t internal::privateDataSize(const CDockManager*)
+{
+	return sizeof(DockManagerPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
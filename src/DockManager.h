@@ -34,10 +34,13 @@
 #include "DockContainerWidget.h"
 #include "DockWidget.h"
 #include "FloatingDockContainer.h"
+#include "DockLayoutSnapshot.h"
+#include "DockMemoryUsage.h"
 
 
 QT_FORWARD_DECLARE_CLASS(QSettings)
 QT_FORWARD_DECLARE_CLASS(QMenu)
+QT_FORWARD_DECLARE_CLASS(QIODevice)
 
 namespace ads
 {
@@ -47,6 +50,7 @@ struct FloatingDockContainerPrivate;
 class CDockContainerWidget;
 class DockContainerWidgetPrivate;
 class CDockOverlay;
+class CPerspectiveLibrary;
 class CDockAreaTabBar;
 class CDockWidgetTab;
 struct DockWidgetTabPrivate;
@@ -54,6 +58,9 @@ struct DockAreaWidgetPrivate;
 class CIconProvider;
 class CDockComponentsFactory;
 class CDockFocusController;
+class CDockCommandQueue;
+class CDockOcclusionTracker;
+class CDockWidgetIndex;
 class CAutoHideSideBar;
 class CAutoHideTab;
 struct AutoHideTabPrivate;
@@ -82,6 +89,7 @@ private:
 	friend class DockContainerWidgetPrivate;
 	friend class CDockAreaTabBar;
 	friend class CDockWidgetTab;
+	friend class CDockAreaWidget;
 	friend struct DockAreaWidgetPrivate;
 	friend struct DockWidgetTabPrivate;
 	friend class CFloatingDragPreview;
@@ -123,6 +131,54 @@ protected:
 	 */
 	void removeDockContainer(CDockContainerWidget* DockContainer);
 
+	/**
+	 * Returns an empty floating widget from the floating widget pool or
+	 * creates a new one, if the pool is empty.
+	 * The returned floating widget is registered in this dock manager.
+	 */
+	CFloatingDockContainer* takeFloatingWidget();
+
+	/**
+	 * Resets the given empty floating widget and moves it into the floating
+	 * widget pool.
+	 * Returns false, if the pool is full or if the floating widget can not be
+	 * reused. In this case the caller is responsible for deleting the
+	 * floating widget.
+	 */
+	bool recycleFloatingWidget(CFloatingDockContainer* FloatingWidget);
+
+	/**
+	 * Returns a dock area from the dock area pool or creates a new one, if
+	 * the pool is empty.
+	 * \see CDockComponentsFactory::setRecyclingPoolSize()
+	 */
+	CDockAreaWidget* takeDockArea(CDockContainerWidget* Parent);
+
+	/**
+	 * Moves the given dock area, that has been removed from its container,
+	 * into the dock area pool. The dock area is reset in the next event loop
+	 * iteration, or deleted if it is not empty or if the pool is full.
+	 * Returns false, if recycling is disabled or if the dock area can not be
+	 * reused. In this case the caller is responsible for deleting the dock
+	 * area.
+	 */
+	bool recycleDockArea(CDockAreaWidget* DockArea);
+
+	/**
+	 * Returns an auto hide tab from the auto hide tab pool or creates a new
+	 * one via the components factory, if the pool is empty.
+	 */
+	CAutoHideTab* takeAutoHideTab();
+
+	/**
+	 * Moves the given auto hide tab, that has been removed from its side bar,
+	 * into the auto hide tab pool. The tab is reset in the next event loop
+	 * iteration.
+	 * Returns false, if recycling is disabled. In this case the caller is
+	 * responsible for deleting the tab.
+	 */
+	bool recycleAutoHideTab(CAutoHideTab* Tab);
+
 	/**
 	 * Overlay for containers
 	 */
@@ -215,6 +271,8 @@ public:
 		MiddleMouseButtonClosesTab = 0x2000000, //! If the flag is set, the user can use the mouse middle button to close the tab under the mouse
 		DisableTabTextEliding =      0x4000000, //! Set this flag to disable eliding of tab texts in dock area tabs
 		ShowTabTextOnlyForActiveTab =0x8000000, //! Set this flag to show label texts in dock area tabs only for active tabs
+		PerspectiveDeduplication = 0x10000000, //!< If set, perspectives share identical splitter and dock area subtrees in memory, in the perspective library and in saved perspective settings
+		DragPreviewInWindow = 0x20000000, //!< If opaque undocking is disabled, the drag preview is painted inside the window under the cursor. The top level preview window is only shown if the cursor is outside of all dock windows
 
         DefaultDockAreaButtons = DockAreaHasCloseButton
 							   | DockAreaHasUndockButton
@@ -254,6 +312,8 @@ public:
 		AutoHideCloseButtonCollapsesDock = 0x40, ///< Close button of an auto hide container collapses the dock instead of hiding it completely
 		AutoHideHasCloseButton = 0x80, //< If the flag is set an auto hide title bar has a close button
 		AutoHideHasMinimizeButton = 0x100, ///< if this flag is set, the auto hide title bar has a minimize button to collapse the dock widget
+		AutoHidePrewarmContent = 0x200, ///< if this flag is set, hidden auto hide containers are polished and laid out at their target size in idle time to reduce the latency of the first slide in
+		AutoHidePrewarmSnapshot = 0x400, ///< if this flag is set together with AutoHidePrewarmContent, a snapshot of the prewarmed content is cached (see CAutoHideDockContainer::contentSnapshot())
 
 		DefaultAutoHideConfig = AutoHideFeatureEnabled
 			                  | DockAreaHasAutoHideButton
@@ -323,6 +383,85 @@ public:
 	 */
 	static bool testAutoHideConfigFlag(eAutoHideFlag Flag);
 
+	/**
+	 * Returns true if the given config flag is set for the given dock
+	 * manager. If DockManager is a nullptr, the global config flag is
+	 * tested. Components use this function to test the configuration of the
+	 * dock manager they belong to.
+	 */
+	static bool testConfigFlag(const CDockManager* DockManager, eConfigFlag Flag);
+
+	/**
+	 * Returns true if the given auto hide config flag is set for the given
+	 * dock manager. If DockManager is a nullptr, the global config flag
+	 * is tested.
+	 */
+	static bool testAutoHideConfigFlag(const CDockManager* DockManager, eAutoHideFlag Flag);
+
+	/**
+	 * Returns the configuration flags of this dock manager.
+	 * As long as no flags have been set for this dock manager, this returns
+	 * the global configuration flags, so changes of the global flags are
+	 * inherited.
+	 */
+	ConfigFlags managerConfigFlags() const;
+
+	/**
+	 * Returns the auto hide configuration flags of this dock manager or the
+	 * global auto hide configuration flags if no flags have been set for
+	 * this dock manager.
+	 */
+	AutoHideFlags managerAutoHideConfigFlags() const;
+
+	/**
+	 * Sets configuration flags that only apply to this dock manager and
+	 * override the global configuration flags. Like the global flags, call
+	 * this function before you add the first dock widget to this dock
+	 * manager.
+	 */
+	void setManagerConfigFlags(const ConfigFlags Flags);
+
+	/**
+	 * Sets auto hide configuration flags that only apply to this dock
+	 * manager
+	 */
+	void setManagerAutoHideConfigFlags(const AutoHideFlags Flags);
+
+	/**
+	 * Set a certain config flag for this dock manager. If no flags have been
+	 * set for this dock manager yet, the other flags are copied from the
+	 * global configuration flags.
+	 */
+	void setManagerConfigFlag(eConfigFlag Flag, bool On = true);
+
+	/**
+	 * Set a certain auto hide config flag for this dock manager
+	 */
+	void setManagerAutoHideConfigFlag(eAutoHideFlag Flag, bool On = true);
+
+	/**
+	 * Returns true if the given config flag is set for this dock manager
+	 */
+	bool testManagerConfigFlag(eConfigFlag Flag) const;
+
+	/**
+	 * Returns true if the given auto hide config flag is set for this dock
+	 * manager
+	 */
+	bool testManagerAutoHideConfigFlag(eAutoHideFlag Flag) const;
+
+	/**
+	 * Returns true if this dock manager overrides the global config flags
+	 * or auto hide config flags
+	 */
+	bool hasManagerConfigFlags() const;
+
+	/**
+	 * Removes the configuration flags of this dock manager, so that it
+	 * inherits the global configuration flags again
+	 */
+	void resetManagerConfigFlags();
+
 	/**
 	 * Returns the global icon provider.
 	 * The icon provider enables the use of custom icons in case using
@@ -401,6 +540,17 @@ public:
 	 */
 	CDockWidget* findDockWidget(const QString& ObjectName) const;
 
+	/**
+	 * Searches for a registered dock widget with the given handle.
+	 * Each dock widget gets a handle when it is added to the dock manager.
+	 * Other than the lookup via object name, the lookup via handle is done
+	 * in constant time.
+	 * \return Return the found dock widget or nullptr if no dock widget
+	 * with the given handle is registered
+	 * \see CDockWidget::handle()
+	 */
+	CDockWidget* findDockWidget(int Handle) const;
+
 	/**
 	 * Remove the given Dock from the dock manager
 	 */
@@ -423,6 +573,24 @@ public:
 	 */
 	const QList<CFloatingDockContainer*> floatingWidgets() const;
 
+	/**
+	 * Sets the number of hidden floating widgets that are kept in a pool
+	 * for reuse.
+	 * Creating and destroying native windows is expensive on some platforms
+	 * (especially on X11). If the pool size is greater than 0, then floating
+	 * widgets that are no longer required (i.e. after they have been dropped
+	 * into another container or after restoring a state with less floating
+	 * widgets) are reset and kept hidden instead of being deleted. The pool
+	 * is filled in idle time with pre-created floating widgets.
+	 * A pool size of 0 (the default) disables pooling.
+	 */
+	void setFloatingWidgetPoolSize(int Size);
+
+	/**
+	 * Returns the configured floating widget pool size
+	 */
+	int floatingWidgetPoolSize() const;
+
 	/**
 	 * This function always return 0 because the main window is always behind
 	 * any floating widget
@@ -453,6 +621,76 @@ public:
 	 */
 	bool restoreState(const QByteArray &state, int version = 0);
 
+	/**
+	 * Saves the current state of the dockmanager into the given Device.
+	 * In contrast to the QByteArray version, the XML data is written
+	 * directly into the device without building the complete document in
+	 * memory. If XmlCompressionEnabled is set, the data is compressed in
+	 * chunks while it is written, so the memory required for saving is
+	 * bounded and independent from the size of the state.
+	 * The device needs to be open for writing.
+	 * Returns false, if writing to the device failed.
+	 * \see restoreState(QIODevice*, int)
+	 */
+	bool saveState(QIODevice* Device, int version = 0) const;
+
+	/**
+	 * Restores the state of this dockmanager from the given Device.
+	 * The device needs to be open for reading. It may contain uncompressed
+	 * XML data, data written by saveState(QIODevice*, int) or data returned
+	 * from saveState(int). Uncompressed and chunk compressed data is read
+	 * directly from the device. Restoring requires two passes over the
+	 * data, so data from sequential devices is read into memory first.
+	 * To restore a state from a memory mapped file, wrap the mapped memory
+	 * via QByteArray::fromRawData() into a QBuffer.
+	 * \see saveState(QIODevice*, int)
+	 */
+	bool restoreState(QIODevice* Device, int version = 0);
+
+	/**
+	 * Returns an immutable snapshot of the current layout.
+	 * The snapshot is built directly from the dock containers without
+	 * creating any XML data. It is cheap to copy, can be compared and hashed
+	 * and can safely be passed to other threads.
+	 * The snapshot contains the containers in the same order as the state
+	 * returned by saveState().
+	 */
+	CDockLayoutSnapshot layoutSnapshot() const;
+
+	/**
+	 * Returns the command queue of this dock manager.
+	 * Worker threads use the command queue to request changes of dock
+	 * widgets or perspectives. The queued commands are applied in batches
+	 * in the GUI thread. This function is thread safe.
+	 */
+	CDockCommandQueue* commandQueue() const;
+
+	/**
+	 * Returns the occlusion tracker of this dock manager.
+	 * The tracker is created on first access, so there is no overhead for
+	 * applications that do not use it. As soon as it exists, fully covered
+	 * dock areas are flagged as covered and their dock widgets are not
+	 * effectively visible anymore.
+	 */
+	CDockOcclusionTracker* occlusionTracker();
+
+	/**
+	 * Returns the search index over the titles, object names and view menu
+	 * groups of all dock widgets of this dock manager.
+	 * The index is created on first access and is then updated
+	 * incrementally. It is used by CDockQuickOpen and may be used to
+	 * implement other searches instead of filtering dockWidgetsMap().
+	 */
+	CDockWidgetIndex* dockWidgetIndex();
+
+	/**
+	 * Returns the memory use of this dock manager by component type.
+	 * This walks the complete object tree of the dock manager and its
+	 * floating widgets, so do not call it in performance critical code.
+	 * \see CDockMemoryUsage
+	 */
+	CDockMemoryUsage memoryUsage() const;
+
 	/**
 	 * Saves the current perspective to the internal list of perspectives.
 	 * A perspective is the current state of the dock manager assigned
@@ -488,6 +726,61 @@ public:
 	 */
 	void loadPerspectives(QSettings& Settings);
 
+	/**
+	 * Uses the given perspective library as storage for all perspectives.
+	 * If a library is set, the perspective functions of the dock manager
+	 * directly read from and write to the library and the perspective
+	 * states are only loaded when a perspective is opened.
+	 * loadPerspectives() imports the perspectives from the settings into
+	 * the library and savePerspectives() exports the library perspectives.
+	 * The dock manager does not take ownership of the library. Set a
+	 * nullptr to use the internal in memory list of perspectives again.
+	 */
+	void setPerspectiveLibrary(CPerspectiveLibrary* Library);
+
+	/**
+	 * Returns the perspective library set via setPerspectiveLibrary() or
+	 * a nullptr if no library is set
+	 */
+	CPerspectiveLibrary* perspectiveLibrary() const;
+
+	/**
+	 * Returns the current layout generation.
+	 * The layout generation is incremented by markLayoutDirty() each time
+	 * the layout changes, that means if dock widgets or floating widgets
+	 * are dropped, splitters are moved, dock widgets are opened or closed or
+	 * if floating widgets are moved or resized.
+	 */
+	quint64 layoutGeneration() const;
+
+	/**
+	 * Enables autosaving of the layout into the given file.
+	 * If the layout changed, the dock manager captures the layout on the
+	 * GUI thread after the autosave interval and compresses and writes it
+	 * into the file in a worker thread. Nothing is saved if the layout did
+	 * not change. The file is written in the format of
+	 * saveState(QIODevice*, int) and can be restored via
+	 * restoreState(QIODevice*, int). The given version is stored in the
+	 * saved state. Pass an empty file name to disable autosaving.
+	 */
+	void setAutosaveFile(const QString& FileName, int version = 0);
+
+	/**
+	 * Returns the autosave file or an empty string if autosave is disabled
+	 */
+	QString autosaveFile() const;
+
+	/**
+	 * Sets the time in milliseconds between the first layout change and
+	 * the autosave of the changed layout. The default is 5000 ms.
+	 */
+	void setAutosaveInterval(int Interval);
+
+	/**
+	 * Returns the autosave interval in milliseconds
+	 */
+	int autosaveInterval() const;
+
     /**
      * This function returns managers central widget or nullptr if no central widget is set.
      */
@@ -573,12 +866,12 @@ public:
 
 	/**
 	 * Helper function to set focus depending on the configuration of the
-	 * FocusStyling flag
+	 * FocusStyling flag of the dock manager of the given dock widget
 	 */
 	template <class QWidgetPtr>
 	static void setWidgetFocus(QWidgetPtr widget)
 	{
-		if (!CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+		if (!CDockManager::testConfigFlag(widget->dockManager(), CDockManager::FocusHighlighting))
 		{
 			return;
 		}
@@ -713,6 +1006,24 @@ public Q_SLOTS:
      */
     void hideManagerAndFloatingWidgets();
 
+	/**
+	 * Increments the layout generation and schedules an autosave if
+	 * autosave is enabled.
+	 * The dock manager calls this function for all layout changes it
+	 * tracks. Call it if the application changes the layout in a way the
+	 * dock manager can not detect.
+	 */
+	void markLayoutDirty();
+
+	/**
+	 * Starts an autosave of the layout now, if autosave is enabled and the
+	 * layout changed since the last autosave
+	 */
+	void autosave();
+
+private Q_SLOTS:
+	void onAutosaveFinished(quint64 Generation, bool Success);
+
 Q_SIGNALS:
 	/**
 	 * This signal is emitted if the list of perspectives changed.
@@ -761,6 +1072,12 @@ Q_SIGNALS:
      */
     void perspectiveOpened(const QString& PerspectiveName);
 
+    /**
+     * This signal is emitted if an autosave finished.
+     * Success is false, if writing the autosave file failed.
+     */
+    void autosaveFinished(const QString& FileName, bool Success);
+
 	/**
 	 * This signal is emitted, if a new floating widget has been created.
 	 * An application can use this signal to e.g. subscribe to events of
@@ -772,6 +1089,10 @@ Q_SIGNALS:
      * This signal is emitted, if a new DockArea has been created.
      * An application can use this signal to set custom icons or custom
      * tooltips for the DockArea buttons.
+     * If recycling is enabled, a dock area that is taken from the pool is
+     * announced again. Connections of the application to its signals are
+     * kept, so connect with Qt::UniqueConnection to avoid duplicated
+     * connections.
      */
     void dockAreaCreated(ads::CDockAreaWidget* DockArea);
 
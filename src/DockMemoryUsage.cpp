@@ -0,0 +1,273 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockMemoryUsage.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockMemoryUsage class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockMemoryUsage.h"
+
+#include <QAction>
+#include <QLayout>
+#include <QMenu>
+#include <QSet>
+
+#include "AutoHideDockContainer.h"
+#include "AutoHideSideBar.h"
+#include "AutoHideTab.h"
+#include "DockAreaTabBar.h"
+#include "DockAreaTitleBar.h"
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockSplitter.h"
+#include "DockWidget.h"
+#include "DockWidgetTab.h"
+#include "FloatingDockContainer.h"
+
+namespace ads
+{
+static const char* const ComponentNames[CDockMemoryUsage::ComponentCount] = {
+	"DockWidgets", "DockWidgetTabs", "DockAreas", "TitleBars", "TabBars",
+	"Containers", "FloatingWidgets", "Splitters", "AutoHideContainers",
+	"AutoHideTabs", "SideBars", "Actions", "Menus", "Layouts",
+	"HelperWidgets", "OtherObjects", "PrivateData"};
+
+
+/**
+ * Adds a docking system component and its private data
+ */
+template <class T>
+static void addComponent(CDockMemoryUsage& Usage, CDockMemoryUsage::eComponent Component,
+	const T* Object)
+{
+	Usage.add(Component, sizeof(T));
+	Usage.add(CDockMemoryUsage::PrivateData, internal::privateDataSize(Object));
+}
+
+
+/**
+ * Adds the given object and all its children except the content widgets
+ * of the dock widgets
+ */
+static void addObjectTree(CDockMemoryUsage& Usage, QObject* Object,
+	const QSet<QObject*>& ContentWidgets, QSet<QObject*>& Visited)
+{
+	if (ContentWidgets.contains(Object) || Visited.contains(Object))
+	{
+		return;
+	}
+	Visited.insert(Object);
+
+	if (auto DockManager = qobject_cast<CDockManager*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::Containers, DockManager);
+		Usage.add(CDockMemoryUsage::PrivateData, internal::privateDataSize(
+			static_cast<CDockContainerWidget*>(DockManager)));
+	}
+	else if (auto Container = qobject_cast<CDockContainerWidget*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::Containers, Container);
+	}
+	else if (auto FloatingWidget = qobject_cast<CFloatingDockContainer*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::FloatingWidgets, FloatingWidget);
+	}
+	else if (auto DockWidget = qobject_cast<CDockWidget*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::DockWidgets, DockWidget);
+	}
+	else if (auto Tab = qobject_cast<CDockWidgetTab*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::DockWidgetTabs, Tab);
+	}
+	else if (auto DockArea = qobject_cast<CDockAreaWidget*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::DockAreas, DockArea);
+	}
+	else if (auto TitleBar = qobject_cast<CDockAreaTitleBar*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::TitleBars, TitleBar);
+	}
+	else if (auto TabBar = qobject_cast<CDockAreaTabBar*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::TabBars, TabBar);
+	}
+	else if (auto Splitter = qobject_cast<CDockSplitter*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::Splitters, Splitter);
+	}
+	else if (auto AutoHideContainer = qobject_cast<CAutoHideDockContainer*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::AutoHideContainers, AutoHideContainer);
+	}
+	else if (auto AutoHideTab = qobject_cast<CAutoHideTab*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::AutoHideTabs, AutoHideTab);
+	}
+	else if (auto SideBar = qobject_cast<CAutoHideSideBar*>(Object))
+	{
+		addComponent(Usage, CDockMemoryUsage::SideBars, SideBar);
+	}
+	else if (qobject_cast<QAction*>(Object))
+	{
+		Usage.add(CDockMemoryUsage::Actions, sizeof(QAction));
+	}
+	else if (qobject_cast<QMenu*>(Object))
+	{
+		Usage.add(CDockMemoryUsage::Menus, sizeof(QMenu));
+	}
+	else if (qobject_cast<QLayout*>(Object))
+	{
+		Usage.add(CDockMemoryUsage::Layouts, sizeof(QLayout));
+	}
+	else if (Object->isWidgetType())
+	{
+		Usage.add(CDockMemoryUsage::HelperWidgets, sizeof(QWidget));
+	}
+	else
+	{
+		Usage.add(CDockMemoryUsage::OtherObjects, sizeof(QObject));
+	}
+
+	for (auto Child : Object->children())
+	{
+		addObjectTree(Usage, Child, ContentWidgets, Visited);
+	}
+}
+
+
+//============================================================================
+CDockMemoryUsage::CDockMemoryUsage() :
+	m_Counts(ComponentCount, 0),
+	m_Bytes(ComponentCount, 0)
+{
+
+}
+
+
+//============================================================================
+CDockMemoryUsage CDockMemoryUsage::collect(const CDockManager* DockManager)
+{
+	CDockMemoryUsage Usage;
+	if (!DockManager)
+	{
+		return Usage;
+	}
+
+	QSet<QObject*> ContentWidgets;
+	for (auto DockWidget : DockManager->dockWidgetsMap())
+	{
+		if (DockWidget->widget())
+		{
+			ContentWidgets.insert(DockWidget->widget());
+		}
+	}
+
+	// Floating widgets are children of the dock manager, so they are
+	// usually found in the object tree of the dock manager
+	QSet<QObject*> Visited;
+	auto Manager = const_cast<CDockManager*>(DockManager);
+	addObjectTree(Usage, Manager, ContentWidgets, Visited);
+	for (auto FloatingWidget : DockManager->floatingWidgets())
+	{
+		addObjectTree(Usage, FloatingWidget, ContentWidgets, Visited);
+	}
+	return Usage;
+}
+
+
+//============================================================================
+QString CDockMemoryUsage::componentName(eComponent Component)
+{
+	if (Component < 0 || Component >= ComponentCount)
+	{
+		return QString();
+	}
+	return QString::fromLatin1(ComponentNames[Component]);
+}
+
+
+//============================================================================
+void CDockMemoryUsage::add(eComponent Component, qint64 Bytes, int Count)
+{
+	if (Component < 0 || Component >= ComponentCount)
+	{
+		return;
+	}
+	m_Counts[Component] += Count;
+	m_Bytes[Component] += Bytes;
+}
+
+
+//============================================================================
+int CDockMemoryUsage::count(eComponent Component) const
+{
+	return m_Counts.value(Component);
+}
+
+
+//============================================================================
+qint64 CDockMemoryUsage::bytes(eComponent Component) const
+{
+	return m_Bytes.value(Component);
+}
+
+
+//============================================================================
+qint64 CDockMemoryUsage::totalBytes() const
+{
+	qint64 Result = 0;
+	for (auto Bytes : m_Bytes)
+	{
+		Result += Bytes;
+	}
+	return Result;
+}
+
+
+//============================================================================
+qint64 CDockMemoryUsage::bytesPerDockWidget() const
+{
+	int DockWidgetCount = count(DockWidgets);
+	return DockWidgetCount ? totalBytes() / DockWidgetCount : 0;
+}
+
+
+//============================================================================
+QString CDockMemoryUsage::toString() const
+{
+	QString Result;
+	for (int i = 0; i < ComponentCount; ++i)
+	{
+		Result += QString("%1 %2 %3\n").arg(componentName(eComponent(i)), -20)
+			.arg(m_Counts[i], 8).arg(m_Bytes[i], 12);
+	}
+	Result += QString("%1 %2 %3\n").arg("Total", -20).arg(QString(), 8).arg(totalBytes(), 12);
+	return Result;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockMemoryUsage.cpp
@@ -0,0 +1,169 @@
+#ifndef DockMemoryUsageH
+#define DockMemoryUsageH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockMemoryUsage.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockMemoryUsage class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+#include <QVector>
+
+#include <cstddef>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+class CDockManager;
+class CDockWidget;
+class CDockWidgetTab;
+class CDockAreaWidget;
+class CDockAreaTitleBar;
+class CDockAreaTabBar;
+class CDockContainerWidget;
+class CFloatingDockContainer;
+class CDockSplitter;
+class CAutoHideDockContainer;
+class CAutoHideTab;
+class CAutoHideSideBar;
+
+/**
+ * Memory use of the docking system objects of one dock manager, counted
+ * by component type.
+ * The bytes of a component are the size of its object. The private data
+ * of the docking system components is counted separately as PrivateData.
+ * The private data that Qt allocates for each QObject and QWidget is not
+ * visible to the docking system and is not included, so the figures are a
+ * lower bound that is meant for comparing layouts and versions of the
+ * library. The content widgets of the dock widgets are not included.
+ * Use CDockManager::memoryUsage() to collect the figures.
+ */
+class ADS_EXPORT CDockMemoryUsage
+{
+public:
+	/**
+	 * The component types
+	 */
+	enum eComponent
+	{
+		DockWidgets,
+		DockWidgetTabs,
+		DockAreas,
+		TitleBars,
+		TabBars,
+		Containers,
+		FloatingWidgets,
+		Splitters,
+		AutoHideContainers,
+		AutoHideTabs,
+		SideBars,
+		Actions,
+		Menus,
+		Layouts,
+		HelperWidgets,///< labels, buttons, frames and other internal widgets
+		OtherObjects,
+		PrivateData,
+		ComponentCount
+	};
+
+	/**
+	 * Creates an empty memory usage
+	 */
+	CDockMemoryUsage();
+
+	/**
+	 * Collects the memory usage of all objects of the given dock manager
+	 * and its floating widgets
+	 */
+	static CDockMemoryUsage collect(const CDockManager* DockManager);
+
+	/**
+	 * Returns the name of the given component type
+	 */
+	static QString componentName(eComponent Component);
+
+	/**
+	 * Adds Count objects of the given component type with a total size of
+	 * Bytes
+	 */
+	void add(eComponent Component, qint64 Bytes, int Count = 1);
+
+	/**
+	 * Returns the number of objects of the given component type
+	 */
+	int count(eComponent Component) const;
+
+	/**
+	 * Returns the bytes of the given component type
+	 */
+	qint64 bytes(eComponent Component) const;
+
+	/**
+	 * Returns the bytes of all component types
+	 */
+	qint64 totalBytes() const;
+
+	/**
+	 * Returns the total bytes divided by the number of dock widgets or 0
+	 * if there are no dock widgets
+	 */
+	qint64 bytesPerDockWidget() const;
+
+	/**
+	 * Returns a table with one line per component type for logging
+	 */
+	QString toString() const;
+
+private:
+	QVector<int> m_Counts;
+	QVector<qint64> m_Bytes;
+}; // class CDockMemoryUsage
+
+
+namespace internal
+{
+/**
+ * The size of the private data of each docking system component. The
+ * functions are defined next to the private data structures.
+ */
+std::size_t privateDataSize(const CDockManager*);
+std::size_t privateDataSize(const CDockWidget*);
+std::size_t privateDataSize(const CDockWidgetTab*);
+std::size_t privateDataSize(const CDockAreaWidget*);
+std::size_t privateDataSize(const CDockAreaTitleBar*);
+std::size_t privateDataSize(const CDockAreaTabBar*);
+std::size_t privateDataSize(const CDockContainerWidget*);
+std::size_t privateDataSize(const CFloatingDockContainer*);
+std::size_t privateDataSize(const CDockSplitter*);
+std::size_t privateDataSize(const CAutoHideDockContainer*);
+std::size_t privateDataSize(const CAutoHideTab*);
+std::size_t privateDataSize(const CAutoHideSideBar*);
+} // namespace internal
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockMemoryUsageH
@@ -0,0 +1,637 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockOcclusionTracker.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockOcclusionTracker class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockOcclusionTracker.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QHash>
+#include <QMetaObject>
+#include <QWidget>
+
+#include "AutoHideDockContainer.h"
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockSplitter.h"
+#include "FloatingDockContainer.h"
+
+namespace ads
+{
+/**
+ * Global geometry and coverage of one docked dock area
+ */
+struct OcclusionArea
+{
+	CDockAreaWidget* DockArea = nullptr;
+	QRect Rect;
+	qreal Coverage = 0.0;
+};
+
+
+/**
+ * Private data class of CDockOcclusionTracker class (pimpl)
+ */
+struct DockOcclusionTrackerPrivate
+{
+	CDockOcclusionTracker* _this;
+	CDockManager* DockManager;
+	// Destroyed objects are removed via their QObject pointer, so all
+	// hashes use QObject pointers as keys
+	QHash<QObject*, QRect> Covers;
+	QRegion CoverRegion;
+	QHash<QObject*, OcclusionArea> Areas;
+	QHash<QObject*, CDockAreaWidget*> DirtyAreas;
+	QRegion DirtyRegion;
+	bool CoversDirty = true;
+	bool AllDirty = true;
+	bool UpdateScheduled = false;
+
+	/**
+	 * Private data constructor
+	 */
+	DockOcclusionTrackerPrivate(CDockOcclusionTracker* _public);
+
+	/**
+	 * Schedules one single update for all changes of the current event
+	 * loop iteration
+	 */
+	void scheduleUpdate();
+
+	/**
+	 * Installs the event filter on the given widget and removes the widget
+	 * from all hashes if it is destroyed
+	 */
+	void watch(QWidget* Widget);
+
+	/**
+	 * Watches the given dock area and all splitters between the dock area
+	 * and the dock manager
+	 */
+	void watchDockArea(CDockAreaWidget* DockArea);
+
+	/**
+	 * Watches the dock areas of the given container
+	 */
+	void watchDockAreas(CDockContainerWidget* Container);
+
+	/**
+	 * Marks the given dock area for recalculation in the next update
+	 */
+	void markDirty(CDockAreaWidget* DockArea);
+
+	/**
+	 * Returns true, if the given dock area is an opened dock area of the
+	 * dock manager
+	 */
+	bool isDocked(CDockAreaWidget* DockArea) const;
+
+	/**
+	 * Returns true, if the given widget covers docked dock areas
+	 */
+	bool isCover(QWidget* Widget) const;
+
+	/**
+	 * Updates the geometry of the given widget in the list of covering
+	 * widgets and marks the old and new geometry as dirty
+	 */
+	void updateCover(QWidget* Widget);
+
+	/**
+	 * Rebuilds the complete list of covering widgets
+	 */
+	void rebuildCovers();
+
+	/**
+	 * Returns the global geometry of the given dock area
+	 */
+	static QRect globalGeometry(QWidget* Widget)
+	{
+		return QRect(Widget->mapToGlobal(QPoint(0, 0)), Widget->size());
+	}
+
+	/**
+	 * Returns the fraction of the given rectangle that is covered
+	 */
+	qreal coveredFraction(const QRect& Rect) const;
+
+	/**
+	 * Sets the coverage of the given area and notifies the dock area if
+	 * the coverage changed
+	 */
+	void setCoverage(OcclusionArea& Area, qreal Coverage);
+
+	/**
+	 * Recalculates the geometry and coverage of the given dock area
+	 */
+	void updateArea(CDockAreaWidget* DockArea);
+};
+// struct DockOcclusionTrackerPrivate
+
+
+//============================================================================
+DockOcclusionTrackerPrivate::DockOcclusionTrackerPrivate(CDockOcclusionTracker* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::scheduleUpdate()
+{
+	if (UpdateScheduled)
+	{
+		return;
+	}
+
+	UpdateScheduled = true;
+	QMetaObject::invokeMethod(_this, "updateCoverage", Qt::QueuedConnection);
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::watch(QWidget* Widget)
+{
+	// Installing an event filter twice moves it to the front, so this is
+	// safe for widgets that are already watched
+	Widget->installEventFilter(_this);
+	QObject::connect(Widget, SIGNAL(destroyed(QObject*)), _this,
+		SLOT(onObjectDestroyed(QObject*)), Qt::UniqueConnection);
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::watchDockArea(CDockAreaWidget* DockArea)
+{
+	watch(DockArea);
+	for (auto Parent = DockArea->parentWidget(); Parent && Parent != DockManager;
+		Parent = Parent->parentWidget())
+	{
+		if (qobject_cast<CDockSplitter*>(Parent))
+		{
+			watch(Parent);
+		}
+	}
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::watchDockAreas(CDockContainerWidget* Container)
+{
+	for (int i = 0; i < Container->dockAreaCount(); ++i)
+	{
+		watchDockArea(Container->dockArea(i));
+	}
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::markDirty(CDockAreaWidget* DockArea)
+{
+	DirtyAreas.insert(DockArea, DockArea);
+	scheduleUpdate();
+}
+
+
+//============================================================================
+bool DockOcclusionTrackerPrivate::isDocked(CDockAreaWidget* DockArea) const
+{
+	return !DockArea->isHidden() && DockArea->dockContainer() == DockManager;
+}
+
+
+//============================================================================
+bool DockOcclusionTrackerPrivate::isCover(QWidget* Widget) const
+{
+	if (!Widget->isVisible())
+	{
+		return false;
+	}
+
+	auto ManagerWindow = DockManager->window();
+	auto AutoHideContainer = qobject_cast<CAutoHideDockContainer*>(Widget);
+	if (AutoHideContainer)
+	{
+		return AutoHideContainer->dockContainer() == DockManager;
+	}
+
+	if (!Widget->isWindow() || Widget == ManagerWindow || Widget->isMinimized())
+	{
+		return false;
+	}
+
+	auto Type = Widget->windowType();
+	if (Type == Qt::Popup || Type == Qt::ToolTip || Type == Qt::Desktop
+	 || Widget->testAttribute(Qt::WA_TranslucentBackground)
+	 || Widget->testAttribute(Qt::WA_TransparentForMouseEvents))
+	{
+		return false;
+	}
+
+	if (Widget->windowFlags().testFlag(Qt::WindowStaysOnTopHint)
+	 || Widget->isActiveWindow())
+	{
+		return true;
+	}
+
+	// Windows with the dock manager window as parent always stay above it
+	for (auto Parent = Widget->parentWidget(); Parent; Parent = Parent->window()->parentWidget())
+	{
+		if (Parent->window() == ManagerWindow)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::updateCover(QWidget* Widget)
+{
+	QRect OldRect = Covers.value(Widget);
+	QRect NewRect;
+	if (isCover(Widget))
+	{
+		NewRect = Widget->isWindow() ? Widget->frameGeometry() : globalGeometry(Widget);
+	}
+
+	if (OldRect == NewRect)
+	{
+		return;
+	}
+
+	if (NewRect.isNull())
+	{
+		Covers.remove(Widget);
+	}
+	else
+	{
+		if (!Covers.contains(Widget))
+		{
+			// Watch other top level windows as soon as they cover a dock
+			// area, so moving, resizing or hiding them updates the coverage
+			watch(Widget);
+		}
+		Covers.insert(Widget, NewRect);
+	}
+	DirtyRegion += OldRect;
+	DirtyRegion += NewRect;
+	scheduleUpdate();
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::rebuildCovers()
+{
+	// Other top level windows of the application are only watched while
+	// they are a cover or after they have been one. They are checked
+	// whenever the activation or stacking order of the dock manager window
+	// or of a floating widget changes.
+	auto Widgets = QApplication::topLevelWidgets();
+	for (auto AutoHideContainer : DockManager->autoHideWidgets())
+	{
+		Widgets.append(AutoHideContainer);
+	}
+
+	for (auto Widget : Widgets)
+	{
+		updateCover(Widget);
+	}
+	CoversDirty = false;
+}
+
+
+//============================================================================
+qreal DockOcclusionTrackerPrivate::coveredFraction(const QRect& Rect) const
+{
+	if (Rect.isEmpty())
+	{
+		return 0.0;
+	}
+
+	// The rectangles of a region never overlap, so their areas can simply
+	// be added
+	QRegion Covered = CoverRegion.intersected(Rect);
+	qint64 CoveredArea = 0;
+	for (auto it = Covered.begin(); it != Covered.end(); ++it)
+	{
+		CoveredArea += qint64(it->width()) * it->height();
+	}
+	return qreal(CoveredArea) / (qint64(Rect.width()) * Rect.height());
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::setCoverage(OcclusionArea& Area, qreal Coverage)
+{
+	if (Area.Coverage == Coverage)
+	{
+		return;
+	}
+
+	Area.Coverage = Coverage;
+	Area.DockArea->setCovered(Coverage >= 1.0);
+	Q_EMIT _this->coverageChanged(Area.DockArea, Coverage);
+}
+
+
+//============================================================================
+void DockOcclusionTrackerPrivate::updateArea(CDockAreaWidget* DockArea)
+{
+	if (!isDocked(DockArea))
+	{
+		auto it = Areas.find(DockArea);
+		if (it != Areas.end())
+		{
+			setCoverage(it.value(), 0.0);
+			Areas.erase(it);
+		}
+		return;
+	}
+
+	// The dock area may have been moved into a new splitter
+	watchDockArea(DockArea);
+	auto& Area = Areas[DockArea];
+	Area.DockArea = DockArea;
+	Area.Rect = globalGeometry(DockArea);
+	setCoverage(Area, coveredFraction(Area.Rect));
+}
+
+
+//============================================================================
+CDockOcclusionTracker::CDockOcclusionTracker(CDockManager* DockManager) :
+	Super(DockManager),
+	d(new DockOcclusionTrackerPrivate(this))
+{
+	d->DockManager = DockManager;
+	d->watch(DockManager->window());
+	d->watchDockAreas(DockManager);
+	for (auto FloatingWidget : DockManager->floatingWidgets())
+	{
+		d->watch(FloatingWidget);
+		d->watchDockAreas(FloatingWidget->dockContainer());
+	}
+	for (auto AutoHideContainer : DockManager->autoHideWidgets())
+	{
+		d->watch(AutoHideContainer);
+	}
+
+	connect(DockManager, &CDockManager::dockAreaCreated, this,
+		[this](CDockAreaWidget* DockArea) { d->watch(DockArea); d->markDirty(DockArea); });
+	connect(DockManager, &CDockManager::floatingWidgetCreated, this,
+		[this](CFloatingDockContainer* FloatingWidget) { d->watch(FloatingWidget); });
+	connect(DockManager, &CDockContainerWidget::autoHideWidgetCreated, this,
+		[this](CAutoHideDockContainer* AutoHideContainer) { d->watch(AutoHideContainer); });
+	d->scheduleUpdate();
+}
+
+
+//============================================================================
+CDockOcclusionTracker::~CDockOcclusionTracker()
+{
+	delete d;
+}
+
+
+//============================================================================
+bool CDockOcclusionTracker::eventFilter(QObject* watched, QEvent* event)
+{
+	switch (event->type())
+	{
+	case QEvent::Show:
+	case QEvent::Hide:
+	case QEvent::Move:
+	case QEvent::Resize:
+	case QEvent::WindowStateChange:
+	case QEvent::ZOrderChange:
+	case QEvent::ActivationChange:
+		break;
+
+	default:
+		return false;
+	}
+
+	// Only widgets are watched
+	auto Widget = static_cast<QWidget*>(watched);
+	const bool StackingChanged = event->type() == QEvent::ActivationChange
+		|| event->type() == QEvent::ZOrderChange;
+	if (Widget->isWindow())
+	{
+		if (StackingChanged)
+		{
+			// The stacking order of all windows may have changed
+			d->CoversDirty = true;
+			d->scheduleUpdate();
+		}
+		else if (Widget == d->DockManager->window())
+		{
+			// All docked dock areas moved or changed their visibility
+			d->AllDirty = true;
+			d->scheduleUpdate();
+		}
+		else
+		{
+			d->updateCover(Widget);
+		}
+	}
+	else if (StackingChanged)
+	{
+		return false;
+	}
+	else if (auto DockArea = qobject_cast<CDockAreaWidget*>(Widget))
+	{
+		d->markDirty(DockArea);
+	}
+	else if (qobject_cast<CAutoHideDockContainer*>(Widget))
+	{
+		d->updateCover(Widget);
+	}
+	else if (qobject_cast<CDockSplitter*>(Widget))
+	{
+		// Moving a splitter moves its dock areas without a move event
+		for (auto DockArea : Widget->findChildren<CDockAreaWidget*>())
+		{
+			d->markDirty(DockArea);
+		}
+	}
+
+	return false;
+}
+
+
+//============================================================================
+void CDockOcclusionTracker::onObjectDestroyed(QObject* Object)
+{
+	// The object is already partially destroyed, so the pointer is only
+	// used as key
+	d->Areas.remove(Object);
+	d->DirtyAreas.remove(Object);
+	auto it = d->Covers.find(Object);
+	if (it == d->Covers.end())
+	{
+		return;
+	}
+
+	d->DirtyRegion += it.value();
+	d->Covers.erase(it);
+	d->scheduleUpdate();
+}
+
+
+//============================================================================
+void CDockOcclusionTracker::update()
+{
+	d->CoversDirty = true;
+	d->AllDirty = true;
+	updateCoverage();
+}
+
+
+//============================================================================
+void CDockOcclusionTracker::updateCoverage()
+{
+	// Changes detected by the rebuild are handled by this update
+	d->UpdateScheduled = true;
+	if (d->CoversDirty)
+	{
+		d->rebuildCovers();
+	}
+	d->UpdateScheduled = false;
+
+	d->CoverRegion = QRegion();
+	for (const auto& Rect : d->Covers)
+	{
+		d->CoverRegion += Rect;
+	}
+
+	bool ManagerVisible = d->DockManager->isVisible() && !d->DockManager->window()->isMinimized();
+	if (!ManagerVisible)
+	{
+		for (auto& Area : d->Areas)
+		{
+			d->setCoverage(Area, 0.0);
+		}
+		d->Areas.clear();
+		// The geometry is unknown until the dock manager is shown again
+		d->AllDirty = true;
+	}
+	else if (d->AllDirty)
+	{
+		auto OldAreas = d->Areas.keys();
+		for (auto DockArea : d->DockManager->openedDockAreas())
+		{
+			d->updateArea(DockArea);
+			OldAreas.removeOne(DockArea);
+		}
+		for (auto Object : OldAreas)
+		{
+			d->updateArea(d->Areas.value(Object).DockArea);
+		}
+		d->AllDirty = false;
+	}
+	else
+	{
+		// Only the dock areas that changed their geometry or visibility and
+		// the dock areas below changed covers need to be recalculated
+		for (auto DockArea : d->DirtyAreas)
+		{
+			d->updateArea(DockArea);
+		}
+		if (!d->DirtyRegion.isEmpty())
+		{
+			for (auto it = d->Areas.begin(); it != d->Areas.end(); ++it)
+			{
+				if (!d->DirtyAreas.contains(it.key()) && d->DirtyRegion.intersects(it->Rect))
+				{
+					d->setCoverage(it.value(), d->coveredFraction(it->Rect));
+				}
+			}
+		}
+	}
+
+	d->DirtyAreas.clear();
+	d->DirtyRegion = QRegion();
+}
+
+
+//============================================================================
+qreal CDockOcclusionTracker::coverage(CDockAreaWidget* DockArea) const
+{
+	return d->Areas.value(DockArea).Coverage;
+}
+
+
+//============================================================================
+bool CDockOcclusionTracker::isCovered(CDockAreaWidget* DockArea) const
+{
+	return coverage(DockArea) >= 1.0;
+}
+
+
+//============================================================================
+bool CDockOcclusionTracker::isPartiallyCovered(CDockAreaWidget* DockArea) const
+{
+	return coverage(DockArea) > 0.0;
+}
+
+
+//============================================================================
+QList<CDockAreaWidget*> CDockOcclusionTracker::coveredDockAreas() const
+{
+	QList<CDockAreaWidget*> Result;
+	for (const auto& Area : d->Areas)
+	{
+		if (Area.Coverage > 0.0)
+		{
+			Result.append(Area.DockArea);
+		}
+	}
+	return Result;
+}
+
+
+//============================================================================
+QRegion CDockOcclusionTracker::visibleRegion(CDockAreaWidget* DockArea) const
+{
+	auto Rect = d->globalGeometry(DockArea);
+	QRegion Region = QRegion(Rect).subtracted(d->CoverRegion);
+	return Region.translated(-Rect.topLeft());
+}
+
+
+//============================================================================
+bool CDockOcclusionTracker::isCoveredAt(const QPoint& GlobalPos) const
+{
+	return d->CoverRegion.contains(GlobalPos);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockOcclusionTracker.cpp
@@ -0,0 +1,156 @@
+#ifndef DockOcclusionTrackerH
+#define DockOcclusionTrackerH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockOcclusionTracker.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockOcclusionTracker class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QList>
+#include <QRegion>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockOcclusionTrackerPrivate;
+class CDockManager;
+class CDockAreaWidget;
+
+/**
+ * Tracks which docked dock areas of a dock manager are covered by other
+ * windows.
+ * Covering windows are the visible floating containers, the open auto hide
+ * containers of the dock manager and all other top level windows of the
+ * application that are above the dock manager window. A top level window
+ * is considered to be above the dock manager window, if the dock manager
+ * window is one of its parents, if it stays on top or if it is the active
+ * window. Popups, tool tips and translucent windows like the drop overlays
+ * never cover a dock area.
+ * The tracker does not filter all application events. It only watches
+ * the move, resize, show, hide, window state and z-order changes of the
+ * dock manager window, of the floating widgets and auto hide containers of
+ * the dock manager and of the docked dock areas and their splitters. Other
+ * top level windows are rechecked if the activation or stacking order of
+ * a watched window changes. As soon as another top level window covers
+ * a dock area, it is watched, too, so moving, resizing or hiding it
+ * updates the coverage immediately. A window that becomes a covering
+ * window without an activation or stacking order change of a watched
+ * window, e.g. if the WindowStaysOnTopHint flag of an unwatched window is
+ * set, is only detected with the next such change or with a call of
+ * update(). All changes of one event loop iteration are
+ * handled in one single update. Only the dock areas that changed their
+ * geometry or visibility and the dock areas that intersect changed
+ * covering windows are recalculated. Fully covered dock areas are
+ * flagged via CDockAreaWidget::setCovered(), so the dock widgets in these
+ * areas are not effectively visible anymore.
+ * Use CDockManager::occlusionTracker() to access the tracker.
+ */
+class ADS_EXPORT CDockOcclusionTracker : public QObject
+{
+	Q_OBJECT
+private:
+	DockOcclusionTrackerPrivate* d; ///< private data (pimpl)
+	friend struct DockOcclusionTrackerPrivate;
+
+private Q_SLOTS:
+	void onObjectDestroyed(QObject* Object);
+	void updateCoverage();
+
+protected:
+	/**
+	 * Watches the events of the dock manager window, the floating widgets,
+	 * the auto hide containers, the dock areas and their splitters that
+	 * change the occlusion of dock areas
+	 */
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+public:
+	using Super = QObject;
+
+	/**
+	 * Creates the tracker for the given dock manager
+	 */
+	CDockOcclusionTracker(CDockManager* DockManager);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockOcclusionTracker();
+
+	/**
+	 * Returns the covered fraction of the given dock area in the range
+	 * from 0.0 (not covered) to 1.0 (fully covered)
+	 */
+	qreal coverage(CDockAreaWidget* DockArea) const;
+
+	/**
+	 * Returns true, if the given dock area is fully covered
+	 */
+	bool isCovered(CDockAreaWidget* DockArea) const;
+
+	/**
+	 * Returns true, if the given dock area is partially or fully covered
+	 */
+	bool isPartiallyCovered(CDockAreaWidget* DockArea) const;
+
+	/**
+	 * Returns all dock areas that are partially or fully covered
+	 */
+	QList<CDockAreaWidget*> coveredDockAreas() const;
+
+	/**
+	 * Returns the region of the given dock area that is not covered by
+	 * other windows in the coordinates of the dock area. Content widgets
+	 * can use it to skip painting of hidden regions.
+	 */
+	QRegion visibleRegion(CDockAreaWidget* DockArea) const;
+
+	/**
+	 * Returns true, if the given global position is covered by a window
+	 * or auto hide container that is above the dock manager window
+	 */
+	bool isCoveredAt(const QPoint& GlobalPos) const;
+
+public Q_SLOTS:
+	/**
+	 * Recalculates the covering windows and the coverage of all dock areas.
+	 * This function is called automatically and you only need to call it,
+	 * if you need the current state immediately.
+	 */
+	void update();
+
+Q_SIGNALS:
+	/**
+	 * This signal is emitted if the coverage of a dock area changed
+	 */
+	void coverageChanged(ads::CDockAreaWidget* DockArea, qreal Coverage);
+}; // class CDockOcclusionTracker
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockOcclusionTrackerH
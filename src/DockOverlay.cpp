@@ -34,6 +34,7 @@
 #include <QtGlobal>
 #include <QDebug>
 #include <QMap>
+#include <QVector>
 #include <QWindow>
 #include <QApplication>
 
@@ -49,6 +50,7 @@ namespace ads
 static const int AutoHideAreaWidth = 32;
 static const int AutoHideAreaMouseZone = 8;
 static const int InvalidTabIndex = -2;
+static const int MaxCachedCrossLayouts = 16;
 
 /**
  * Private data class of CDockOverlay
@@ -70,12 +72,52 @@ struct DockOverlayPrivate
         QWidget* DockAreaWidget = nullptr;
         QFrame* DockTargetFrame = nullptr;
     } LastlyHoveredDropArea;
+	QFrame* DropStripFrame = nullptr;
+	DockWidgetArea DropStripFrameArea = InvalidDockWidgetArea;
+
+	// The allowed areas computed for the current target widget
+	DockWidgetAreas TargetAllowedAreas = InvalidDockWidgetArea;
+	bool TargetAllowedAreasValid = false;
+
+	// showOverlay() starts a new drag step. The drop area is queried several
+	// times per drag step, so the result is memoized for the drag step and
+	// the cursor position it has been computed for
+	quint64 DragStep = 0;
+	struct {
+		bool Valid = false;
+		quint64 DragStep = 0;
+		QPoint CursorPos;
+		DockWidgetArea Area = InvalidDockWidgetArea;
+		int TabIndex = InvalidTabIndex;
+	} DropAreaMemo;
 
 	/**
 	 * Private data constructor
 	 */
 	DockOverlayPrivate(CDockOverlay* _public) : _this(_public) {}
 
+	/**
+	 * Sets the target widget and invalidates everything that has been
+	 * computed for the previous target
+	 */
+	void setTargetWidget(QWidget* Target)
+	{
+		if (TargetWidget.data() == Target)
+		{
+			return;
+		}
+		TargetWidget = Target;
+		TargetAllowedAreasValid = false;
+		DropAreaMemo.Valid = false;
+	}
+
+	/**
+	 * Shows the drop strip frame for the given area with the given geometry.
+	 * The frame is reused and the style sheet is only updated if the area
+	 * changes
+	 */
+	QFrame* showDropStripFrame(DockWidgetArea Area, const QRect& Geometry);
+
 	/**
 	 * Returns the overlay width / height depending on the visibility
 	 * of the sidebar
@@ -88,6 +130,7 @@ struct DockOverlayPrivate
 	int sideBarMouseZone(SideBarLocation sideBarLocation);
 };
 
+
 /**
  * Private data of CDockOverlayCross class
  */
@@ -102,11 +145,62 @@ struct DockOverlayCrossPrivate
 	bool UpdateRequired = false;
 	double LastDevicePixelRatio = 0.1;
 
+	/**
+	 * Geometry of the drop indicator widget of one allowed area
+	 */
+	struct SIndicator
+	{
+		DockWidgetArea Area;
+		QRect Geometry;
+	};
+
+	/**
+	 * The indicator geometries of the cross for one cross size, mode and
+	 * set of allowed areas
+	 */
+	struct SCrossLayout
+	{
+		QSize Size;
+		CDockOverlay::eMode Mode;
+		DockWidgetAreas AllowedAreas;
+		QVector<SIndicator> Indicators;
+	};
+	QList<SCrossLayout> LayoutCache;
+	int CurrentLayout = -1;
+	unsigned int LayoutSerial = 0;
+
+	struct {
+		bool Valid = false;
+		QPoint CursorPos;
+		QPoint Origin;
+		unsigned int LayoutSerial = 0;
+		DockWidgetArea Area = InvalidDockWidgetArea;
+	} LocationMemo;
+
 	/**
 	 * Private data constructor
 	 */
 	DockOverlayCrossPrivate(CDockOverlayCross* _public) : _this(_public) {}
 
+	/**
+	 * Selects the cached layout for the current cross size, mode and
+	 * allowed areas or reads the indicator geometries from the grid layout
+	 * if there is no cached layout yet
+	 */
+	const SCrossLayout& updateLayout();
+
+	/**
+	 * Drops all cached layouts. This is required if the indicator widgets
+	 * change
+	 */
+	void clearLayoutCache();
+
+	/**
+	 * Returns the area of the indicator under the given global cursor
+	 * position
+	 */
+	DockWidgetArea cursorLocation(const QPoint& GlobalPos);
+
 	/**
 	 *
 	 * @param area
@@ -174,6 +268,63 @@ int DockOverlayPrivate::sideBarMouseZone(SideBarLocation sideBarLocation)
 }
 
 
+//============================================================================
+QFrame* DockOverlayPrivate::showDropStripFrame(DockWidgetArea Area, const QRect& Geometry)
+{
+	if (!DropStripFrame)
+	{
+		DropStripFrame = new QFrame(Cross);
+	}
+
+	if (DropStripFrameArea != Area)
+	{
+		DropStripFrameArea = Area;
+		if (Area == CenterDockWidgetArea)
+		{
+			DropStripFrame->setStyleSheet(
+				QString(
+					"QFrame {"
+					"    border-top: %1px solid %3;"
+					"    border-right: %2px solid %3;"
+					"    border-bottom: %2px solid %3;"
+					"    border-left: %2px solid %3;"
+					"    background-color: transparent;"
+					"}"
+					).arg(
+						QString::number(ads::internal::DefaultDockTitleBarHeight),
+						QString::number(int(ads::internal::DockingAreaStripDetectSize / 2)),
+						ads::internal::HighlightDropAreaColorSpreadMiddle
+					)
+				);
+		}
+		else
+		{
+			QString stops = (Area == TopDockWidgetArea) ? "x1:0, y1:0, x2:0, y2:1" :
+							(Area == BottomDockWidgetArea) ? "x1:0, y1:1, x2:0, y2:0" :
+							(Area == LeftDockWidgetArea) ? "x1:0, y1:0, x2:1, y2:0" :
+							(Area == RightDockWidgetArea) ? "x1:1, y1:0, x2:0, y2:0" :
+															"x1:1, y1:1, x2:1, y2:1";
+			DropStripFrame->setStyleSheet(
+				QString(
+					"QFrame {"
+					"    background: qlineargradient("
+					"        spread:pad, "
+					"        %1, "
+					"        stop:0 %2, "
+					"        stop:1 %3 "
+					"    );"
+					"}"
+				).arg(stops, ads::internal::HighlightDropAreaColorSpreadStart, ads::internal::HighlightDropAreaColorSpreadEnd)
+			);
+		}
+	}
+
+	DropStripFrame->setGeometry(Geometry);
+	DropStripFrame->show();
+	return DropStripFrame;
+}
+
+
 //============================================================================
 CDockOverlay::CDockOverlay(QWidget* parent, eMode Mode) :
 	QFrame(parent),
@@ -222,6 +373,7 @@ void CDockOverlay::setAllowedAreas(DockWidgetAreas areas)
         return;
 	}
 	d->AllowedAreas = areas;
+	d->DropAreaMemo.Valid = false;
 }
 
 
@@ -232,6 +384,7 @@ void CDockOverlay::setAllowedArea(DockWidgetArea area, bool Enable)
 	d->AllowedAreas.setFlag(area, Enable);
 	if (AreasOld != d->AllowedAreas)
 	{
+		d->DropAreaMemo.Valid = false;
 		d->Cross->reset();
 	}
 }
@@ -240,6 +393,14 @@ void CDockOverlay::setAllowedArea(DockWidgetArea area, bool Enable)
 //============================================================================
 DockWidgetAreas CDockOverlay::allowedAreas() const
 {
+    // The allowed areas only depend on the target widget, so they are
+    // computed once per target
+    if (d->TargetAllowedAreasValid)
+    {
+        d->AllowedAreas = d->TargetAllowedAreas;
+        return d->AllowedAreas;
+    }
+
     DockWidgetAreas result = DockWidgetArea::InvalidDockWidgetArea;
     
     // if (d->TargetWidget.data())
@@ -265,6 +426,8 @@ DockWidgetAreas CDockOverlay::allowedAreas() const
         result = DockWidgetArea::AllDockAreas;
     }
     
+    d->TargetAllowedAreas = result;
+    d->TargetAllowedAreasValid = !d->TargetWidget.isNull();
     d->AllowedAreas = result;
     
 	return d->AllowedAreas;
@@ -274,26 +437,50 @@ DockWidgetAreas CDockOverlay::allowedAreas() const
 //============================================================================
 DockWidgetArea CDockOverlay::dropAreaUnderCursor() const
 {
-	d->TabIndex = InvalidTabIndex;
 	if (!d->TargetWidget)
 	{
+		d->TabIndex = InvalidTabIndex;
 		return InvalidDockWidgetArea;
 	}
-    
-    DockWidgetArea Result = d->Cross->cursorLocation();
+
+	// The drop area is queried several times per drag step, e.g. by the
+	// drag preview and on mouse release, mostly for the same cursor position
+	auto CursorPos = QCursor::pos();
+	auto& Memo = d->DropAreaMemo;
+	if (Memo.Valid && Memo.DragStep == d->DragStep && Memo.CursorPos == CursorPos)
+	{
+		d->TabIndex = Memo.TabIndex;
+		return Memo.Area;
+	}
+
+	auto Result = computeDropAreaUnderCursor(CursorPos);
+	Memo.Valid = true;
+	Memo.DragStep = d->DragStep;
+	Memo.CursorPos = CursorPos;
+	Memo.Area = Result;
+	Memo.TabIndex = d->TabIndex;
+	return Result;
+}
+
+
+//============================================================================
+DockWidgetArea CDockOverlay::computeDropAreaUnderCursor(const QPoint& CursorPos) const
+{
+	d->TabIndex = InvalidTabIndex;
+    DockWidgetArea Result = d->Cross->d->cursorLocation(CursorPos);
 
     if (Result != InvalidDockWidgetArea)
     {
 		return Result;
 	}
     
-	auto CursorPos = QCursor::pos();
 	auto DockArea = qobject_cast<CDockAreaWidget*>(d->TargetWidget.data());
     
-	if (!DockArea && CDockManager::autoHideConfigFlags().testFlag(CDockManager::AutoHideFeatureEnabled))
+	auto DockManager = qobject_cast<CDockManager*>(parentWidget());
+	if (!DockArea && CDockManager::testAutoHideConfigFlag(DockManager, CDockManager::AutoHideFeatureEnabled))
 	{
 		auto Rect = rect();
-		const QPoint pos = mapFromGlobal(QCursor::pos());
+		const QPoint pos = mapFromGlobal(CursorPos);
 		if ((pos.x() < d->sideBarMouseZone(SideBarLeft))
 		  && d->AllowedAreas.testFlag(LeftAutoHideArea))
 		{
@@ -373,10 +560,11 @@ void CDockOverlay::clearDockDropStrip()
     d->LastlyHoveredDropArea.DockAreaWidget = nullptr;
     if (d->LastlyHoveredDropArea.DockTargetFrame)
     {
-        d->LastlyHoveredDropArea.DockTargetFrame->close();
+        d->LastlyHoveredDropArea.DockTargetFrame->hide();
         d->LastlyHoveredDropArea.DockTargetFrame = nullptr;
     }
-    d->TargetWidget.clear();
+    d->setTargetWidget(nullptr);
+    d->DropAreaMemo.Valid = false;
     d->Cross->hide();
     d->Cross->show();
 }
@@ -384,7 +572,8 @@ void CDockOverlay::clearDockDropStrip()
 //============================================================================
 DockWidgetArea CDockOverlay::showOverlay(QWidget* target)
 {
-    d->TargetWidget = target;
+    ++d->DragStep;
+    d->setTargetWidget(target);
 
     if (d->LastlyHoveredDropArea.DockAreaWidget && !allowedAreas().testFlag(d->LastlyHoveredDropArea.Area))
     {
@@ -392,7 +581,7 @@ DockWidgetArea CDockOverlay::showOverlay(QWidget* target)
         return DockWidgetArea::NoDockWidgetArea;
     }
 
-    const QPoint pos = (QCursor::pos());
+    const QPoint pos = QCursor::pos();
 
     if (d->LastlyHoveredDropArea.DockAreaWidget) {
         auto position = d->LastlyHoveredDropArea.DockAreaWidget->mapToGlobal(QPoint());
@@ -414,7 +603,7 @@ DockWidgetArea CDockOverlay::showOverlay(QWidget* target)
     d->Cross->show();
     d->Cross->updatePosition();
 
-    auto area = d->Cross->cursorLocation();
+    auto area = d->Cross->d->cursorLocation(pos);
     auto item = d->Cross->d->DropIndicatorWidgets.value(area);
 
     auto calculateOverlayBounds = [this](const QRect& rect, DockWidgetArea area) -> std::optional<QRect> {
@@ -447,54 +636,10 @@ DockWidgetArea CDockOverlay::showOverlay(QWidget* target)
     if (item) {
         d->LastlyHoveredDropArea.Area = area;
         d->LastlyHoveredDropArea.DockAreaWidget = item;
-        d->LastlyHoveredDropArea.DockTargetFrame = new QFrame(d->Cross);
-
-        QString stops = (area == TopDockWidgetArea) ? "x1:0, y1:0, x2:0, y2:1" :
-                        (area == BottomDockWidgetArea) ? "x1:0, y1:1, x2:0, y2:0" :
-                        (area == LeftDockWidgetArea) ? "x1:0, y1:0, x2:1, y2:0" :
-                        (area == RightDockWidgetArea) ? "x1:1, y1:0, x2:0, y2:0" :
-                                                        "x1:1, y1:1, x2:1, y2:1";
 
         if (auto bounds = calculateOverlayBounds(item->geometry(), area); bounds.has_value())
         {
-            d->LastlyHoveredDropArea.DockTargetFrame->setGeometry(bounds.value());
-            // d->LastlyHoveredDropArea.DockTargetFrame->setGeometry(item->pos().x(), item->pos().y(), item->size().width(), item->size().height());
-            // d->LastlyHoveredDropArea.DockTargetFrame->resize(item->size());
-            // d->LastlyHoveredDropArea.DockTargetFrame->move(item->pos());
-            if (area == CenterDockWidgetArea)
-            {
-                d->LastlyHoveredDropArea.DockTargetFrame->setStyleSheet(
-                    QString(
-                        "QFrame {"
-                        "    border-top: %1px solid %3;"
-                        "    border-right: %2px solid %3;"
-                        "    border-bottom: %2px solid %3;"
-                        "    border-left: %2px solid %3;"
-                        "    background-color: transparent;"
-                        "}"
-                        ).arg(
-                            QString::number(ads::internal::DefaultDockTitleBarHeight),
-                            QString::number(int(ads::internal::DockingAreaStripDetectSize / 2)),
-                            ads::internal::HighlightDropAreaColorSpreadMiddle
-                        )
-                    );
-            }
-            else
-            {
-                d->LastlyHoveredDropArea.DockTargetFrame->setStyleSheet(
-                    QString(
-                        "QFrame {"
-                        "    background: qlineargradient("
-                        "        spread:pad, "
-                        "        %1, "
-                        "        stop:0 %2, "
-                        "        stop:1 %3 "
-                        "    );"
-                        "}"
-                    ).arg(stops, ads::internal::HighlightDropAreaColorSpreadStart, ads::internal::HighlightDropAreaColorSpreadEnd)
-                );
-            }
-            d->LastlyHoveredDropArea.DockTargetFrame->show();
+            d->LastlyHoveredDropArea.DockTargetFrame = d->showDropStripFrame(area, bounds.value());
         }
     } else {
         clearDockDropStrip();
@@ -510,7 +655,7 @@ void CDockOverlay::hideOverlay()
     clearDockDropStrip();
 
 	hide();
-	d->TargetWidget.clear();
+	d->setTargetWidget(nullptr);
 	d->LastLocation = InvalidDockWidgetArea;
 }
 
@@ -672,6 +817,103 @@ QRect DockOverlayCrossPrivate::areaGridPosition(const DockWidgetArea area)
 }
 
 
+//============================================================================
+const DockOverlayCrossPrivate::SCrossLayout& DockOverlayCrossPrivate::updateLayout()
+{
+	auto Size = _this->size();
+	auto AllowedAreas = DockOverlay->allowedAreas();
+	auto IsLayoutFor = [&](const SCrossLayout& Layout)
+	{
+		return Layout.Size == Size && Layout.Mode == Mode && Layout.AllowedAreas == AllowedAreas;
+	};
+
+	if (CurrentLayout >= 0 && IsLayoutFor(LayoutCache[CurrentLayout]))
+	{
+		return LayoutCache[CurrentLayout];
+	}
+
+	for (int i = 0; i < LayoutCache.count(); ++i)
+	{
+		if (IsLayoutFor(LayoutCache[i]))
+		{
+			CurrentLayout = i;
+			++LayoutSerial;
+			return LayoutCache[i];
+		}
+	}
+
+	// The indicator geometries only depend on the cross size, so they are
+	// read once from the grid layout and reused for every later target with
+	// the same size, mode and allowed areas
+	GridLayout->activate();
+	SCrossLayout Layout;
+	Layout.Size = Size;
+	Layout.Mode = Mode;
+	Layout.AllowedAreas = AllowedAreas;
+	for (auto it = DropIndicatorWidgets.cbegin(); it != DropIndicatorWidgets.cend(); ++it)
+	{
+		if (it.value() && AllowedAreas.testFlag(it.key()))
+		{
+			Layout.Indicators.append({it.key(), it.value()->geometry()});
+		}
+	}
+
+	if (LayoutCache.count() >= MaxCachedCrossLayouts)
+	{
+		LayoutCache.removeFirst();
+	}
+	LayoutCache.append(Layout);
+	CurrentLayout = LayoutCache.count() - 1;
+	++LayoutSerial;
+	return LayoutCache.last();
+}
+
+
+//============================================================================
+void DockOverlayCrossPrivate::clearLayoutCache()
+{
+	LayoutCache.clear();
+	CurrentLayout = -1;
+	++LayoutSerial;
+}
+
+
+//============================================================================
+DockWidgetArea DockOverlayCrossPrivate::cursorLocation(const QPoint& GlobalPos)
+{
+	if (!DockOverlay->d->TargetWidget || !_this->isVisible())
+	{
+		return InvalidDockWidgetArea;
+	}
+
+	const auto& Layout = updateLayout();
+	auto Origin = _this->mapToGlobal(QPoint(0, 0));
+	if (LocationMemo.Valid && LocationMemo.CursorPos == GlobalPos
+	 && LocationMemo.Origin == Origin && LocationMemo.LayoutSerial == LayoutSerial)
+	{
+		return LocationMemo.Area;
+	}
+
+	const QPoint pos = GlobalPos - Origin;
+	DockWidgetArea Result = InvalidDockWidgetArea;
+	for (const auto& Indicator : Layout.Indicators)
+	{
+		if (Indicator.Geometry.contains(pos))
+		{
+			Result = Indicator.Area;
+			break;
+		}
+	}
+
+	LocationMemo.Valid = true;
+	LocationMemo.CursorPos = GlobalPos;
+	LocationMemo.Origin = Origin;
+	LocationMemo.LayoutSerial = LayoutSerial;
+	LocationMemo.Area = Result;
+	return Result;
+}
+
+
 //============================================================================
 CDockOverlayCross::CDockOverlayCross(CDockOverlay* overlay) :
     QWidget(overlay),
@@ -808,6 +1050,7 @@ void CDockOverlayCross::setAreaWidgets(const QHash<DockWidgetArea, QWidget*>& wi
         auto p = d->areaGridPosition(area);
         d->GridLayout->addWidget(widget, p.x(), p.y(), p.width(), p.height());
 	}
+	d->clearLayoutCache();
     // d->GridLayout->setRowStretch(2, 1);
     // d->GridLayout->setColumnStretch(2, 1);
 
@@ -868,21 +1111,7 @@ void CDockOverlayCross::setAreaWidgets(const QHash<DockWidgetArea, QWidget*>& wi
 //============================================================================
 DockWidgetArea CDockOverlayCross::cursorLocation() const
 {
-	const QPoint pos = mapFromGlobal(QCursor::pos());
-    QHashIterator<DockWidgetArea, QWidget*> i(d->DropIndicatorWidgets);
-	while (i.hasNext())
-	{
-		i.next();
-		if (d->DockOverlay->allowedAreas().testFlag(i.key())
-			&& i.value()
-			&& i.value()->isVisible()
-			&& i.value()->geometry().contains(pos))
-		{
-            if (d->DockOverlay->d->TargetWidget)
-			return i.key();
-		}
-	}
-	return InvalidDockWidgetArea;
+	return d->cursorLocation(d->DockOverlay->d->cursorPos());
 }
 
 
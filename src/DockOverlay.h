@@ -46,9 +46,16 @@ class ADS_EXPORT CDockOverlay : public QFrame
 private:
 	DockOverlayPrivate* d; //< private data class
 	friend struct DockOverlayPrivate;
+	friend struct DockOverlayCrossPrivate;
 	friend class DockOverlayCross;
     friend class CDockOverlayCross;
 
+	/**
+	 * Computes the drop area under the given global cursor position
+	 * without using the memoized result
+	 */
+	DockWidgetArea computeDropAreaUnderCursor(const QPoint& CursorPos) const;
+
 public:
 	using Super = QFrame;
 
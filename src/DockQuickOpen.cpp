@@ -0,0 +1,838 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockQuickOpen.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockWidgetIndex and CDockQuickOpen classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockQuickOpen.h"
+
+#include <QBoxLayout>
+#include <QEvent>
+#include <QHash>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPointer>
+#include <QVariant>
+#include <QVector>
+
+#include <algorithm>
+
+#include "AutoHideDockContainer.h"
+#include "DockManager.h"
+#include "DockWidget.h"
+
+namespace ads
+{
+static const int TitleBonus = 50;
+static const int GroupPenalty = 50;
+static const int MaxFuzzyScore = 900;
+
+
+/**
+ * Returns the bit of the given character in the character mask of an
+ * entry. Letters and digits get their own bit, all other characters
+ * share the remaining bits.
+ */
+static quint64 charBit(QChar c)
+{
+	ushort u = c.unicode();
+	if (u >= 'a' && u <= 'z')
+	{
+		return quint64(1) << (u - 'a');
+	}
+	else if (u >= '0' && u <= '9')
+	{
+		return quint64(1) << (26 + u - '0');
+	}
+	else
+	{
+		return quint64(1) << (36 + u % 28);
+	}
+}
+
+
+/**
+ * Returns the mask of all characters of the given text
+ */
+static quint64 charMask(const QString& Text)
+{
+	quint64 Mask = 0;
+	for (auto c : Text)
+	{
+		if (!c.isSpace())
+		{
+			Mask |= charBit(c);
+		}
+	}
+	return Mask;
+}
+
+
+/**
+ * Returns the key of the trigram that starts at the given character
+ */
+static quint64 trigramKey(const QChar* c)
+{
+	return (quint64(c[0].unicode()) << 32) | (quint64(c[1].unicode()) << 16)
+		| quint64(c[2].unicode());
+}
+
+
+/**
+ * Returns true, if the character at the given position of Field starts a
+ * word
+ */
+static bool isWordStart(const QString& Field, int Pos)
+{
+	return Pos == 0 || !Field.at(Pos - 1).isLetterOrNumber();
+}
+
+
+/**
+ * Returns the score of one query word for one lower case field or -1 if
+ * the word does not match. Substring matches always score higher than
+ * fuzzy matches.
+ */
+static int wordScore(const QString& Field, const QString& Word)
+{
+	if (Field.isEmpty())
+	{
+		return -1;
+	}
+
+	int Pos = Field.indexOf(Word);
+	if (Pos >= 0)
+	{
+		int Score = 1000 - qMin(Pos, 100);
+		if (isWordStart(Field, Pos))
+		{
+			Score += 200;
+		}
+		if (Word.length() == Field.length())
+		{
+			Score += 300;
+		}
+		return Score;
+	}
+
+	// Fuzzy match - all characters of the word in the right order
+	int Score = 500;
+	int Last = -1;
+	for (auto c : Word)
+	{
+		int Found = Field.indexOf(c, Last + 1);
+		if (Found < 0)
+		{
+			return -1;
+		}
+
+		if (Last >= 0 && Found == Last + 1)
+		{
+			Score += 10;
+		}
+		else if (isWordStart(Field, Found))
+		{
+			Score += 8;
+		}
+		else
+		{
+			Score -= qMin(Found - Last - 1, 20);
+		}
+		Last = Found;
+	}
+	return qBound(1, Score, MaxFuzzyScore);
+}
+
+
+/**
+ * One indexed dock widget. The fields are stored in lower case.
+ */
+struct SIndexEntry
+{
+	CDockWidget* DockWidget = nullptr;
+	QString Title;
+	QString Name;
+	QString Group;
+	quint64 CharMask = 0;
+};
+
+
+/**
+ * Private data class of CDockWidgetIndex class (pimpl)
+ */
+struct DockWidgetIndexPrivate
+{
+	CDockWidgetIndex* _this;
+	CDockManager* DockManager;
+	QVector<SIndexEntry> Entries;
+	QVector<int> FreeEntries;
+	QHash<QObject*, int> EntryIds;
+	QHash<quint64, QVector<int>> Trigrams;
+
+	/**
+	 * Private data constructor
+	 */
+	DockWidgetIndexPrivate(CDockWidgetIndex* _public);
+
+	/**
+	 * Returns the sorted unique trigrams of all fields of the given entry
+	 */
+	QVector<quint64> entryTrigrams(const SIndexEntry& Entry) const;
+
+	/**
+	 * Reads the fields of the dock widget of the given entry and adds the
+	 * entry to the trigram posting lists
+	 */
+	void indexEntry(int Id);
+
+	/**
+	 * Removes the given entry from the trigram posting lists
+	 */
+	void unindexEntry(int Id);
+
+	/**
+	 * Adds the given dock widget to the index
+	 */
+	void addEntry(CDockWidget* DockWidget);
+
+	/**
+	 * Removes the given dock widget from the index
+	 */
+	void removeEntry(QObject* Object);
+
+	/**
+	 * Reindexes the given dock widget after a change of its title, object
+	 * name or group
+	 */
+	void updateEntry(CDockWidget* DockWidget);
+
+	/**
+	 * Returns the score of the given entry for the query words or 0 if
+	 * one of the words does not match
+	 */
+	int score(const SIndexEntry& Entry, const QStringList& Words) const;
+};
+// struct DockWidgetIndexPrivate
+
+
+//============================================================================
+DockWidgetIndexPrivate::DockWidgetIndexPrivate(CDockWidgetIndex* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+QVector<quint64> DockWidgetIndexPrivate::entryTrigrams(const SIndexEntry& Entry) const
+{
+	QVector<quint64> Result;
+	for (const auto* Field : {&Entry.Title, &Entry.Name, &Entry.Group})
+	{
+		for (int i = 0; i + 3 <= Field->length(); ++i)
+		{
+			Result.append(trigramKey(Field->constData() + i));
+		}
+	}
+	std::sort(Result.begin(), Result.end());
+	Result.erase(std::unique(Result.begin(), Result.end()), Result.end());
+	return Result;
+}
+
+
+//============================================================================
+void DockWidgetIndexPrivate::indexEntry(int Id)
+{
+	auto& Entry = Entries[Id];
+	auto DockWidget = Entry.DockWidget;
+	Entry.Title = DockWidget->windowTitle().toLower();
+	Entry.Name = DockWidget->objectName().toLower();
+	Entry.Group = DockWidget->property(internal::ViewMenuGroupProperty).toString().toLower();
+	Entry.CharMask = charMask(Entry.Title) | charMask(Entry.Name) | charMask(Entry.Group);
+	for (auto Key : entryTrigrams(Entry))
+	{
+		Trigrams[Key].append(Id);
+	}
+}
+
+
+//============================================================================
+void DockWidgetIndexPrivate::unindexEntry(int Id)
+{
+	for (auto Key : entryTrigrams(Entries[Id]))
+	{
+		auto it = Trigrams.find(Key);
+		if (it == Trigrams.end())
+		{
+			continue;
+		}
+
+		auto& Ids = it.value();
+		int Index = Ids.indexOf(Id);
+		if (Index >= 0)
+		{
+			Ids[Index] = Ids.last();
+			Ids.removeLast();
+		}
+		if (Ids.isEmpty())
+		{
+			Trigrams.erase(it);
+		}
+	}
+}
+
+
+//============================================================================
+void DockWidgetIndexPrivate::addEntry(CDockWidget* DockWidget)
+{
+	if (!DockWidget || EntryIds.contains(DockWidget))
+	{
+		return;
+	}
+
+	int Id;
+	if (FreeEntries.isEmpty())
+	{
+		Id = Entries.count();
+		Entries.append(SIndexEntry());
+	}
+	else
+	{
+		Id = FreeEntries.takeLast();
+	}
+	Entries[Id].DockWidget = DockWidget;
+	EntryIds.insert(DockWidget, Id);
+	indexEntry(Id);
+
+	QObject::connect(DockWidget, SIGNAL(titleChanged(QString)), _this, SLOT(onDockWidgetChanged()));
+	QObject::connect(DockWidget, SIGNAL(objectNameChanged(QString)), _this, SLOT(onDockWidgetChanged()));
+	QObject::connect(DockWidget, SIGNAL(destroyed(QObject*)), _this, SLOT(onDockWidgetDestroyed(QObject*)));
+}
+
+
+//============================================================================
+void DockWidgetIndexPrivate::removeEntry(QObject* Object)
+{
+	auto it = EntryIds.find(Object);
+	if (it == EntryIds.end())
+	{
+		return;
+	}
+
+	int Id = it.value();
+	EntryIds.erase(it);
+	unindexEntry(Id);
+	Entries[Id] = SIndexEntry();
+	FreeEntries.append(Id);
+}
+
+
+//============================================================================
+void DockWidgetIndexPrivate::updateEntry(CDockWidget* DockWidget)
+{
+	int Id = EntryIds.value(DockWidget, -1);
+	if (Id < 0)
+	{
+		return;
+	}
+
+	unindexEntry(Id);
+	indexEntry(Id);
+}
+
+
+//============================================================================
+int DockWidgetIndexPrivate::score(const SIndexEntry& Entry, const QStringList& Words) const
+{
+	int Result = 0;
+	for (const auto& Word : Words)
+	{
+		int Best = wordScore(Entry.Title, Word);
+		if (Best > 0)
+		{
+			Best += TitleBonus;
+		}
+		Best = qMax(Best, wordScore(Entry.Name, Word));
+		int GroupScore = wordScore(Entry.Group, Word);
+		if (GroupScore > GroupPenalty)
+		{
+			Best = qMax(Best, GroupScore - GroupPenalty);
+		}
+
+		if (Best <= 0)
+		{
+			return 0;
+		}
+		Result += Best;
+	}
+	return qMax(Result, 1);
+}
+
+
+//============================================================================
+CDockWidgetIndex::CDockWidgetIndex(CDockManager* DockManager) :
+	Super(DockManager),
+	d(new DockWidgetIndexPrivate(this))
+{
+	d->DockManager = DockManager;
+	const auto DockWidgets = DockManager->dockWidgetsMap();
+	d->Entries.reserve(DockWidgets.count());
+	for (auto DockWidget : DockWidgets)
+	{
+		d->addEntry(DockWidget);
+	}
+
+	connect(DockManager, SIGNAL(dockWidgetAdded(ads::CDockWidget*)),
+		SLOT(onDockWidgetAdded(ads::CDockWidget*)));
+	connect(DockManager, SIGNAL(dockWidgetAboutToBeRemoved(ads::CDockWidget*)),
+		SLOT(onDockWidgetRemoved(ads::CDockWidget*)));
+}
+
+
+//============================================================================
+CDockWidgetIndex::~CDockWidgetIndex()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CDockWidgetIndex::onDockWidgetAdded(CDockWidget* DockWidget)
+{
+	d->addEntry(DockWidget);
+}
+
+
+//============================================================================
+void CDockWidgetIndex::onDockWidgetRemoved(CDockWidget* DockWidget)
+{
+	if (DockWidget)
+	{
+		DockWidget->disconnect(this);
+	}
+	d->removeEntry(DockWidget);
+}
+
+
+//============================================================================
+void CDockWidgetIndex::onDockWidgetChanged()
+{
+	d->updateEntry(qobject_cast<CDockWidget*>(sender()));
+}
+
+
+//============================================================================
+void CDockWidgetIndex::onDockWidgetDestroyed(QObject* Object)
+{
+	d->removeEntry(Object);
+}
+
+
+//============================================================================
+void CDockWidgetIndex::updateDockWidget(CDockWidget* DockWidget)
+{
+	d->updateEntry(DockWidget);
+}
+
+
+//============================================================================
+int CDockWidgetIndex::count() const
+{
+	return d->EntryIds.count();
+}
+
+
+//============================================================================
+QList<CDockWidgetIndex::SMatch> CDockWidgetIndex::query(const QString& Text,
+	int MaxResults) const
+{
+	struct SCandidate
+	{
+		int Id;
+		int Score;
+	};
+
+	QList<SMatch> Result;
+	if (MaxResults <= 0)
+	{
+		return Result;
+	}
+
+#if (QT_VERSION < QT_VERSION_CHECK(5, 14, 0))
+	auto Words = Text.toLower().split(' ', QString::SkipEmptyParts);
+#else
+	auto Words = Text.toLower().split(' ', Qt::SkipEmptyParts);
+#endif
+	const auto& Entries = d->Entries;
+	QVector<SCandidate> Candidates;
+	if (Words.isEmpty())
+	{
+		Candidates.reserve(d->EntryIds.count());
+		for (int Id = 0; Id < Entries.count(); ++Id)
+		{
+			if (Entries[Id].DockWidget)
+			{
+				Candidates.append({Id, 1});
+			}
+		}
+	}
+	else
+	{
+		QVector<bool> Visited(Entries.count(), false);
+		const QString* Longest = &Words.first();
+		for (const auto& Word : Words)
+		{
+			if (Word.length() > Longest->length())
+			{
+				Longest = &Word;
+			}
+		}
+
+		// All entries that contain the longest word as a substring are in the
+		// smallest posting list of its trigrams. The posting list also
+		// contains entries that only match fuzzily, so the substring matches
+		// are counted separately.
+		int SubstringMatches = 0;
+		if (Longest->length() >= 3)
+		{
+			static const QVector<int> NoIds;
+			const QVector<int>* Ids = nullptr;
+			for (int i = 0; i + 3 <= Longest->length(); ++i)
+			{
+				auto it = d->Trigrams.constFind(trigramKey(Longest->constData() + i));
+				if (it == d->Trigrams.constEnd())
+				{
+					Ids = &NoIds;
+					break;
+				}
+				if (!Ids || it->count() < Ids->count())
+				{
+					Ids = &it.value();
+				}
+			}
+
+			for (auto Id : *Ids)
+			{
+				Visited[Id] = true;
+				const auto& Entry = Entries[Id];
+				int Score = d->score(Entry, Words);
+				if (Score <= 0)
+				{
+					continue;
+				}
+
+				Candidates.append({Id, Score});
+				if (Entry.Title.contains(*Longest) || Entry.Name.contains(*Longest)
+				 || Entry.Group.contains(*Longest))
+				{
+					++SubstringMatches;
+				}
+			}
+		}
+
+		// Fuzzy matches score lower than substring matches, so they are only
+		// searched if there are not enough substring matches
+		if (SubstringMatches < MaxResults)
+		{
+			auto Mask = charMask(Words.join(QString()));
+			for (int Id = 0; Id < Entries.count(); ++Id)
+			{
+				const auto& Entry = Entries[Id];
+				if (!Entry.DockWidget || Visited[Id] || (Entry.CharMask & Mask) != Mask)
+				{
+					continue;
+				}
+
+				int Score = d->score(Entry, Words);
+				if (Score > 0)
+				{
+					Candidates.append({Id, Score});
+				}
+			}
+		}
+	}
+
+	int Count = qMin(MaxResults, Candidates.count());
+	std::partial_sort(Candidates.begin(), Candidates.begin() + Count, Candidates.end(),
+		[&Entries](const SCandidate& a, const SCandidate& b)
+		{
+			if (a.Score != b.Score)
+			{
+				return a.Score > b.Score;
+			}
+			return Entries[a.Id].Title < Entries[b.Id].Title;
+		});
+
+	Result.reserve(Count);
+	for (int i = 0; i < Count; ++i)
+	{
+		Result.append({Entries[Candidates[i].Id].DockWidget, Candidates[i].Score});
+	}
+	return Result;
+}
+
+
+//============================================================================
+QList<CDockWidget*> CDockWidgetIndex::find(const QString& Text, int MaxResults) const
+{
+	QList<CDockWidget*> Result;
+	for (const auto& Match : query(Text, MaxResults))
+	{
+		Result.append(Match.DockWidget);
+	}
+	return Result;
+}
+
+
+/**
+ * Private data class of CDockQuickOpen class (pimpl)
+ */
+struct DockQuickOpenPrivate
+{
+	CDockQuickOpen* _this;
+	CDockManager* DockManager;
+	QLineEdit* SearchEdit = nullptr;
+	QListWidget* ResultList = nullptr;
+	QList<QPointer<CDockWidget>> Results;
+	int MaxResults = 50;
+
+	/**
+	 * Private data constructor
+	 */
+	DockQuickOpenPrivate(CDockQuickOpen* _public);
+
+	/**
+	 * Moves the current result by the given number of rows
+	 */
+	void moveSelection(int Delta);
+};
+// struct DockQuickOpenPrivate
+
+
+//============================================================================
+DockQuickOpenPrivate::DockQuickOpenPrivate(CDockQuickOpen* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void DockQuickOpenPrivate::moveSelection(int Delta)
+{
+	int Count = ResultList->count();
+	if (!Count)
+	{
+		return;
+	}
+
+	int Row = qBound(0, ResultList->currentRow() + Delta, Count - 1);
+	ResultList->setCurrentRow(Row);
+}
+
+
+//============================================================================
+CDockQuickOpen::CDockQuickOpen(CDockManager* DockManager, QWidget* Parent) :
+	Super(Parent ? Parent : DockManager, Qt::Popup),
+	d(new DockQuickOpenPrivate(this))
+{
+	d->DockManager = DockManager;
+	setObjectName("dockQuickOpen");
+	setFrameShape(QFrame::StyledPanel);
+
+	d->SearchEdit = new QLineEdit(this);
+	d->SearchEdit->setObjectName("dockQuickOpenSearchEdit");
+	d->SearchEdit->setPlaceholderText(tr("Search dock widgets"));
+	d->SearchEdit->setClearButtonEnabled(true);
+	d->SearchEdit->installEventFilter(this);
+
+	d->ResultList = new QListWidget(this);
+	d->ResultList->setObjectName("dockQuickOpenResultList");
+	d->ResultList->setUniformItemSizes(true);
+	d->ResultList->setFocusPolicy(Qt::NoFocus);
+
+	auto Layout = new QBoxLayout(QBoxLayout::TopToBottom);
+	Layout->setContentsMargins(4, 4, 4, 4);
+	Layout->setSpacing(4);
+	Layout->addWidget(d->SearchEdit);
+	Layout->addWidget(d->ResultList);
+	setLayout(Layout);
+
+	connect(d->SearchEdit, SIGNAL(textChanged(QString)), SLOT(updateResults()));
+	connect(d->SearchEdit, SIGNAL(returnPressed()), SLOT(onResultActivated()));
+	connect(d->ResultList, SIGNAL(itemClicked(QListWidgetItem*)), SLOT(onResultActivated()));
+}
+
+
+//============================================================================
+CDockQuickOpen::~CDockQuickOpen()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CDockQuickOpen::setMaxResults(int MaxResults)
+{
+	d->MaxResults = qMax(1, MaxResults);
+}
+
+
+//============================================================================
+int CDockQuickOpen::maxResults() const
+{
+	return d->MaxResults;
+}
+
+
+//============================================================================
+QString CDockQuickOpen::searchText() const
+{
+	return d->SearchEdit->text();
+}
+
+
+//============================================================================
+void CDockQuickOpen::setSearchText(const QString& Text)
+{
+	d->SearchEdit->setText(Text);
+}
+
+
+//============================================================================
+void CDockQuickOpen::updateResults()
+{
+	d->ResultList->clear();
+	d->Results.clear();
+	auto Matches = d->DockManager->dockWidgetIndex()->query(d->SearchEdit->text(),
+		d->MaxResults);
+	for (const auto& Match : Matches)
+	{
+		auto DockWidget = Match.DockWidget;
+		auto Item = new QListWidgetItem(DockWidget->icon(), DockWidget->windowTitle(),
+			d->ResultList);
+		Item->setToolTip(DockWidget->objectName());
+		d->Results.append(DockWidget);
+	}
+
+	if (d->ResultList->count())
+	{
+		d->ResultList->setCurrentRow(0);
+	}
+}
+
+
+//============================================================================
+void CDockQuickOpen::onResultActivated()
+{
+	int Row = d->ResultList->currentRow();
+	if (Row < 0 || Row >= d->Results.count())
+	{
+		return;
+	}
+
+	activateDockWidget(d->Results[Row]);
+}
+
+
+//============================================================================
+void CDockQuickOpen::activateDockWidget(CDockWidget* DockWidget)
+{
+	hide();
+	if (!DockWidget)
+	{
+		return;
+	}
+
+	DockWidget->toggleView(true);
+	if (DockWidget->isAutoHide())
+	{
+		DockWidget->autoHideDockContainer()->collapseView(false);
+	}
+	else
+	{
+		DockWidget->raise();
+	}
+
+	d->DockManager->setDockWidgetFocused(DockWidget);
+	if (DockWidget->widget())
+	{
+		DockWidget->widget()->setFocus(Qt::OtherFocusReason);
+	}
+	Q_EMIT dockWidgetActivated(DockWidget);
+}
+
+
+//============================================================================
+void CDockQuickOpen::popup()
+{
+	auto Window = d->DockManager->window();
+	int Width = qBound(300, Window->width() / 2, 800);
+	int Height = qBound(200, Window->height() / 2, 600);
+	resize(Width, Height);
+	move(Window->mapToGlobal(QPoint((Window->width() - Width) / 2,
+		qMin(50, Window->height() / 10))));
+
+	// Clearing the search field does not emit textChanged if it is already
+	// empty, so the results are updated explicitly
+	d->SearchEdit->blockSignals(true);
+	d->SearchEdit->clear();
+	d->SearchEdit->blockSignals(false);
+	updateResults();
+
+	show();
+	raise();
+	activateWindow();
+	d->SearchEdit->setFocus(Qt::PopupFocusReason);
+}
+
+
+//============================================================================
+bool CDockQuickOpen::eventFilter(QObject* watched, QEvent* event)
+{
+	if (watched != d->SearchEdit || event->type() != QEvent::KeyPress)
+	{
+		return Super::eventFilter(watched, event);
+	}
+
+	auto KeyEvent = static_cast<QKeyEvent*>(event);
+	switch (KeyEvent->key())
+	{
+	case Qt::Key_Up: d->moveSelection(-1); return true;
+	case Qt::Key_Down: d->moveSelection(1); return true;
+	case Qt::Key_PageUp: d->moveSelection(-10); return true;
+	case Qt::Key_PageDown: d->moveSelection(10); return true;
+	case Qt::Key_Escape: hide(); return true;
+	default:
+		break;
+	}
+	return Super::eventFilter(watched, event);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockQuickOpen.cpp
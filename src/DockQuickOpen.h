@@ -0,0 +1,210 @@
+#ifndef DockQuickOpenH
+#define DockQuickOpenH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockQuickOpen.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockWidgetIndex and CDockQuickOpen classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QFrame>
+#include <QList>
+#include <QString>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockWidgetIndexPrivate;
+struct DockQuickOpenPrivate;
+class CDockManager;
+class CDockWidget;
+
+/**
+ * Search index over the titles, object names and view menu groups of all
+ * dock widgets of a dock manager.
+ * The index is updated incrementally if a dock widget is registered,
+ * removed or deleted and if its title or object name changes. Queries
+ * are split into words and each word needs to match the title, the object
+ * name or the group of a dock widget. Exact substring matches are looked
+ * up via a trigram index. Fuzzy matches, where the characters of a word
+ * appear in the right order but not side by side, are found via a scan
+ * that skips all entries that do not contain the characters of the query.
+ * The results are ranked, so that matches at the start of a word and
+ * matches in the title come first.
+ * Use CDockManager::dockWidgetIndex() to access the index.
+ */
+class ADS_EXPORT CDockWidgetIndex : public QObject
+{
+	Q_OBJECT
+private:
+	DockWidgetIndexPrivate* d; ///< private data (pimpl)
+	friend struct DockWidgetIndexPrivate;
+	friend class CDockManager;
+
+private Q_SLOTS:
+	void onDockWidgetAdded(ads::CDockWidget* DockWidget);
+	void onDockWidgetRemoved(ads::CDockWidget* DockWidget);
+	void onDockWidgetChanged();
+	void onDockWidgetDestroyed(QObject* Object);
+
+protected:
+	/**
+	 * Updates the entry of the given dock widget. This is called by the
+	 * dock manager if the toggle view action of the dock widget is added
+	 * to a view menu group.
+	 */
+	void updateDockWidget(CDockWidget* DockWidget);
+
+public:
+	using Super = QObject;
+
+	/**
+	 * One ranked query result
+	 */
+	struct SMatch
+	{
+		CDockWidget* DockWidget;
+		int Score;
+	};
+
+	/**
+	 * Creates the index for all dock widgets of the given dock manager
+	 */
+	CDockWidgetIndex(CDockManager* DockManager);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockWidgetIndex();
+
+	/**
+	 * Returns the number of indexed dock widgets
+	 */
+	int count() const;
+
+	/**
+	 * Returns the best matches for the given query, ordered by descending
+	 * score. An empty query returns the first dock widgets in the order of
+	 * their titles.
+	 */
+	QList<SMatch> query(const QString& Text, int MaxResults = 50) const;
+
+	/**
+	 * Convenience function that returns the dock widgets of query()
+	 */
+	QList<CDockWidget*> find(const QString& Text, int MaxResults = 50) const;
+}; // class CDockWidgetIndex
+
+
+/**
+ * Quick open palette that lets the user search all dock widgets of a dock
+ * manager by typing a part of their title, object name or group.
+ * The palette is a popup with a search field and a ranked result list
+ * that is backed by the CDockWidgetIndex of the dock manager. Selecting a
+ * result shows, raises and focuses the dock widget. The palette is
+ * optional - create it and connect popup() to a shortcut of your
+ * application:
+ * \code
+ * auto QuickOpen = new CDockQuickOpen(DockManager);
+ * auto Shortcut = new QShortcut(QKeySequence("Ctrl+P"), MainWindow);
+ * connect(Shortcut, SIGNAL(activated()), QuickOpen, SLOT(popup()));
+ * \endcode
+ */
+class ADS_EXPORT CDockQuickOpen : public QFrame
+{
+	Q_OBJECT
+private:
+	DockQuickOpenPrivate* d; ///< private data (pimpl)
+	friend struct DockQuickOpenPrivate;
+
+private Q_SLOTS:
+	void updateResults();
+	void onResultActivated();
+
+protected:
+	/**
+	 * Handles the navigation keys of the search field
+	 */
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+public:
+	using Super = QFrame;
+
+	/**
+	 * Creates the palette for the given dock manager. If no parent is
+	 * given, the dock manager is the parent.
+	 */
+	CDockQuickOpen(CDockManager* DockManager, QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockQuickOpen();
+
+	/**
+	 * Sets the maximum number of results that are shown. The default is 50.
+	 */
+	void setMaxResults(int MaxResults);
+
+	/**
+	 * Returns the maximum number of results that are shown
+	 */
+	int maxResults() const;
+
+	/**
+	 * Returns the current search text
+	 */
+	QString searchText() const;
+
+	/**
+	 * Shows, raises and focuses the given dock widget and closes the
+	 * palette
+	 */
+	void activateDockWidget(CDockWidget* DockWidget);
+
+public Q_SLOTS:
+	/**
+	 * Shows the palette at the top of the dock manager window with an
+	 * empty search field
+	 */
+	void popup();
+
+	/**
+	 * Sets the search text and updates the result list
+	 */
+	void setSearchText(const QString& Text);
+
+Q_SIGNALS:
+	/**
+	 * This signal is emitted if the user selected a dock widget
+	 */
+	void dockWidgetActivated(ads::CDockWidget* DockWidget);
+}; // class CDockQuickOpen
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockQuickOpenH
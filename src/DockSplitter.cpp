@@ -33,6 +33,7 @@
 #include <QChildEvent>
 #include <QVariant>
 #include "DockAreaWidget.h"
+#include "DockMemoryUsage.h"
 
 namespace ads
 {
@@ -116,6 +117,13 @@ bool CDockSplitter::isResizingWithContainer() const
     return false;
 }
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CDockSplitter*)
+{
+	return sizeof(DockSplitterPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #include "AutoHideDockContainer.h"
 #include "AutoHideSideBar.h"
 #include "AutoHideTab.h"
+#include "DockMemoryUsage.h"
 #include "DockWidgetTab.h"
 #include "DockWidget.h"
 
@@ -57,7 +58,9 @@
 #include "DockManager.h"
 #include "FloatingDockContainer.h"
 #include "DockSplitter.h"
+#include "DockLayoutSnapshot.h"
 #include "DockComponentsFactory.h"
+#include "DockFocusController.h"
 #include "ads_globals.h"
 #include "FloatingDragPreview.h"
 
@@ -79,28 +82,34 @@ struct DockWidgetPrivate
 	QBoxLayout* Layout = nullptr;
 	QWidget* Widget = nullptr;
 	CDockWidgetTab* TabWidget = nullptr;
-	CDockWidget::DockWidgetFeatures Features = CDockWidget::DefaultDockWidgetFeatures;
 	QPointer<CDockManager> DockManager;
 	QPointer<CDockAreaWidget> DockArea;
-	QAction* ToggleViewAction = nullptr;
+	QAction* ToggleViewAction = nullptr; // created on first use
     CFloatingDragPreview* CurrentFloating = nullptr;
-    QPoint DragStartMousePos;
-    bool CanDragStart = false;
-    bool IsFrameless = false;
-	bool Closed = false;
 	QScrollArea* ScrollArea = nullptr;
 	QFrame* TitleBarFrame = nullptr;
     QWidget* TitleBar = nullptr;
-	Qt::ToolButtonStyle ToolBarStyleDocked = Qt::ToolButtonIconOnly;
-	Qt::ToolButtonStyle ToolBarStyleFloating = Qt::ToolButtonTextUnderIcon;
-	QSize TitleBarIconSizeDocked = QSize(16, 16);
-	QSize TitleBarIconSizeFloating = QSize(24, 24);
-	bool IsFloatingTopLevel = false;
 	QList<QAction*> TitleBarActions;
-	CDockWidget::eMinimumSizeHintMode MinimumSizeHintMode = CDockWidget::MinimumSizeHintFromDockWidget;
 	WidgetFactory* Factory = nullptr;
 	QPointer<CAutoHideTab> SideTabWidget;
+	QPointer<QWidget> TopLevelWindow;
+    QPoint DragStartMousePos;
+	QSize TitleBarIconSizeDocked = QSize(16, 16);
+	QSize TitleBarIconSizeFloating = QSize(24, 24);
+	CDockWidget::DockWidgetFeatures Features = CDockWidget::DefaultDockWidgetFeatures;
+	int Handle = -1;
+	Qt::ToolButtonStyle ToolBarStyleDocked = Qt::ToolButtonIconOnly;
+	Qt::ToolButtonStyle ToolBarStyleFloating = Qt::ToolButtonTextUnderIcon;
+	CDockWidget::eMinimumSizeHintMode MinimumSizeHintMode = CDockWidget::MinimumSizeHintFromDockWidget;
 	CDockWidget::eTitleBarStyleSource ToolBarStyleSource = CDockWidget::ToolBarStyleFromDockManager;
+	// Flags last, so they are packed without padding
+    bool CanDragStart = false;
+    bool IsFrameless = false;
+	bool Closed = false;
+	bool IsFloatingTopLevel = false;
+	bool EffectivelyVisible = false;
+	bool ToggleViewActionChecked = false;
+	bool ToggleViewActionCheckable = true;
 	
 	/**
 	 * Private data constructor
@@ -150,6 +159,40 @@ struct DockWidgetPrivate
 	 * Use the dock manager toolbar style and icon size for the different states
 	 */
 	void setToolBarStyleFromDockManager();
+
+	/**
+	 * Watches the window state of the current top level window to detect
+	 * minimizing of the window
+	 */
+	void updateTopLevelWindow();
+
+	/**
+	 * Pauses or resumes the content widget if it implements the
+	 * IDockWidgetContent interface
+	 */
+	void setContentActive(bool Active);
+
+	/**
+	 * Returns the toggle view action and creates it on first use. Many
+	 * applications never use the action of most dock widgets, so it is not
+	 * created together with the dock widget.
+	 */
+	QAction* toggleViewAction();
+
+	/**
+	 * Returns the checked state of the toggle view action without creating
+	 * the action
+	 */
+	bool isToggleViewActionChecked() const
+	{
+		return ToggleViewAction ? ToggleViewAction->isChecked() : ToggleViewActionChecked;
+	}
+
+	/**
+	 * Changes the checked state of the toggle view action without emitting
+	 * any signal
+	 */
+	void setToggleViewActionChecked(bool Checked);
 };
 // struct DockWidgetPrivate
 
@@ -177,7 +220,7 @@ void DockWidgetPrivate::showDockWidget()
 	
 	if (!DockArea)
 	{
-		CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(_this);
+		CFloatingDockContainer* FloatingWidget = CFloatingDockContainer::create(_this);
 		// We use the size hint of the content widget to provide a good
 		// initial size
 		FloatingWidget->resize(Widget ? Widget->sizeHint() : _this->sizeHint());
@@ -362,6 +405,80 @@ void DockWidgetPrivate::setToolBarStyleFromDockManager()
 }
 
 
+//============================================================================
+void DockWidgetPrivate::updateTopLevelWindow()
+{
+	auto Window = _this->window();
+	if (Window == _this || Window == TopLevelWindow)
+	{
+		return;
+	}
+
+	if (TopLevelWindow)
+	{
+		TopLevelWindow->removeEventFilter(_this);
+	}
+	TopLevelWindow = Window;
+	TopLevelWindow->installEventFilter(_this);
+}
+
+
+//============================================================================
+QAction* DockWidgetPrivate::toggleViewAction()
+{
+	if (ToggleViewAction)
+	{
+		return ToggleViewAction;
+	}
+
+	ToggleViewAction = new QAction(_this->windowTitle(), _this);
+	ToggleViewAction->setCheckable(ToggleViewActionCheckable);
+	ToggleViewAction->setChecked(ToggleViewActionChecked);
+	if (!ToggleViewActionCheckable)
+	{
+		ToggleViewAction->setIcon(TabWidget->icon());
+	}
+#ifndef QT_NO_TOOLTIP
+	ToggleViewAction->setToolTip(TabWidget->toolTip());
+#endif
+	_this->connect(ToggleViewAction, SIGNAL(triggered(bool)), SLOT(toggleView(bool)));
+	return ToggleViewAction;
+}
+
+
+//============================================================================
+void DockWidgetPrivate::setToggleViewActionChecked(bool Checked)
+{
+	ToggleViewActionChecked = Checked;
+	if (ToggleViewAction)
+	{
+		ToggleViewAction->blockSignals(true);
+		ToggleViewAction->setChecked(Checked);
+		ToggleViewAction->blockSignals(false);
+	}
+}
+
+
+//============================================================================
+void DockWidgetPrivate::setContentActive(bool Active)
+{
+	auto Content = dynamic_cast<IDockWidgetContent*>(Widget);
+	if (!Content)
+	{
+		return;
+	}
+
+	if (Active)
+	{
+		Content->resumeContent();
+	}
+	else
+	{
+		Content->pauseContent();
+	}
+}
+
+
 //============================================================================
 CDockWidget::CDockWidget(const QString &title, bool frameless, QWidget *parent) :
 	QFrame(parent),
@@ -376,11 +493,6 @@ CDockWidget::CDockWidget(const QString &title, bool frameless, QWidget *parent)
 	setObjectName(title);
 
 	d->TabWidget = componentsFactory()->createDockWidgetTab(this);
-
-	d->ToggleViewAction = new QAction(title, this);
-	d->ToggleViewAction->setCheckable(true);
-	connect(d->ToggleViewAction, SIGNAL(triggered(bool)), this,
-		SLOT(toggleView(bool)));
 	setTitleBarFloatingStyle(false);
 
 	if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
@@ -409,8 +521,11 @@ void CDockWidget::setToggleViewAction(QAction* action)
 		return;
 	}
 
-	d->ToggleViewAction->setParent(nullptr);
-	delete d->ToggleViewAction;
+	if (d->ToggleViewAction)
+	{
+		d->ToggleViewAction->setParent(nullptr);
+		delete d->ToggleViewAction;
+	}
 	d->ToggleViewAction = action;
 	d->ToggleViewAction->setParent(this);
 	connect(d->ToggleViewAction, &QAction::triggered, this, &CDockWidget::toggleView);
@@ -419,10 +534,14 @@ void CDockWidget::setToggleViewAction(QAction* action)
 //============================================================================
 void CDockWidget::setToggleViewActionChecked(bool Checked)
 {
-	QAction* Action = d->ToggleViewAction;
-	Action->blockSignals(true);
-	Action->setChecked(Checked);
-	Action->blockSignals(false);
+	d->setToggleViewActionChecked(Checked);
+}
+
+
+//============================================================================
+bool CDockWidget::isToggleViewActionChecked() const
+{
+	return d->isToggleViewActionChecked();
 }
 
 
@@ -451,6 +570,12 @@ void CDockWidget::setWidget(QWidget* widget, eInsertMode InsertMode)
 
 	d->Widget = widget;
 	d->Widget->setProperty("dockWidgetContent", true);
+	// New content is expected to be active, so we need to pause it if it
+	// can not be seen
+	if (!d->EffectivelyVisible)
+	{
+		d->setContentActive(false);
+	}
 }
 
 //============================================================================
@@ -468,6 +593,17 @@ void CDockWidget::setWidgetFactory(FactoryFunc createWidget, eInsertMode insertM
 //============================================================================
 QWidget* CDockWidget::takeWidget()
 {
+	if (d->Widget && d->DockManager && d->DockManager->dockFocusController())
+	{
+		d->DockManager->dockFocusController()->notifyDockWidgetContentChanged(this);
+	}
+
+	// The content leaves the dock widget in its active state
+	if (!d->EffectivelyVisible)
+	{
+		d->setContentActive(true);
+	}
+
 	QWidget* w = nullptr;
 	if (d->ScrollArea)
 	{
@@ -572,9 +708,21 @@ CDockManager* CDockWidget::dockManager() const
 }
 
 
+//============================================================================
+int CDockWidget::handle() const
+{
+	return d->Handle;
+}
+
+
 //============================================================================
 void CDockWidget::setDockManager(CDockManager* DockManager)
 {
+	if (d->DockManager && d->DockManager != DockManager
+	 && d->DockManager->dockFocusController())
+	{
+		d->DockManager->dockFocusController()->notifyDockWidgetContentChanged(this);
+	}
 	d->DockManager = DockManager;
 	if (!DockManager)
 	{
@@ -689,13 +837,19 @@ bool CDockWidget::isClosed() const
 //============================================================================
 QAction* CDockWidget::toggleViewAction() const
 {
-	return d->ToggleViewAction;
+	return d->toggleViewAction();
 }
 
 
 //============================================================================
 void CDockWidget::setToggleViewActionMode(eToggleViewActionMode Mode)
 {
+	d->ToggleViewActionCheckable = (ActionModeToggle == Mode);
+	if (!d->ToggleViewAction)
+	{
+		return;
+	}
+
 	if (ActionModeToggle == Mode)
 	{
 		d->ToggleViewAction->setCheckable(true);
@@ -736,7 +890,7 @@ void CDockWidget::toggleView(bool Open)
 	// If the toggle view action mode is ActionModeShow, then Open is always
 	// true if the sender is the toggle view action
 	QAction* Sender = qobject_cast<QAction*>(sender());
-	if (Sender == d->ToggleViewAction && !d->ToggleViewAction->isCheckable())
+	if (Sender && Sender == d->ToggleViewAction && !d->ToggleViewAction->isCheckable())
 	{
 		Open = true;
 	}
@@ -769,6 +923,10 @@ void CDockWidget::toggleViewInternal(bool Open)
 		? DockContainer->topLevelDockWidget() : nullptr;
 
 	d->Closed = !Open;
+	if (d->DockManager)
+	{
+		d->DockManager->markLayoutDirty();
+	}
 
 	if (Open)
 	{
@@ -779,9 +937,7 @@ void CDockWidget::toggleViewInternal(bool Open)
 		d->hideDockWidget();
 	}
 
-	d->ToggleViewAction->blockSignals(true);
-	d->ToggleViewAction->setChecked(Open);
-	d->ToggleViewAction->blockSignals(false);
+	d->setToggleViewActionChecked(Open);
 	if (d->DockArea)
 	{
 		d->DockArea->toggleDockWidgetView(this, Open);
@@ -824,14 +980,19 @@ void CDockWidget::setDockArea(CDockAreaWidget* DockArea)
     if (DockArea == nullptr) return;
 
     DockArea->setDockAreaFlag(ads::CDockAreaWidget::HideSingleWidgetTitleBar, true);
-    DockArea->titleBarButton(TitleBarButtonClose)->setVisible(false);
-    DockArea->titleBarButton(TitleBarButtonUndock)->setVisible(false);
-    DockArea->titleBarButton(TitleBarButtonTabsMenu)->setVisible(false);
-    DockArea->titleBarButton(TitleBarButtonMinimize)->setVisible(false);
-    DockArea->titleBarButton(TitleBarButtonAutoHide)->setVisible(false);
+    auto TitleBar = DockArea->titleBar();
+    TitleBar->setButtonVisible(TitleBarButtonClose, false);
+    TitleBar->setButtonVisible(TitleBarButtonUndock, false);
+    TitleBar->setButtonVisible(TitleBarButtonTabsMenu, false);
+    TitleBar->setButtonVisible(TitleBarButtonMinimize, false);
+    TitleBar->setButtonVisible(TitleBarButtonAutoHide, false);
 
 	d->DockArea = DockArea;
-	d->ToggleViewAction->setChecked(DockArea != nullptr && !this->isClosed());
+	d->ToggleViewActionChecked = (DockArea != nullptr && !this->isClosed());
+	if (d->ToggleViewAction)
+	{
+		d->ToggleViewAction->setChecked(d->ToggleViewActionChecked);
+	}
 	setParent(DockArea);
 }
 
@@ -839,10 +1000,7 @@ void CDockWidget::setDockArea(CDockAreaWidget* DockArea)
 //============================================================================
 void CDockWidget::saveState(QXmlStreamWriter& s) const
 {
-	s.writeStartElement("Widget");
-	s.writeAttribute("Name", objectName());
-	s.writeAttribute("Closed", QString::number(d->Closed ? 1 : 0));
-	s.writeEndElement();
+	CDockLayoutSnapshot::createDockWidget(objectName(), d->Closed).writeState(s);
 }
 
 
@@ -864,10 +1022,13 @@ bool CDockWidget::event(QEvent *e)
 	{
 	case QEvent::Hide:
 		Q_EMIT visibilityChanged(false);
+		updateEffectiveVisibility();
 		break;
 
 	case QEvent::Show:
 		Q_EMIT visibilityChanged(geometry().right() >= 0 && geometry().bottom() >= 0);
+		d->updateTopLevelWindow();
+		updateEffectiveVisibility();
 		break;
 
 	case QEvent::WindowTitleChange :
@@ -913,6 +1074,16 @@ bool CDockWidget::eventFilter(QObject *watched, QEvent *event)
         return false;
     }
 
+    // The top level window is only watched to detect minimizing
+    if (watched == d->TopLevelWindow)
+    {
+        if (event->type() == QEvent::WindowStateChange)
+        {
+            updateEffectiveVisibility();
+        }
+        return false;
+    }
+
     bool eventHandled = false;
     
     if (isTabbed())
@@ -1034,7 +1205,7 @@ void CDockWidget::setIcon(const QIcon& Icon)
 		d->SideTabWidget->setIcon(Icon);
 	}
 
-	if (!d->ToggleViewAction->isCheckable())
+	if (d->ToggleViewAction && !d->ToggleViewAction->isCheckable())
 	{
 		d->ToggleViewAction->setIcon(Icon);
 	}
@@ -1190,6 +1361,13 @@ void CDockWidget::setClosedState(bool Closed)
 }
 
 
+//============================================================================
+void CDockWidget::setHandle(int Handle)
+{
+	d->Handle = Handle;
+}
+
+
 //============================================================================
 QSize CDockWidget::minimumSizeHint() const
 {
@@ -1391,6 +1569,32 @@ bool CDockWidget::isCurrentTab() const
 }
 
 
+//============================================================================
+bool CDockWidget::isEffectivelyVisible() const
+{
+	return d->EffectivelyVisible;
+}
+
+
+//============================================================================
+void CDockWidget::updateEffectiveVisibility()
+{
+	// isVisible() already covers closed dock widgets, non current tabs and
+	// collapsed auto hide containers because all of them are hidden
+	bool Visible = !d->Closed && isVisible()
+		&& !(d->TopLevelWindow && d->TopLevelWindow->isMinimized())
+		&& !(d->DockArea && d->DockArea->isConvered());
+	if (Visible == d->EffectivelyVisible)
+	{
+		return;
+	}
+
+	d->EffectivelyVisible = Visible;
+	d->setContentActive(Visible);
+	Q_EMIT effectiveVisibilityChanged(Visible);
+}
+
+
 //============================================================================
 void CDockWidget::raise()
 {
@@ -1412,7 +1616,7 @@ void CDockWidget::raise()
 //============================================================================
 void CDockWidget::setAutoHide(bool Enable, SideBarLocation Location, int TabIndex)
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
+	if (!CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHideFeatureEnabled))
 	{
 		return;
 	}
@@ -1444,7 +1648,7 @@ void CDockWidget::setAutoHide(bool Enable, SideBarLocation Location, int TabInde
 //============================================================================
 void CDockWidget::toggleAutoHide(SideBarLocation Location)
 {
-	if (!CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
+	if (!CDockManager::testAutoHideConfigFlag(d->DockManager, CDockManager::AutoHideFeatureEnabled))
 	{
 		return;
 	}
@@ -1471,6 +1675,12 @@ CDockWidget::eTitleBarStyleSource CDockWidget::toolBarStyleSource() const
 }
 
 
+//============================================================================
+std::size_t internal::privateDataSize(const CDockWidget*)
+{
+	return sizeof(DockWidgetPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
@@ -49,6 +49,33 @@ class CAutoHideTab;
 class CAutoHideDockContainer;
 class CAutoHideSideBar;
 
+/**
+ * Optional interface for content widgets of dock widgets.
+ * If the content widget of a dock widget implements this interface, the
+ * dock widget calls pauseContent() if the content becomes effectively
+ * invisible and resumeContent() if it becomes visible again.
+ * Content widgets like live plots or video views should stop their timers
+ * and rendering in pauseContent() to not waste any CPU time for content
+ * that can not be seen.
+ * \see CDockWidget::isEffectivelyVisible()
+ */
+class ADS_EXPORT IDockWidgetContent
+{
+public:
+	virtual ~IDockWidgetContent() = default;
+
+	/**
+	 * Called if the content becomes effectively invisible
+	 */
+	virtual void pauseContent() = 0;
+
+	/**
+	 * Called if the content becomes effectively visible again
+	 */
+	virtual void resumeContent() = 0;
+};
+
+
 /**
  * The QDockWidget class provides a widget that can be docked inside a
  * CDockManager or floated as a top-level window on the desktop.
@@ -99,6 +126,12 @@ protected:
      */
     void setToggleViewActionChecked(bool Checked);
 
+    /**
+     * Returns the checked state of the toggle view action. In contrast to
+     * toggleViewAction()->isChecked() this does not create the action.
+     */
+    bool isToggleViewActionChecked() const;
+
     /**
      * Saves the state into the given stream
      */
@@ -128,12 +161,23 @@ protected:
      */
     void emitTopLevelChanged(bool Floating);
 
+    /**
+     * Recalculates the effective visibility and emits the
+     * effectiveVisibilityChanged() signal if it changed
+     */
+    void updateEffectiveVisibility();
+
     /**
      * Internal function for modifying the closed state when restoring
      * a saved docking state
      */
     void setClosedState(bool Closed);
 
+    /**
+     * Internal function for assigning the handle of this dock widget
+     */
+    void setHandle(int Handle);
+
     /**
      * Internal toggle view function that does not check if the widget
      * already is in the given state
@@ -347,6 +391,14 @@ public:
      */
     CDockManager* dockManager() const;
 
+    /**
+     * Returns the handle that the dock manager assigned to this dock widget
+     * or -1 if the dock widget is not registered in a dock manager.
+     * The handle does not change as long as the dock widget is registered.
+     * \see CDockManager::findDockWidget(int)
+     */
+    int handle() const;
+
     /**
      * Returns the dock container widget this dock area widget belongs to or 0
      * if this dock widget has not been docked yet
@@ -570,6 +622,16 @@ public:
      */
     bool isCurrentTab() const;
 
+    /**
+     * Returns true, if the content of this dock widget can be seen by the
+     * user. A dock widget is not effectively visible, if it is closed,
+     * if it is a non current tab, if it is in a collapsed auto hide
+     * container, if its window is minimized or if its dock area is
+     * covered.
+     * \see effectiveVisibilityChanged(), IDockWidgetContent
+     */
+    bool isEffectivelyVisible() const;
+
 public: // reimplements QFrame -----------------------------------------------
     /**
      * Emits titleChanged signal if title change event occurs
@@ -696,6 +758,13 @@ Q_SIGNALS:
      */
     void visibilityChanged(bool visible);
 
+    /**
+     * This signal is emitted if the effective visibility of the dock widget
+     * content changed.
+     * \see isEffectivelyVisible()
+     */
+    void effectiveVisibilityChanged(bool visible);
+
     /**
      * This signal is emitted when the features property changes.
      * The features parameter gives the new value of the property.
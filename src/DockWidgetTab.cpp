@@ -29,6 +29,7 @@
 //                                   INCLUDES
 //============================================================================
 #include "AutoHideDockContainer.h"
+#include "DockMemoryUsage.h"
 #include "FloatingDragPreview.h"
 #include "ElidingLabel.h"
 #include "DockWidgetTab.h"
@@ -66,17 +67,18 @@ struct DockWidgetTabPrivate
 	CDockWidget* DockWidget;
 	QLabel* IconLabel = nullptr;
 	tTabLabel* TitleLabel;
-	QPoint GlobalDragStartMousePosition;
-	QPoint DragStartMousePosition;
-	bool IsActiveTab = false;
 	CDockAreaWidget* DockArea = nullptr;
-	eDragState DragState = DraggingInactive;
 	IFloatingWidget* FloatingWidget = nullptr;
-	QIcon Icon;
 	QAbstractButton* CloseButton = nullptr;
-	QSpacerItem* IconTextSpacer;
+	QMenu* ContextMenu = nullptr;
+	QIcon Icon;
+	QPoint GlobalDragStartMousePosition;
+	QPoint DragStartMousePosition;
 	QPoint TabDragStartPosition;
 	QSize IconSize;
+	eDragState DragState = DraggingInactive;
+	int ContextMenuKey = -1;
+	bool IsActiveTab = false;
 
 	/**
 	 * Private data constructor
@@ -110,11 +112,21 @@ struct DockWidgetTabPrivate
     IFloatingWidget* startFloating(eDragState DraggingState = DraggingFloatingWidget, const QPoint& pos = QPoint(-1, -1));
 
 	/**
-	 * Returns true if the given config flag is set
+	 * Returns true if the given config flag is set for the dock manager of
+	 * the dock widget
 	 */
 	bool testConfigFlag(CDockManager::eConfigFlag Flag) const
 	{
-		return CDockManager::testConfigFlag(Flag);
+		return CDockManager::testConfigFlag(DockWidget ? DockWidget->dockManager() : nullptr, Flag);
+	}
+
+	/**
+	 * Returns true if the given auto hide config flag is set for the dock
+	 * manager of the dock widget
+	 */
+	bool testAutoHideConfigFlag(CDockManager::eAutoHideFlag Flag) const
+	{
+		return CDockManager::testAutoHideConfigFlag(DockWidget ? DockWidget->dockManager() : nullptr, Flag);
 	}
 
 	/**
@@ -134,6 +146,21 @@ struct DockWidgetTabPrivate
 		}
 	}
 
+	/**
+	 * Returns true, if a hidden close button should still occupy its space
+	 */
+	bool retainCloseButtonSize() const
+	{
+		return DockWidget->features().testFlag(CDockWidget::DockWidgetClosable)
+			&& testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden);
+	}
+
+	/**
+	 * Creates the close button when it is needed for the first time. Most
+	 * tabs of large layouts never show a close button.
+	 */
+	QAbstractButton* ensureCloseButton();
+
 	/**
 	 * Update the close button visibility from current feature/config
 	 */
@@ -143,7 +170,12 @@ struct DockWidgetTabPrivate
 		bool ActiveTabHasCloseButton = testConfigFlag(CDockManager::ActiveTabHasCloseButton);
 		bool AllTabsHaveCloseButton = testConfigFlag(CDockManager::AllTabsHaveCloseButton);
 		bool TabHasCloseButton = (ActiveTabHasCloseButton && active) | AllTabsHaveCloseButton;
-		CloseButton->setVisible(DockWidgetClosable && TabHasCloseButton);
+		bool Visible = DockWidgetClosable && TabHasCloseButton;
+		if (!CloseButton && !Visible && !retainCloseButtonSize())
+		{
+			return;
+		}
+		ensureCloseButton()->setVisible(Visible);
 	}
 
 	/**
@@ -152,19 +184,27 @@ struct DockWidgetTabPrivate
 	 */
 	void updateCloseButtonSizePolicy()
 	{
-		auto Features = DockWidget->features();
+		if (!CloseButton)
+		{
+			return;
+		}
 		auto SizePolicy = CloseButton->sizePolicy();
-		SizePolicy.setRetainSizeWhenHidden(Features.testFlag(CDockWidget::DockWidgetClosable)
-			&& testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden));
+		SizePolicy.setRetainSizeWhenHidden(retainCloseButtonSize());
 		CloseButton->setSizePolicy(SizePolicy);
 	}
 
+	/**
+	 * Returns the context menu. The menu is built on first use and only
+	 * rebuilt if the state that affects its entries changes.
+	 */
+	QMenu* contextMenu();
+
 	template <typename T>
 	IFloatingWidget* createFloatingWidget(T* Widget, bool CreateContainer)
 	{
 		if (CreateContainer)
 		{
-			return new CFloatingDockContainer(Widget);
+			return CFloatingDockContainer::create(Widget);
 		}
 		else
 		{
@@ -239,11 +279,92 @@ DockWidgetTabPrivate::DockWidgetTabPrivate(CDockWidgetTab* _public) :
 }
 
 
+//============================================================================
+QAbstractButton* DockWidgetTabPrivate::ensureCloseButton()
+{
+	if (CloseButton)
+	{
+		return CloseButton;
+	}
+
+	CloseButton = createCloseButton();
+	CloseButton->setObjectName("tabCloseButton");
+	internal::setButtonIcon(CloseButton, QStyle::SP_TitleBarCloseButton, TabCloseIcon);
+    CloseButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    CloseButton->setFocusPolicy(Qt::NoFocus);
+    updateCloseButtonSizePolicy();
+	internal::setToolTip(CloseButton, QObject::tr("Close Tab"));
+	_this->connect(CloseButton, SIGNAL(clicked()), SIGNAL(closeRequested()));
+	// The close button is placed between the spacing behind the title label
+	// and the trailing spacing. An icon label and its spacing may have been
+	// inserted in front of the title label.
+	auto Layout = qobject_cast<QBoxLayout*>(_this->layout());
+	Layout->insertWidget(Layout->indexOf(TitleLabel) + 2, CloseButton);
+	return CloseButton;
+}
+
+
+//============================================================================
+QMenu* DockWidgetTabPrivate::contextMenu()
+{
+    const bool isFloatable = DockWidget->features().testFlag(CDockWidget::DockWidgetFloatable);
+    const bool isNotOnlyTabInContainer =  !DockArea->dockContainer()->hasTopLevelDockWidget();
+    const bool isTopLevelArea = DockArea->isTopLevelArea();
+    const bool isDetachable = isFloatable && isNotOnlyTabInContainer;
+	const bool AutoHideEnabled = testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled);
+	const bool IsPinnable = DockWidget->features().testFlag(CDockWidget::DockWidgetPinnable);
+	const bool IsClosable = _this->isClosable();
+	const bool HasOtherTabs = DockArea->openDockWidgetsCount() > 1;
+	const int Key = int(isTopLevelArea) | (int(isDetachable) << 1) | (int(AutoHideEnabled) << 2)
+		| (int(IsPinnable) << 3) | (int(IsClosable) << 4) | (int(HasOtherTabs) << 5);
+	if (ContextMenu && Key == ContextMenuKey)
+	{
+		return ContextMenu;
+	}
+
+	if (!ContextMenu)
+	{
+		ContextMenu = new QMenu(_this);
+	}
+	ContextMenu->clear();
+	ContextMenuKey = Key;
+
+	QAction* Action;
+	QMenu& Menu = *ContextMenu;
+    if (!isTopLevelArea)
+    {
+		Action = Menu.addAction(CDockWidgetTab::tr("Detach"), _this, SLOT(detachDockWidget()));
+		Action->setEnabled(isDetachable);
+		if (AutoHideEnabled)
+		{
+			Action = Menu.addAction(CDockWidgetTab::tr("Pin"), _this, SLOT(autoHideDockWidget()));
+			Action->setEnabled(IsPinnable);
+
+			auto menu = Menu.addMenu(CDockWidgetTab::tr("Pin To..."));
+			menu->setEnabled(IsPinnable);
+			createAutoHideToAction(CDockWidgetTab::tr("Top"), SideBarTop, menu);
+			createAutoHideToAction(CDockWidgetTab::tr("Left"), SideBarLeft, menu);
+			createAutoHideToAction(CDockWidgetTab::tr("Right"), SideBarRight, menu);
+			createAutoHideToAction(CDockWidgetTab::tr("Bottom"), SideBarBottom, menu);
+		}
+    }
+
+	Menu.addSeparator();
+	Action = Menu.addAction(CDockWidgetTab::tr("Close"), _this, SIGNAL(closeRequested()));
+	Action->setEnabled(IsClosable);
+	if (HasOtherTabs)
+	{
+		Action = Menu.addAction(CDockWidgetTab::tr("Close Others"), _this, SIGNAL(closeOtherTabsRequested()));
+	}
+	return ContextMenu;
+}
+
+
 //============================================================================
 void DockWidgetTabPrivate::createLayout()
 {
 	TitleLabel = new tTabLabel();
-	if (CDockManager::testConfigFlag(CDockManager::DisableTabTextEliding))
+	if (testConfigFlag(CDockManager::DisableTabTextEliding))
 	{
 		TitleLabel->setElideMode(Qt::ElideNone);
 	}
@@ -256,16 +377,6 @@ void DockWidgetTabPrivate::createLayout()
 	TitleLabel->setAlignment(Qt::AlignCenter);
 	_this->connect(TitleLabel, SIGNAL(elidedChanged(bool)), SIGNAL(elidedChanged(bool)));
 
-
-	CloseButton = createCloseButton();
-	CloseButton->setObjectName("tabCloseButton");
-	internal::setButtonIcon(CloseButton, QStyle::SP_TitleBarCloseButton, TabCloseIcon);
-    CloseButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-    CloseButton->setFocusPolicy(Qt::NoFocus);
-    updateCloseButtonSizePolicy();
-	internal::setToolTip(CloseButton, QObject::tr("Close Tab"));
-	_this->connect(CloseButton, SIGNAL(clicked()), SIGNAL(closeRequested()));
-
 	QFontMetrics fm(TitleLabel->font());
 	int Spacing = qRound(fm.height() / 4.0);
 
@@ -276,11 +387,11 @@ void DockWidgetTabPrivate::createLayout()
 	_this->setLayout(Layout);
 	Layout->addWidget(TitleLabel, 1);
 	Layout->addSpacing(Spacing);
-	Layout->addWidget(CloseButton);
 	Layout->addSpacing(qRound(Spacing * 4.0 / 3.0));
 	Layout->setAlignment(Qt::AlignCenter);
 
 	TitleLabel->setVisible(true);
+	updateCloseButtonVisibility(IsActiveTab);
 }
 
 //============================================================================
@@ -379,7 +490,7 @@ void CDockWidgetTab::mousePressEvent(QMouseEvent* ev)
 		ev->accept();
         d->saveDragStartMousePosition(internal::globalPositionOf(ev));
         d->DragState = DraggingMousePressed;
-        if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+        if (d->testConfigFlag(CDockManager::FocusHighlighting))
         {
         	d->focusController()->setDockWidgetTabPressed(true);
         	d->focusController()->setDockWidgetTabFocused(this);
@@ -422,14 +533,14 @@ void CDockWidgetTab::mouseReleaseEvent(QMouseEvent* ev)
 			break;
 		}
 
-		if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+		if (d->testConfigFlag(CDockManager::FocusHighlighting))
 		{
 			d->focusController()->setDockWidgetTabPressed(false);
 		}
 	} 
 	else if (ev->button() == Qt::MiddleButton)
 	{
-		if (CDockManager::testConfigFlag(CDockManager::MiddleMouseButtonClosesTab) && d->DockWidget->features().testFlag(CDockWidget::DockWidgetClosable))
+		if (d->testConfigFlag(CDockManager::MiddleMouseButtonClosesTab) && d->DockWidget->features().testFlag(CDockWidget::DockWidgetClosable))
 		{
 			// Only attempt to close if the mouse is still
 			// on top of the widget, to allow the user to cancel.
@@ -530,40 +641,7 @@ void CDockWidgetTab::contextMenuEvent(QContextMenuEvent* ev)
 
 	d->saveDragStartMousePosition(ev->globalPos());
 
-    const bool isFloatable = d->DockWidget->features().testFlag(CDockWidget::DockWidgetFloatable);
-    const bool isNotOnlyTabInContainer =  !d->DockArea->dockContainer()->hasTopLevelDockWidget();
-    const bool isTopLevelArea = d->DockArea->isTopLevelArea();
-    const bool isDetachable = isFloatable && isNotOnlyTabInContainer;
-	QAction* Action;
-	QMenu Menu(this);
-
-    if (!isTopLevelArea)
-    {
-		Action = Menu.addAction(tr("Detach"), this, SLOT(detachDockWidget()));
-		Action->setEnabled(isDetachable);
-		if (CDockManager::testAutoHideConfigFlag(CDockManager::AutoHideFeatureEnabled))
-		{
-			Action = Menu.addAction(tr("Pin"), this, SLOT(autoHideDockWidget()));
-			auto IsPinnable = d->DockWidget->features().testFlag(CDockWidget::DockWidgetPinnable);
-			Action->setEnabled(IsPinnable);
-
-			auto menu = Menu.addMenu(tr("Pin To..."));
-			menu->setEnabled(IsPinnable);
-			d->createAutoHideToAction(tr("Top"), SideBarTop, menu);
-			d->createAutoHideToAction(tr("Left"), SideBarLeft, menu);
-			d->createAutoHideToAction(tr("Right"), SideBarRight, menu);
-			d->createAutoHideToAction(tr("Bottom"), SideBarBottom, menu);
-		}
-    }
-
-	Menu.addSeparator();
-	Action = Menu.addAction(tr("Close"), this, SIGNAL(closeRequested()));
-	Action->setEnabled(isClosable());
-	if (d->DockArea->openDockWidgetsCount() > 1)
-	{
-		Action = Menu.addAction(tr("Close Others"), this, SIGNAL(closeOtherTabsRequested()));
-	}
-	Menu.exec(ev->globalPos());
+	d->contextMenu()->exec(ev->globalPos());
 }
 
 
@@ -579,7 +657,7 @@ void CDockWidgetTab::setActiveTab(bool active)
 {
     d->updateCloseButtonVisibility(active);
 
-	if (CDockManager::testConfigFlag(CDockManager::ShowTabTextOnlyForActiveTab) && !d->Icon.isNull())
+	if (d->testConfigFlag(CDockManager::ShowTabTextOnlyForActiveTab) && !d->Icon.isNull())
 	{
 		if (active)
 			d->TitleLabel->setVisible(true);
@@ -588,7 +666,7 @@ void CDockWidgetTab::setActiveTab(bool active)
 	}
 
 	// Focus related stuff
-	if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting) && !d->DockWidget->dockManager()->isRestoringState())
+	if (d->testConfigFlag(CDockManager::FocusHighlighting) && !d->DockWidget->dockManager()->isRestoringState())
 	{
 		bool UpdateFocusStyle = false;
 		if (active && !hasFocus())
@@ -834,6 +912,13 @@ void CDockWidgetTab::setIconSize(const QSize& Size)
 	d->updateIcon();
 }
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CDockWidgetTab*)
+{
+	return sizeof(DockWidgetTabPrivate);
+}
+
 } // namespace ads
 //---------------------------------------------------------------------------
 // EOF DockWidgetTab.cpp
@@ -0,0 +1,300 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockingStateStream.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CDockingStateCompressor and
+///         CDockingStateDecompressor
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateStream.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ads
+{
+static const char StreamMagic[] = "ADSZ\x01";
+static const int StreamMagicSize = sizeof(StreamMagic) - 1;
+
+
+//============================================================================
+CDockingStateCompressor::CDockingStateCompressor(QIODevice* Target, int CompressionLevel)
+	: Target(Target),
+	  CompressionLevel(CompressionLevel)
+{
+
+}
+
+
+//============================================================================
+CDockingStateCompressor::~CDockingStateCompressor()
+{
+	close();
+}
+
+
+//============================================================================
+bool CDockingStateCompressor::open(OpenMode Mode)
+{
+	if (Mode & ReadOnly)
+	{
+		setErrorString(QStringLiteral("Compressor is a write only device"));
+		return false;
+	}
+
+	if (Target->write(StreamMagic, StreamMagicSize) != StreamMagicSize)
+	{
+		Error = true;
+		setErrorString(Target->errorString());
+		return false;
+	}
+
+	Error = false;
+	Buffer.reserve(ChunkSize);
+	return QIODevice::open(Mode | Unbuffered);
+}
+
+
+//============================================================================
+void CDockingStateCompressor::close()
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	if (!Buffer.isEmpty())
+	{
+		writeChunk(Buffer.constData(), Buffer.size());
+		Buffer.clear();
+	}
+
+	// A chunk with a length of 0 marks the end of stream
+	writeChunk(nullptr, 0);
+	QIODevice::close();
+}
+
+
+//============================================================================
+bool CDockingStateCompressor::isCompressedStream(const QByteArray& Data)
+{
+	return Data.startsWith(QByteArray::fromRawData(StreamMagic, StreamMagicSize));
+}
+
+
+//============================================================================
+int CDockingStateCompressor::headerSize()
+{
+	return StreamMagicSize;
+}
+
+
+//============================================================================
+qint64 CDockingStateCompressor::readData(char* Data, qint64 MaxSize)
+{
+	Q_UNUSED(Data);
+	Q_UNUSED(MaxSize);
+	return -1;
+}
+
+
+//============================================================================
+qint64 CDockingStateCompressor::writeData(const char* Data, qint64 Size)
+{
+	qint64 Written = 0;
+	while (Written < Size)
+	{
+		// Compress full chunks directly from the given data without copying
+		// them into the buffer
+		int Count = static_cast<int>(std::min<qint64>(Size - Written, ChunkSize - Buffer.size()));
+		if (Buffer.isEmpty() && Count == ChunkSize)
+		{
+			if (!writeChunk(Data + Written, Count))
+			{
+				return -1;
+			}
+		}
+		else
+		{
+			Buffer.append(Data + Written, Count);
+			if (Buffer.size() == ChunkSize)
+			{
+				if (!writeChunk(Buffer.constData(), Buffer.size()))
+				{
+					return -1;
+				}
+				Buffer.clear();
+			}
+		}
+		Written += Count;
+	}
+
+	return Written;
+}
+
+
+//============================================================================
+bool CDockingStateCompressor::writeChunk(const char* Data, int Size)
+{
+	QByteArray Chunk = Size ? qCompress(reinterpret_cast<const uchar*>(Data),
+		Size, CompressionLevel) : QByteArray();
+	uchar Length[4];
+	qToBigEndian<quint32>(Chunk.size(), Length);
+	if (Target->write(reinterpret_cast<const char*>(Length), 4) != 4
+	 || Target->write(Chunk) != Chunk.size())
+	{
+		Error = true;
+		setErrorString(Target->errorString());
+		return false;
+	}
+
+	return true;
+}
+
+
+//============================================================================
+CDockingStateDecompressor::CDockingStateDecompressor(QIODevice* Source)
+	: Source(Source)
+{
+
+}
+
+
+//============================================================================
+bool CDockingStateDecompressor::open(OpenMode Mode)
+{
+	if (Mode & WriteOnly)
+	{
+		setErrorString(QStringLiteral("Decompressor is a read only device"));
+		return false;
+	}
+
+	if (!CDockingStateCompressor::isCompressedStream(Source->read(StreamMagicSize)))
+	{
+		setErrorString(QStringLiteral("Invalid compressed docking state stream"));
+		return false;
+	}
+
+	Buffer.clear();
+	Pos = 0;
+	EndOfStream = false;
+	return QIODevice::open(Mode | Unbuffered);
+}
+
+
+//============================================================================
+bool CDockingStateDecompressor::atEnd() const
+{
+	return EndOfStream && Pos >= Buffer.size();
+}
+
+
+//============================================================================
+qint64 CDockingStateDecompressor::bytesAvailable() const
+{
+	return Buffer.size() - Pos + QIODevice::bytesAvailable();
+}
+
+
+//============================================================================
+qint64 CDockingStateDecompressor::readData(char* Data, qint64 MaxSize)
+{
+	qint64 Read = 0;
+	while (Read < MaxSize)
+	{
+		if (Pos >= Buffer.size())
+		{
+			if (EndOfStream)
+			{
+				break;
+			}
+
+			if (!readChunk())
+			{
+				return Read ? Read : -1;
+			}
+			continue;
+		}
+
+		int Count = static_cast<int>(std::min<qint64>(MaxSize - Read, Buffer.size() - Pos));
+		std::memcpy(Data + Read, Buffer.constData() + Pos, Count);
+		Pos += Count;
+		Read += Count;
+	}
+
+	return Read;
+}
+
+
+//============================================================================
+qint64 CDockingStateDecompressor::writeData(const char* Data, qint64 Size)
+{
+	Q_UNUSED(Data);
+	Q_UNUSED(Size);
+	return -1;
+}
+
+
+//============================================================================
+bool CDockingStateDecompressor::readChunk()
+{
+	Buffer.clear();
+	Pos = 0;
+	QByteArray Length = Source->read(4);
+	if (Length.size() != 4)
+	{
+		setErrorString(QStringLiteral("Unexpected end of compressed docking state stream"));
+		return false;
+	}
+
+	quint32 ChunkLength = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(Length.constData()));
+	if (!ChunkLength)
+	{
+		EndOfStream = true;
+		return true;
+	}
+
+	QByteArray Chunk = Source->read(ChunkLength);
+	if (static_cast<quint32>(Chunk.size()) != ChunkLength)
+	{
+		setErrorString(QStringLiteral("Unexpected end of compressed docking state stream"));
+		return false;
+	}
+
+	Buffer = qUncompress(Chunk);
+	if (Buffer.isEmpty())
+	{
+		setErrorString(QStringLiteral("Corrupt compressed docking state stream"));
+		return false;
+	}
+
+	return true;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockingStateStream.cpp
@@ -0,0 +1,165 @@
+#ifndef DockingStateStreamH
+#define DockingStateStreamH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockingStateStream.h
+/// \date   19.10.2026
+/// \brief  Declaration of CDockingStateCompressor and
+///         CDockingStateDecompressor
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QIODevice>
+#include <QByteArray>
+
+namespace ads
+{
+/**
+ * Sequential write only device that compresses all data written to it
+ * and writes the compressed data to a target device.
+ * The data is compressed in chunks of ChunkSize bytes. Each chunk is
+ * compressed with qCompress() and written with a 32 bit length prefix.
+ * A chunk with length 0 marks the end of the stream. So the memory
+ * required for compression is bounded by the chunk size and not by the
+ * size of the written data.
+ * The compressed stream starts with a magic header that is used by the
+ * dock manager to detect compressed streams in restoreState().
+ */
+class CDockingStateCompressor : public QIODevice
+{
+public:
+	enum
+	{
+		ChunkSize = 64 * 1024 ///< uncompressed size of one chunk
+	};
+
+	/**
+	 * Creates a compressor that writes into the given Target device.
+	 * The target device needs to be open for writing.
+	 */
+	CDockingStateCompressor(QIODevice* Target, int CompressionLevel = 9);
+
+	/**
+	 * Closes the device if it is still open
+	 */
+	virtual ~CDockingStateCompressor();
+
+	/**
+	 * Writes the magic header into the target device and opens this device
+	 */
+	virtual bool open(OpenMode Mode) override;
+
+	/**
+	 * Compresses and writes the remaining buffered data, writes the end of
+	 * stream marker and closes the device. The target device is not closed.
+	 */
+	virtual void close() override;
+
+	/**
+	 * The compressor is always sequential
+	 */
+	virtual bool isSequential() const override {return true;}
+
+	/**
+	 * Returns true, if writing to the target device failed
+	 */
+	bool hasError() const {return Error;}
+
+	/**
+	 * Returns true, if the given data starts with the magic header of
+	 * a compressed docking state stream
+	 */
+	static bool isCompressedStream(const QByteArray& Data);
+
+	/**
+	 * Returns the size of the magic header
+	 */
+	static int headerSize();
+
+protected:
+	virtual qint64 readData(char* Data, qint64 MaxSize) override;
+	virtual qint64 writeData(const char* Data, qint64 Size) override;
+
+private:
+	QIODevice* Target;
+	QByteArray Buffer;
+	int CompressionLevel;
+	bool Error = false;
+
+	bool writeChunk(const char* Data, int Size);
+}; // class CDockingStateCompressor
+
+
+/**
+ * Sequential read only device that reads and decompresses a stream that
+ * has been written by CDockingStateCompressor. Only one compressed chunk
+ * is kept in memory at a time.
+ */
+class CDockingStateDecompressor : public QIODevice
+{
+public:
+	/**
+	 * Creates a decompressor that reads from the given Source device.
+	 * The source device needs to be open for reading and positioned at
+	 * the start of the compressed stream.
+	 */
+	CDockingStateDecompressor(QIODevice* Source);
+
+	/**
+	 * Reads and checks the magic header and opens this device
+	 */
+	virtual bool open(OpenMode Mode) override;
+
+	/**
+	 * The decompressor is always sequential
+	 */
+	virtual bool isSequential() const override {return true;}
+
+	/**
+	 * Returns true, if all chunks have been read and consumed
+	 */
+	virtual bool atEnd() const override;
+
+	/**
+	 * Returns the number of decompressed bytes that are available without
+	 * reading the next chunk
+	 */
+	virtual qint64 bytesAvailable() const override;
+
+protected:
+	virtual qint64 readData(char* Data, qint64 MaxSize) override;
+	virtual qint64 writeData(const char* Data, qint64 Size) override;
+
+private:
+	QIODevice* Source;
+	QByteArray Buffer;
+	int Pos = 0;
+	bool EndOfStream = false;
+
+	bool readChunk();
+}; // class CDockingStateDecompressor
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // DockingStateStreamH
@@ -45,6 +45,7 @@
 #include "DockContainerWidget.h"
 #include "DockAreaWidget.h"
 #include "DockManager.h"
+#include "DockMemoryUsage.h"
 #include "DockWidget.h"
 #include "DockOverlay.h"
 #include "DockSnappingManager.h"
@@ -364,6 +365,29 @@ static const char* windowsMessageString(int MessageId)
 #endif
 
 static unsigned int zOrderCounterFloating = 0;
+
+/**
+ * Geometry of a hidden floating widget that has not been applied to the
+ * widget yet
+ */
+struct DeferredGeometry
+{
+    QByteArray State; ///< geometry in the format of QWidget::saveGeometry()
+    bool Pending = false;
+
+    void set(const QByteArray& Geometry)
+    {
+        State = Geometry;
+        Pending = true;
+    }
+
+    void clear()
+    {
+        State.clear();
+        Pending = false;
+    }
+};
+
 /**
  * Private data class of CFloatingDockContainer class (pimpl)
  */
@@ -384,6 +408,7 @@ struct FloatingDockContainerPrivate
     bool IsSnapped = false;
     bool Canceled = false;
     QWidget* MouseEventHandler = nullptr;
+    DeferredGeometry PendingGeometry;
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
     CFloatingWidgetTitleBar* TitleBar = nullptr;
     bool IsResizing = false;
@@ -397,6 +422,28 @@ struct FloatingDockContainerPrivate
 
     void titleMouseReleaseEvent();
     void updateDropOverlays(const QPoint &GlobalPos);
+
+    /**
+     * Returns true, if there is a deferred geometry that has not been
+     * replaced by an explicit move or resize of the floating widget.
+     * A replaced deferred geometry is dropped.
+     */
+    bool hasPendingGeometry();
+
+    /**
+     * Applies the geometry recorded by restoreGeometryDeferred()
+     */
+    void applyDeferredGeometry();
+
+    /**
+     * Adds the given dock area to the empty dock container
+     */
+    void addDockArea(CDockAreaWidget* DockArea);
+
+    /**
+     * Adds the given dock widget to the empty dock container
+     */
+    void addDockWidget(CDockWidget* DockWidget);
     
     /**
      * Cancel dragging
@@ -437,11 +484,11 @@ struct FloatingDockContainerPrivate
     }
 
     /**
-     * Returns true if the given config flag is set
+     * Returns true if the given config flag is set for the dock manager
      */
-    static bool testConfigFlag(CDockManager::eConfigFlag Flag)
+    bool testConfigFlag(CDockManager::eConfigFlag Flag) const
     {
-        return CDockManager::testConfigFlag(Flag);
+        return CDockManager::testConfigFlag(DockManager, Flag);
     }
 
     /**
@@ -649,6 +696,75 @@ void FloatingDockContainerPrivate::updateDropOverlays(const QPoint &GlobalPos)
 }
 
 
+//============================================================================
+bool FloatingDockContainerPrivate::hasPendingGeometry()
+{
+    if (!PendingGeometry.Pending)
+    {
+        return false;
+    }
+
+    // move(), resize() and setGeometry() set these attributes, so the
+    // application changed the geometry after it has been restored
+    if (_this->testAttribute(Qt::WA_Moved) || _this->testAttribute(Qt::WA_Resized))
+    {
+        PendingGeometry.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::applyDeferredGeometry()
+{
+    if (!hasPendingGeometry())
+    {
+        return;
+    }
+
+    auto Geometry = PendingGeometry.State;
+    PendingGeometry.clear();
+    _this->restoreGeometry(Geometry);
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+    if (TitleBar)
+    {
+        TitleBar->setMaximizedIcon(_this->windowState() == Qt::WindowMaximized);
+    }
+#endif
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::addDockArea(CDockAreaWidget* DockArea)
+{
+    DockContainer->addDockArea(DockArea);
+
+    auto TopLevelDockWidget = _this->topLevelDockWidget();
+    if (TopLevelDockWidget)
+    {
+        TopLevelDockWidget->emitTopLevelChanged(true);
+    }
+
+    DockManager->notifyWidgetOrAreaRelocation(DockArea);
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::addDockWidget(CDockWidget* DockWidget)
+{
+    DockContainer->addDockWidget(CenterDockWidgetArea, DockWidget);
+    auto TopLevelDockWidget = _this->topLevelDockWidget();
+    if (TopLevelDockWidget)
+    {
+        TopLevelDockWidget->emitTopLevelChanged(true);
+    }
+
+    DockManager->notifyWidgetOrAreaRelocation(DockWidget);
+}
+
+
 //============================================================================
 void FloatingDockContainerPrivate::handleEscapeKey()
 {
@@ -688,11 +804,11 @@ CFloatingDockContainer::CFloatingDockContainer(CDockManager *DockManager) :
     {
         native_window = false;
     }
-    else if (DockManager->testConfigFlag(CDockManager::FloatingContainerForceNativeTitleBar))
+    else if (DockManager->testManagerConfigFlag(CDockManager::FloatingContainerForceNativeTitleBar))
     {
         native_window = true;
     }
-    else if (DockManager->testConfigFlag(CDockManager::FloatingContainerForceQWidgetTitleBar))
+    else if (DockManager->testManagerConfigFlag(CDockManager::FloatingContainerForceQWidgetTitleBar))
     {
         native_window = false;
     }
@@ -750,29 +866,32 @@ CFloatingDockContainer::CFloatingDockContainer(CDockManager *DockManager) :
 CFloatingDockContainer::CFloatingDockContainer(CDockAreaWidget *DockArea) :
     CFloatingDockContainer(DockArea->dockManager())
 {
-    d->DockContainer->addDockArea(DockArea);
-
-    auto TopLevelDockWidget = topLevelDockWidget();
-    if (TopLevelDockWidget)
-    {
-        TopLevelDockWidget->emitTopLevelChanged(true);
-    }
-
-    d->DockManager->notifyWidgetOrAreaRelocation(DockArea);
+    d->addDockArea(DockArea);
 }
 
 //============================================================================
 CFloatingDockContainer::CFloatingDockContainer(CDockWidget *DockWidget) :
     CFloatingDockContainer(DockWidget->dockManager())
 {
-    d->DockContainer->addDockWidget(CenterDockWidgetArea, DockWidget);
-    auto TopLevelDockWidget = topLevelDockWidget();
-    if (TopLevelDockWidget)
-    {
-        TopLevelDockWidget->emitTopLevelChanged(true);
-    }
+    d->addDockWidget(DockWidget);
+}
 
-    d->DockManager->notifyWidgetOrAreaRelocation(DockWidget);
+
+//============================================================================
+CFloatingDockContainer* CFloatingDockContainer::create(CDockAreaWidget *DockArea)
+{
+    auto FloatingWidget = DockArea->dockManager()->takeFloatingWidget();
+    FloatingWidget->d->addDockArea(DockArea);
+    return FloatingWidget;
+}
+
+
+//============================================================================
+CFloatingDockContainer* CFloatingDockContainer::create(CDockWidget *DockWidget)
+{
+    auto FloatingWidget = DockWidget->dockManager()->takeFloatingWidget();
+    FloatingWidget->d->addDockWidget(DockWidget);
+    return FloatingWidget;
 }
 
 
@@ -817,6 +936,49 @@ void CFloatingDockContainer::deleteContent()
     }
 }
 
+//============================================================================
+void CFloatingDockContainer::resetForReuse()
+{
+    // Hide without toggling the view of the dock widgets - the dock widgets
+    // do not belong to this floating widget anymore
+    d->AutoHideChildren = false;
+    hide();
+    d->AutoHideChildren = true;
+    qApp->removeEventFilter(this);
+
+    d->DockContainer->resetRootSplitter();
+    d->PendingGeometry.clear();
+    d->DraggingState = DraggingInactive;
+    d->DropContainer = nullptr;
+    d->Hiding = false;
+    d->IsCurrentlyDragged = false;
+    d->IsSnapped = false;
+    d->Canceled = false;
+    d->MouseEventHandler = nullptr;
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+    d->IsResizing = false;
+    d->MousePressed = false;
+#endif
+    setWindowOpacity(1);
+    setWindowState(Qt::WindowNoState);
+    onDockAreasAddedOrRemoved();
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
+    if (d->TitleBar)
+    {
+        d->TitleBar->setMaximizedIcon(false);
+    }
+#endif
+}
+
+
+//============================================================================
+void CFloatingDockContainer::prepareReuse()
+{
+    d->zOrderIndex = ++zOrderCounterFloating;
+    qApp->installEventFilter(this);
+}
+
+
 //============================================================================
 CDockContainerWidget* CFloatingDockContainer::dockContainer() const
 {
@@ -1028,7 +1190,7 @@ void CFloatingDockContainer::showEvent(QShowEvent *event)
     }
 
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
-    if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+    if (d->testConfigFlag(CDockManager::FocusHighlighting))
     {
         this->window()->activateWindow();
     }
@@ -1074,6 +1236,8 @@ void CFloatingDockContainer::startFloating(const QPoint &DragStartMousePos,
                                            const QSize &Size, eDragState DragState, QWidget *MouseEventHandler)
 {
     d->Canceled = false;
+    // The given size replaces any geometry that has not been applied yet
+    d->PendingGeometry.clear();
     d->DragStartPos = pos();
     
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
@@ -1319,14 +1483,56 @@ void CFloatingDockContainer::finishDropOperation()
     // moved to a new container - simply remove all dock areas before deleting
     // the floating widget
     d->DockContainer->removeAllDockAreas();
-    deleteLater();
     if (d->DockManager)
     {
         d->DockManager->removeFloatingWidget(this);
         d->DockManager->removeDockContainer(this->dockContainer());
+        // Keep the native window alive, if the dock manager wants to reuse it
+        if (d->DockManager->recycleFloatingWidget(this))
+        {
+            return;
+        }
     }
+    deleteLater();
 }
 
+//============================================================================
+void CFloatingDockContainer::restoreGeometryDeferred(const QByteArray& Geometry)
+{
+    if (isVisible())
+    {
+        d->PendingGeometry.clear();
+        restoreGeometry(Geometry);
+    }
+    else
+    {
+        // Reset the attributes to detect explicit geometry changes until the
+        // deferred geometry is applied
+        setAttribute(Qt::WA_Moved, false);
+        setAttribute(Qt::WA_Resized, false);
+        d->PendingGeometry.set(Geometry);
+    }
+}
+
+
+//============================================================================
+QByteArray CFloatingDockContainer::savedGeometry() const
+{
+    return d->hasPendingGeometry() ? d->PendingGeometry.State : saveGeometry();
+}
+
+
+//============================================================================
+void CFloatingDockContainer::setVisible(bool Visible)
+{
+    if (Visible)
+    {
+        d->applyDeferredGeometry();
+    }
+    Super::setVisible(Visible);
+}
+
+
 //============================================================================
 void CFloatingDockContainer::finishDragging(bool forced)
 {
@@ -1530,6 +1736,8 @@ bool CFloatingDockContainer::isMaximized() const
 //============================================================================
 void CFloatingDockContainer::show()
 {
+    // Apply the geometry before winId() creates the native window
+    d->applyDeferredGeometry();
     // Prevent this window from showing in the taskbar and pager (alt+tab)
     internal::xcb_add_prop(true, winId(), "_NET_WM_STATE", "_NET_WM_STATE_SKIP_TASKBAR");
     internal::xcb_add_prop(true, winId(), "_NET_WM_STATE", "_NET_WM_STATE_SKIP_PAGER");
@@ -1583,6 +1791,13 @@ bool CFloatingDockContainer::hasNativeTitleBar()
 }
 #endif
 
+
+//============================================================================
+std::size_t internal::privateDataSize(const CFloatingDockContainer*)
+{
+    return sizeof(FloatingDockContainerPrivate);
+}
+
 } // namespace ads
 
 //---------------------------------------------------------------------------
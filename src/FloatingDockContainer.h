@@ -125,6 +125,7 @@ private:
 	friend class CDockWidget;
 	friend class CDockAreaWidget;
     friend class CFloatingWidgetTitleBar;
+	friend class CDockContainerWidget;
 
 private Q_SLOTS:
 	void onDockAreasAddedOrRemoved();
@@ -160,6 +161,20 @@ protected:
      */
 	void deleteContent();
 
+	/**
+	 * Hides the floating widget and resets its internal state so that the
+	 * dock manager can keep it in its floating widget pool.
+	 * All dock areas need to be removed from the dock container before
+	 * this function is called.
+	 */
+	void resetForReuse();
+
+	/**
+	 * Called by the dock manager, if this floating widget is taken out of
+	 * the floating widget pool
+	 */
+	void prepareReuse();
+
 	/**
 	 * Call this function if you just want to initialize the position
 	 * and size of the floating widget
@@ -188,6 +203,24 @@ protected:
 	 */
     void updateWindowTitle();
 
+	/**
+	 * Restores the geometry given in the format of QWidget::saveGeometry().
+	 * If the floating widget is hidden, the geometry is only recorded and
+	 * applied when the floating widget is shown. This avoids the creation
+	 * and configuration of native windows for floating widgets that are
+	 * restored as hidden. An explicit move(), resize() or setGeometry()
+	 * call before the floating widget is shown replaces the recorded
+	 * geometry.
+	 */
+	void restoreGeometryDeferred(const QByteArray& Geometry);
+
+	/**
+	 * Returns the geometry in the format of QWidget::saveGeometry().
+	 * If a deferred geometry has not been applied or replaced yet, the
+	 * recorded geometry is returned.
+	 */
+	QByteArray savedGeometry() const;
+
 protected:
 
 	virtual void changeEvent(QEvent *event) override;
@@ -240,6 +273,20 @@ public:
 	 */
 	virtual ~CFloatingDockContainer();
 
+	/**
+	 * Creates a floating widget for the given dock area.
+	 * If the dock manager has a floating widget pool
+	 * (see CDockManager::setFloatingWidgetPoolSize()), then a hidden pooled
+	 * floating widget is reused instead of creating a new native window.
+	 */
+	static CFloatingDockContainer* create(CDockAreaWidget* DockArea);
+
+	/**
+	 * Creates a floating widget for the given dock widget.
+	 * \see create(CDockAreaWidget*)
+	 */
+	static CFloatingDockContainer* create(CDockWidget* DockWidget);
+
 	/**
 	 * Access function for the internal dock container
 	 */
@@ -282,6 +329,12 @@ public:
 	 */
 	void finishDropOperation();
 
+	/**
+	 * Applies a deferred geometry (see restoreGeometryDeferred()) before
+	 * the floating widget becomes visible
+	 */
+	virtual void setVisible(bool Visible) override;
+
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
     /**
 	 * This is a function that responds to FloatingWidgetTitleBar::maximizeRequest()
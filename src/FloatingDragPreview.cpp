@@ -17,6 +17,7 @@
 #include <QToolBar>
 #include <QKeyEvent>
 #include <QApplication>
+#include <QPointer>
 
 #include "ads_globals.h"
 #include "DockWidget.h"
@@ -33,6 +34,7 @@
 
 namespace ads
 {
+class CDragPreviewLayer;
 
 /**
  * Private data class (pimpl)
@@ -44,13 +46,16 @@ struct FloatingDragPreviewPrivate
 	CDockWidget::DockWidgetFeatures ContentFeatures;
 	CDockAreaWidget *ContentSourceArea = nullptr;
 	QPoint DragStartMousePosition;
-	CDockManager* DockManager;
+	CDockManager* DockManager = nullptr;
 	CDockContainerWidget *DropContainer = nullptr;
 	qreal WindowOpacity;
 	bool Hidden = false;
 	QPixmap ContentPreviewPixmap;
 	bool Canceled = false;
+	bool Started = false;
     int DraggedTabBarIndex = 0;
+	QPointer<CDragPreviewLayer> Layer;
+	qreal PreviewOpacity = 1.0;
 
 	/**
 	 * Private data constructor
@@ -58,11 +63,44 @@ struct FloatingDragPreviewPrivate
 	FloatingDragPreviewPrivate(CFloatingDragPreview *_public);
 	void updateDropOverlays(const QPoint &GlobalPos);
 
-	void setHidden(bool Value)
-	{
-		Hidden = Value;
-		_this->update();
-	}
+	void setHidden(bool Value);
+
+	/**
+	 * Paints the preview into the given painter. Used by the preview window
+	 * and by the in-window layer. The opacity of the preview window is
+	 * applied by the window system, the layer applies it while painting.
+	 */
+	void paintPreview(QPainter& Painter, const QRect& Rect, bool IsLayer);
+
+	/**
+	 * Returns true, if the preview is visible either as preview window or
+	 * as layer inside of a dock window
+	 */
+	bool isPreviewVisible() const;
+
+	/**
+	 * Sets the opacity of the preview window and of the layer
+	 */
+	void setPreviewOpacity(qreal Opacity);
+
+	/**
+	 * Returns the window of the front most dock container under the given
+	 * global position or nullptr, if the position is outside of all dock
+	 * windows
+	 */
+	QWidget* dockWindowAt(const QPoint& GlobalPos) const;
+
+	/**
+	 * Shows the preview as layer inside the dock window under the cursor or
+	 * as preview window, if the cursor is outside of all dock windows or if
+	 * the DragPreviewInWindow flag is not set
+	 */
+	void updatePreview(const QPoint& GlobalPos);
+
+	/**
+	 * Hides the in-window layer
+	 */
+	void hideLayer();
 
 	/**
 	 * Cancel dragging and emit the draggingCanceled event
@@ -115,6 +153,7 @@ struct FloatingDragPreviewPrivate
 		Q_EMIT _this->draggingCanceled();
 		DockManager->containerOverlay()->hideOverlay();
         _this->hide();
+		hideLayer();
 		DockManager->dockAreaOverlay()->hideOverlay();
         if (ContentSourceArea) ContentSourceArea->show();
 	}
@@ -162,10 +201,193 @@ struct FloatingDragPreviewPrivate
 	}
 };
 
+
+/**
+ * Lightweight child widget that paints the drag preview inside of a dock
+ * window. Moving it only repaints the affected part of the window instead
+ * of moving a native top level window.
+ */
+class CDragPreviewLayer : public QWidget
+{
+private:
+	FloatingDragPreviewPrivate* Preview;
+
+public:
+	CDragPreviewLayer(FloatingDragPreviewPrivate* Preview, QWidget* parent) :
+		QWidget(parent),
+		Preview(Preview)
+	{
+		setAttribute(Qt::WA_TransparentForMouseEvents);
+		setAttribute(Qt::WA_NoSystemBackground);
+		setFocusPolicy(Qt::NoFocus);
+	}
+
+protected:
+	virtual void paintEvent(QPaintEvent* event) override
+	{
+		Q_UNUSED(event);
+		QPainter Painter(this);
+		Preview->paintPreview(Painter, rect(), true);
+	}
+};
+
+
+//============================================================================
+void FloatingDragPreviewPrivate::setHidden(bool Value)
+{
+	Hidden = Value;
+	_this->update();
+	if (Layer)
+	{
+		Layer->update();
+	}
+}
+
+
+//============================================================================
+void FloatingDragPreviewPrivate::paintPreview(QPainter& Painter, const QRect& Rect,
+	bool IsLayer)
+{
+	if (Hidden)
+	{
+		return;
+	}
+
+	Painter.setOpacity(IsLayer ? internal::DraggingDockOpacity * PreviewOpacity
+		: internal::DraggingDockOpacity);
+	if (CDockManager::testConfigFlag(DockManager, CDockManager::DragPreviewShowsContentPixmap))
+	{
+		Painter.drawPixmap(Rect.topLeft(), ContentPreviewPixmap);
+		return;
+	}
+
+	// The preview window shows its own background or window frame. The layer
+	// has no background, so it paints a QRubberBand like frame instead
+	if (IsLayer)
+	{
+		QColor Color = _this->palette().color(QPalette::Active, QPalette::Highlight);
+		QPen Pen = Painter.pen();
+		Pen.setColor(Color.darker(120));
+		Pen.setStyle(Qt::SolidLine);
+		Pen.setWidth(1);
+		Pen.setCosmetic(true);
+		Painter.setPen(Pen);
+		Color = Color.lighter(130);
+		Color.setAlpha(64);
+		Painter.setBrush(Color);
+		Painter.drawRect(Rect.adjusted(0, 0, -1, -1));
+	}
+}
+
+
+//============================================================================
+bool FloatingDragPreviewPrivate::isPreviewVisible() const
+{
+	return _this->isVisible() || (Layer && Layer->isVisible());
+}
+
+
+//============================================================================
+void FloatingDragPreviewPrivate::setPreviewOpacity(qreal Opacity)
+{
+	if (Opacity == PreviewOpacity)
+	{
+		return;
+	}
+
+	PreviewOpacity = Opacity;
+	if (_this->isVisible())
+	{
+		_this->setWindowOpacity(Opacity);
+	}
+	if (Layer && Layer->isVisible())
+	{
+		Layer->update();
+	}
+}
+
+
+//============================================================================
+QWidget* FloatingDragPreviewPrivate::dockWindowAt(const QPoint& GlobalPos) const
+{
+	CDockContainerWidget* Top = nullptr;
+	for (auto Container : DockManager->dockContainers())
+	{
+		auto Window = Container->window();
+		if (!Window->isVisible()
+		 || !QRect(Window->mapToGlobal(QPoint(0, 0)), Window->size()).contains(GlobalPos))
+		{
+			continue;
+		}
+
+		if (!Top || Container->isInFrontOf(Top))
+		{
+			Top = Container;
+		}
+	}
+
+	return Top ? Top->window() : nullptr;
+}
+
+
+//============================================================================
+void FloatingDragPreviewPrivate::updatePreview(const QPoint& GlobalPos)
+{
+	QWidget* Window = nullptr;
+	if (CDockManager::testConfigFlag(DockManager, CDockManager::DragPreviewInWindow))
+	{
+		Window = dockWindowAt(GlobalPos);
+	}
+
+	if (!Window)
+	{
+		hideLayer();
+		if (!_this->isVisible())
+		{
+			_this->setWindowOpacity(PreviewOpacity);
+			_this->show();
+		}
+		return;
+	}
+
+	if (_this->isVisible())
+	{
+		_this->hide();
+	}
+
+	if (!Layer)
+	{
+		Layer = new CDragPreviewLayer(this, Window);
+	}
+	else if (Layer->parentWidget() != Window)
+	{
+		Layer->setParent(Window);
+	}
+
+	// The position of the hidden preview window is still updated on each
+	// move, so the layer simply follows it
+	Layer->setGeometry(QRect(Window->mapFromGlobal(_this->pos()), _this->size()));
+	if (!Layer->isVisible())
+	{
+		Layer->raise();
+		Layer->show();
+	}
+}
+
+
+//============================================================================
+void FloatingDragPreviewPrivate::hideLayer()
+{
+	if (Layer)
+	{
+		Layer->hide();
+	}
+}
+
 //============================================================================
 void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint &GlobalPos)
 {
-    if (!_this->isVisible() || !DockManager)
+    if (!isPreviewVisible() || !DockManager)
     {
         return;
     }
@@ -200,17 +422,17 @@ void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint &GlobalPos)
         DropContainer = top;
         if (area != InvalidDockWidgetArea || area != NoDockWidgetArea)
         {
-            _this->setWindowOpacity(ads::internal::HoveredOverDockAreaOpacity);
+            setPreviewOpacity(ads::internal::HoveredOverDockAreaOpacity);
         }
         else
         {
-            _this->setWindowOpacity(1.0);
+            setPreviewOpacity(1.0);
         }
     }
     else
     {
         DockManager->dockAreaOverlay()->hideOverlay();
-        _this->setWindowOpacity(1.0);
+        setPreviewOpacity(1.0);
     }
     
     return;
@@ -235,18 +457,18 @@ void FloatingDragPreviewPrivate::createFloatingWidget()
 
 	if (DockWidget && DockWidget->features().testFlag(CDockWidget::DockWidgetFloatable))
 	{
-		FloatingWidget = new CFloatingDockContainer(DockWidget);
+		FloatingWidget = CFloatingDockContainer::create(DockWidget);
 	}
 	else if (DockArea && DockArea->features().testFlag(CDockWidget::DockWidgetFloatable))
 	{
-		FloatingWidget = new CFloatingDockContainer(DockArea);
+		FloatingWidget = CFloatingDockContainer::create(DockArea);
 	}
 
 	if (FloatingWidget)
 	{
 		FloatingWidget->setGeometry(_this->geometry());
 		FloatingWidget->show();
-		if (!CDockManager::testConfigFlag(CDockManager::DragPreviewHasWindowFrame))
+		if (!CDockManager::testConfigFlag(DockManager, CDockManager::DragPreviewHasWindowFrame))
 		{
 			QApplication::processEvents();
             
@@ -266,8 +488,9 @@ CFloatingDragPreview::CFloatingDragPreview(QWidget* Content, QWidget* parent) :
 {
 	d->Content = Content;
 	d->ContentFeatures = d->contentFeatures();
+	d->DockManager = qobject_cast<CDockManager*>(parent);
 	setAttribute(Qt::WA_DeleteOnClose);
-	if (CDockManager::testConfigFlag(CDockManager::DragPreviewHasWindowFrame))
+	if (CDockManager::testConfigFlag(d->DockManager, CDockManager::DragPreviewHasWindowFrame))
 	{
 		setWindowFlags(
 			Qt::Window | Qt::WindowMaximizeButtonHint | Qt::WindowCloseButtonHint);
@@ -288,7 +511,7 @@ CFloatingDragPreview::CFloatingDragPreview(QWidget* Content, QWidget* parent) :
 	// Create a static image of the widget that should get undocked
 	// This is like some kind preview image like it is uses in drag and drop
 	// operations
-	if (CDockManager::testConfigFlag(CDockManager::DragPreviewShowsContentPixmap))
+	if (CDockManager::testConfigFlag(d->DockManager, CDockManager::DragPreviewShowsContentPixmap))
 	{
 		d->ContentPreviewPixmap = QPixmap(Content->size());
 		Content->render(&d->ContentPreviewPixmap);
@@ -332,6 +555,7 @@ CFloatingDragPreview::CFloatingDragPreview(CDockAreaWidget* Content)
 //============================================================================
 CFloatingDragPreview::~CFloatingDragPreview()
 {
+	delete d->Layer.data();
 	delete d;
 }
 
@@ -348,6 +572,10 @@ void CFloatingDragPreview::moveFloating()
     if (std::get<0>(result))
     {
         move(std::get<1>(result));
+        if (d->Started)
+        {
+            d->updatePreview(QCursor::pos());
+        }
     }
     else
     {
@@ -356,6 +584,10 @@ void CFloatingDragPreview::moveFloating()
         const QPoint cursorPos = QCursor::pos();
         QPoint moveToPos = cursorPos - d->DragStartMousePosition - QPoint(borderSize, 0);
         move(moveToPos);
+        if (d->Started)
+        {
+            d->updatePreview(cursorPos);
+        }
         // QPoint currentCursorPos = QCursor::pos();
         // QPoint moveToPos = currentCursorPos - d->DragStartMousePosition - QPoint(borderSize, 0) - QPoint(internal::DockMarginSize, internal::DockMarginSize);
         // QPoint offset = moveToPos - pos();
@@ -424,7 +656,8 @@ void CFloatingDragPreview::startFloating(const QPoint &DragStartMousePos,
 	resize(Size);
 	d->DragStartMousePosition = DragStartMousePos;
 	moveFloating();
-	show();
+	d->Started = true;
+	d->updatePreview(QCursor::pos());
 }
 
 
@@ -496,6 +729,7 @@ void CFloatingDragPreview::finishDragging(bool)
 		d->createFloatingWidget();
 	}
 
+	d->hideLayer();
 	close();
 	d->DockManager->containerOverlay()->hideOverlay();
 	d->DockManager->dockAreaOverlay()->hideOverlay();
@@ -533,17 +767,8 @@ void CFloatingDragPreview::cleanupAutoHideContainerWidget(DockWidgetArea Contain
 void CFloatingDragPreview::paintEvent(QPaintEvent* event)
 {
 	Q_UNUSED(event);
-	if (d->Hidden)
-	{
-		return;
-	}
-
 	QPainter painter(this);
-	painter.setOpacity(internal::DraggingDockOpacity);
-	if (CDockManager::testConfigFlag(CDockManager::DragPreviewShowsContentPixmap))
-	{
-		painter.drawPixmap(QPoint(0, 0), d->ContentPreviewPixmap);
-	}
+	d->paintPreview(painter, rect(), false);
 
 	// If we do not have a window frame then we paint a QRubberBand like
 	// frameless window
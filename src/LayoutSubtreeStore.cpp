@@ -0,0 +1,481 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   LayoutSubtreeStore.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CLayoutSubtreeStore class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LayoutSubtreeStore.h"
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+namespace ads
+{
+static const char* const StateElementName = "QtAdvancedDockingSystem";
+static const char* const ReferenceDocumentElementName = "QtAdvancedDockingSystemReferences";
+static const char* const RefElementName = "Ref";
+
+
+/**
+ * Private data class of CLayoutSubtreeStore class (pimpl)
+ */
+struct LayoutSubtreeStorePrivate
+{
+	/**
+	 * One stored subtree. The data is the compressed XML of the subtree.
+	 * The children are the hashes of the subtrees that are referenced from
+	 * the data of this subtree.
+	 */
+	struct Subtree
+	{
+		QByteArray Data;
+		QList<QByteArray> Children;
+		int RefCount = 0;
+	};
+
+	CLayoutSubtreeStore* _this;
+	QHash<QByteArray, Subtree> Subtrees;
+
+	/**
+	 * Private data constructor
+	 */
+	LayoutSubtreeStorePrivate(CLayoutSubtreeStore* _public);
+
+	/**
+	 * Returns true, if the current element of the reader is stored as
+	 * separate subtree
+	 */
+	static bool isSubtreeElement(const QXmlStreamReader& s)
+	{
+		return s.name() == QLatin1String("Splitter") || s.name() == QLatin1String("Area");
+	}
+
+	/**
+	 * Copies the current element of the reader into the writer and
+	 * replaces all splitter and area subtrees with references. The hashes
+	 * of the replaced subtrees are appended to Refs
+	 */
+	void copyElement(QXmlStreamReader& s, QXmlStreamWriter& w,
+		QList<QByteArray>& Refs, const QString& ElementName = QString());
+
+	/**
+	 * Stores the subtree of the current element of the reader if it is not
+	 * stored yet and returns its hash
+	 */
+	QByteArray intern(QXmlStreamReader& s);
+
+	/**
+	 * Copies the current element of the reader into the writer and
+	 * replaces all references with the subtrees returned from the Subtree
+	 * function
+	 */
+	static bool expandElement(QXmlStreamReader& s, QXmlStreamWriter& w,
+		const std::function<QByteArray(const QByteArray&)>& Subtree,
+		const QString& ElementName = QString());
+
+	/**
+	 * Increments the reference count of the given subtree
+	 */
+	void ref(const QByteArray& Hash);
+
+	/**
+	 * Decrements the reference count of the given subtree and removes it
+	 * if it is not referenced anymore
+	 */
+	void deref(const QByteArray& Hash);
+};
+// struct LayoutSubtreeStorePrivate
+
+
+//============================================================================
+LayoutSubtreeStorePrivate::LayoutSubtreeStorePrivate(CLayoutSubtreeStore* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void LayoutSubtreeStorePrivate::copyElement(QXmlStreamReader& s,
+	QXmlStreamWriter& w, QList<QByteArray>& Refs, const QString& ElementName)
+{
+	w.writeStartElement(ElementName.isEmpty() ? s.name().toString() : ElementName);
+	w.writeAttributes(s.attributes());
+	while (!s.atEnd())
+	{
+		auto Token = s.readNext();
+		if (Token == QXmlStreamReader::StartElement)
+		{
+			if (isSubtreeElement(s))
+			{
+				auto Hash = intern(s);
+				w.writeEmptyElement(RefElementName);
+				w.writeAttribute("Id", QString::fromLatin1(Hash));
+				Refs.append(Hash);
+			}
+			else
+			{
+				copyElement(s, w, Refs);
+			}
+		}
+		else if (Token == QXmlStreamReader::Characters && !s.isWhitespace())
+		{
+			w.writeCharacters(s.text().toString());
+		}
+		else if (Token == QXmlStreamReader::EndElement)
+		{
+			break;
+		}
+	}
+	w.writeEndElement();
+}
+
+
+//============================================================================
+QByteArray LayoutSubtreeStorePrivate::intern(QXmlStreamReader& s)
+{
+	QByteArray Data;
+	QList<QByteArray> Children;
+	{
+		QXmlStreamWriter w(&Data);
+		copyElement(s, w, Children);
+	}
+
+	auto Hash = QCryptographicHash::hash(Data, QCryptographicHash::Sha1).toHex();
+	if (!Subtrees.contains(Hash))
+	{
+		// The children of an already stored subtree are already referenced
+		// by the stored subtree
+		Subtree Node;
+		Node.Data = qCompress(Data);
+		Node.Children = Children;
+		Subtrees.insert(Hash, Node);
+		for (const auto& Child : Children)
+		{
+			ref(Child);
+		}
+	}
+	return Hash;
+}
+
+
+//============================================================================
+bool LayoutSubtreeStorePrivate::expandElement(QXmlStreamReader& s,
+	QXmlStreamWriter& w, const std::function<QByteArray(const QByteArray&)>& Subtree,
+	const QString& ElementName)
+{
+	w.writeStartElement(ElementName.isEmpty() ? s.name().toString() : ElementName);
+	w.writeAttributes(s.attributes());
+	while (!s.atEnd())
+	{
+		auto Token = s.readNext();
+		if (Token == QXmlStreamReader::StartElement)
+		{
+			if (s.name() == QLatin1String(RefElementName))
+			{
+				auto Data = Subtree(s.attributes().value("Id").toLatin1());
+				if (Data.isEmpty())
+				{
+					return false;
+				}
+
+				QXmlStreamReader SubtreeReader(qUncompress(Data));
+				if (!SubtreeReader.readNextStartElement()
+				 || !expandElement(SubtreeReader, w, Subtree))
+				{
+					return false;
+				}
+				s.skipCurrentElement();
+			}
+			else if (!expandElement(s, w, Subtree))
+			{
+				return false;
+			}
+		}
+		else if (Token == QXmlStreamReader::Characters && !s.isWhitespace())
+		{
+			w.writeCharacters(s.text().toString());
+		}
+		else if (Token == QXmlStreamReader::EndElement)
+		{
+			break;
+		}
+	}
+	w.writeEndElement();
+	return !s.hasError();
+}
+
+
+//============================================================================
+void LayoutSubtreeStorePrivate::ref(const QByteArray& Hash)
+{
+	auto it = Subtrees.find(Hash);
+	if (it != Subtrees.end())
+	{
+		it->RefCount++;
+	}
+}
+
+
+//============================================================================
+void LayoutSubtreeStorePrivate::deref(const QByteArray& Hash)
+{
+	auto it = Subtrees.find(Hash);
+	if (it == Subtrees.end() || --it->RefCount > 0)
+	{
+		return;
+	}
+
+	const auto Children = it->Children;
+	Subtrees.erase(it);
+	for (const auto& Child : Children)
+	{
+		deref(Child);
+	}
+}
+
+
+//============================================================================
+CLayoutSubtreeStore::CLayoutSubtreeStore() :
+	d(new LayoutSubtreeStorePrivate(this))
+{
+
+}
+
+
+//============================================================================
+CLayoutSubtreeStore::~CLayoutSubtreeStore()
+{
+	delete d;
+}
+
+
+//============================================================================
+bool CLayoutSubtreeStore::isReferenceDocument(const QByteArray& Data)
+{
+	return Data.startsWith(QByteArray("<") + ReferenceDocumentElementName);
+}
+
+
+//============================================================================
+QList<QByteArray> CLayoutSubtreeStore::references(const QByteArray& Data)
+{
+	// Reference documents are plain XML, stored subtrees are compressed
+	QList<QByteArray> Result;
+	QXmlStreamReader s(Data.startsWith('<') ? Data : qUncompress(Data));
+	while (!s.atEnd())
+	{
+		if (s.readNext() == QXmlStreamReader::StartElement
+		 && s.name() == QLatin1String(RefElementName))
+		{
+			Result.append(s.attributes().value("Id").toLatin1());
+		}
+	}
+	return Result;
+}
+
+
+//============================================================================
+QByteArray CLayoutSubtreeStore::resolve(const QByteArray& Document,
+	const std::function<QByteArray(const QByteArray& Hash)>& Subtree)
+{
+	QXmlStreamReader s(Document);
+	if (!s.readNextStartElement() || s.name() != QLatin1String(ReferenceDocumentElementName))
+	{
+		return QByteArray();
+	}
+
+	QByteArray State;
+	QXmlStreamWriter w(&State);
+	w.writeStartDocument();
+	if (!LayoutSubtreeStorePrivate::expandElement(s, w, Subtree, StateElementName))
+	{
+		return QByteArray();
+	}
+	w.writeEndDocument();
+	return State;
+}
+
+
+//============================================================================
+QByteArray CLayoutSubtreeStore::insert(const QByteArray& State)
+{
+	QByteArray Xml = State.startsWith("<?xml") ? State : qUncompress(State);
+	QXmlStreamReader s(Xml);
+	if (!s.readNextStartElement() || s.name() != QLatin1String(StateElementName))
+	{
+		return QByteArray();
+	}
+
+	QByteArray Document;
+	QList<QByteArray> Refs;
+	{
+		QXmlStreamWriter w(&Document);
+		d->copyElement(s, w, Refs, ReferenceDocumentElementName);
+	}
+
+	if (s.hasError())
+	{
+		removeUnreferenced();
+		return QByteArray();
+	}
+
+	for (const auto& Hash : Refs)
+	{
+		d->ref(Hash);
+	}
+	return Document;
+}
+
+
+//============================================================================
+void CLayoutSubtreeStore::release(const QByteArray& Document)
+{
+	for (const auto& Hash : references(Document))
+	{
+		d->deref(Hash);
+	}
+}
+
+
+//============================================================================
+void CLayoutSubtreeStore::acquire(const QByteArray& Document)
+{
+	for (const auto& Hash : references(Document))
+	{
+		d->ref(Hash);
+	}
+}
+
+
+//============================================================================
+QByteArray CLayoutSubtreeStore::resolve(const QByteArray& Document) const
+{
+	const auto& Subtrees = d->Subtrees;
+	return resolve(Document, [&Subtrees](const QByteArray& Hash)
+		{
+			return Subtrees.value(Hash).Data;
+		});
+}
+
+
+//============================================================================
+QMap<QByteArray, QByteArray> CLayoutSubtreeStore::subtrees() const
+{
+	QMap<QByteArray, QByteArray> Result;
+	for (auto it = d->Subtrees.constBegin(); it != d->Subtrees.constEnd(); ++it)
+	{
+		Result.insert(it.key(), it->Data);
+	}
+	return Result;
+}
+
+
+//============================================================================
+void CLayoutSubtreeStore::restoreSubtrees(const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	clear();
+	for (auto it = Subtrees.constBegin(); it != Subtrees.constEnd(); ++it)
+	{
+		LayoutSubtreeStorePrivate::Subtree Node;
+		Node.Data = it.value();
+		Node.Children = references(it.value());
+		d->Subtrees.insert(it.key(), Node);
+	}
+
+	// The references between the subtrees can only be counted if all
+	// subtrees are loaded
+	for (const auto& Node : d->Subtrees)
+	{
+		for (const auto& Child : Node.Children)
+		{
+			d->ref(Child);
+		}
+	}
+}
+
+
+//============================================================================
+void CLayoutSubtreeStore::removeUnreferenced()
+{
+	QList<QByteArray> Unreferenced;
+	for (auto it = d->Subtrees.constBegin(); it != d->Subtrees.constEnd(); ++it)
+	{
+		if (it->RefCount <= 0)
+		{
+			Unreferenced.append(it.key());
+		}
+	}
+
+	for (const auto& Hash : Unreferenced)
+	{
+		auto it = d->Subtrees.find(Hash);
+		if (it == d->Subtrees.end() || it->RefCount > 0)
+		{
+			continue;
+		}
+
+		const auto Children = it->Children;
+		d->Subtrees.erase(it);
+		for (const auto& Child : Children)
+		{
+			d->deref(Child);
+		}
+	}
+}
+
+
+//============================================================================
+void CLayoutSubtreeStore::clear()
+{
+	d->Subtrees.clear();
+}
+
+
+//============================================================================
+int CLayoutSubtreeStore::count() const
+{
+	return d->Subtrees.count();
+}
+
+
+//============================================================================
+qint64 CLayoutSubtreeStore::dataSize() const
+{
+	qint64 Size = 0;
+	for (const auto& Node : d->Subtrees)
+	{
+		Size += Node.Data.size();
+	}
+	return Size;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF LayoutSubtreeStore.cpp
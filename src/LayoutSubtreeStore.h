@@ -0,0 +1,162 @@
+#ifndef LayoutSubtreeStoreH
+#define LayoutSubtreeStoreH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   LayoutSubtreeStore.h
+/// \date   19.10.2026
+/// \brief  Declaration of CLayoutSubtreeStore class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+
+#include <functional>
+
+namespace ads
+{
+struct LayoutSubtreeStorePrivate;
+
+/**
+ * Content addressed storage for the splitter and dock area subtrees of
+ * saved dock manager states.
+ * A state that is inserted into the store is split into its splitter and
+ * dock area subtrees. Each subtree is identified by the hash of its
+ * content and stored only once, no matter how many states contain it.
+ * The state itself is replaced by a small reference document that refers
+ * to the subtrees via their hashes. Subtrees are reference counted and
+ * removed if no reference document refers to them anymore.
+ * The hash is computed from the uncompressed XML of a subtree, but the
+ * subtrees are stored compressed. So they can be saved as they are and
+ * a subtree that has been saved once never needs to be written again.
+ */
+class CLayoutSubtreeStore
+{
+private:
+	LayoutSubtreeStorePrivate* d; ///< private data (pimpl)
+	friend struct LayoutSubtreeStorePrivate;
+
+public:
+	/**
+	 * Default Constructor
+	 */
+	CLayoutSubtreeStore();
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CLayoutSubtreeStore();
+
+	/**
+	 * Returns true, if the given data is a reference document created by
+	 * insert()
+	 */
+	static bool isReferenceDocument(const QByteArray& Data);
+
+	/**
+	 * Returns the hashes of all subtrees that are referenced from the given
+	 * reference document or from the given stored subtree
+	 */
+	static QList<QByteArray> references(const QByteArray& Data);
+
+	/**
+	 * Builds the complete uncompressed state from the given reference
+	 * document. The Subtree function returns the stored subtree for a
+	 * hash or an empty byte array, if the subtree does not exist. Use this
+	 * function to resolve reference documents with subtrees that are not
+	 * stored in a CLayoutSubtreeStore, e.g. in a CPerspectiveLibrary.
+	 */
+	static QByteArray resolve(const QByteArray& Document,
+		const std::function<QByteArray(const QByteArray& Hash)>& Subtree);
+
+	/**
+	 * Splits the given state returned from CDockManager::saveState() into
+	 * subtrees, stores all subtrees that are not in the store yet and
+	 * returns the reference document for the state.
+	 * Returns an empty byte array, if the state is not a valid state.
+	 */
+	QByteArray insert(const QByteArray& State);
+
+	/**
+	 * Releases all subtrees referenced by the given reference document.
+	 * Call this function, if a reference document returned from insert()
+	 * is not used anymore.
+	 */
+	void release(const QByteArray& Document);
+
+	/**
+	 * Acquires all subtrees referenced by the given reference document.
+	 * Use this function for reference documents that have been loaded
+	 * together with the subtrees via restoreSubtrees().
+	 */
+	void acquire(const QByteArray& Document);
+
+	/**
+	 * Builds the complete uncompressed state from the given reference
+	 * document. The returned state can be passed to
+	 * CDockManager::restoreState().
+	 */
+	QByteArray resolve(const QByteArray& Document) const;
+
+	/**
+	 * Returns all stored subtrees mapped by their hash.
+	 * The subtrees are returned compressed as they are stored, so saving
+	 * them does not require any serialization.
+	 */
+	QMap<QByteArray, QByteArray> subtrees() const;
+
+	/**
+	 * Replaces the content of the store with the given subtrees returned
+	 * from subtrees().
+	 * Call acquire() for each loaded reference document and then
+	 * removeUnreferenced() to drop subtrees that are not used anymore.
+	 */
+	void restoreSubtrees(const QMap<QByteArray, QByteArray>& Subtrees);
+
+	/**
+	 * Removes all subtrees that are not referenced by any reference
+	 * document
+	 */
+	void removeUnreferenced();
+
+	/**
+	 * Removes all subtrees
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of stored subtrees
+	 */
+	int count() const;
+
+	/**
+	 * Returns the number of bytes used for storing the compressed subtrees
+	 */
+	qint64 dataSize() const;
+}; // class CLayoutSubtreeStore
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // LayoutSubtreeStoreH
@@ -0,0 +1,679 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   PerspectiveLibrary.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CPerspectiveLibrary class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "PerspectiveLibrary.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QSet>
+
+#include "LayoutSubtreeStore.h"
+
+namespace ads
+{
+/**
+ * Layout of the library file:
+ * Header: magic, format version, index offset and index size
+ * Records: the raw perspective states and the compressed layout subtrees
+ * Index: number of entries followed by name, offset and size of each
+ * entry. Version 1 files store an additional unused capacity per entry.
+ * Since version 3 the perspective entries are followed by the number of
+ * subtree entries and the hash, offset and size of each subtree entry.
+ * States and the index are always appended to the end of the file before
+ * the header is updated. Records that are referenced by the current index
+ * are never overwritten, so an interrupted write leaves the previous index
+ * and all its states intact.
+ */
+static const quint32 LibraryMagic = 0x41445350; // "ADSP"
+static const quint32 LibraryVersion = 3;
+static const int HeaderSize = 24;
+static const qint64 MinCompactSize = 64 * 1024;
+
+/**
+ * Private data class of CPerspectiveLibrary class (pimpl)
+ */
+struct PerspectiveLibraryPrivate
+{
+	/**
+	 * Location of one perspective state or subtree in the library file
+	 */
+	struct Entry
+	{
+		quint64 Offset;
+		quint32 Size;
+	};
+
+	CPerspectiveLibrary* _this;
+	QFile File;
+	uchar* Map = nullptr;
+	qint64 MapSize = 0;
+	QMap<QString, Entry> Index;
+	QMap<QByteArray, Entry> SubtreeIndex;
+	qint64 IndexSize = 0;
+
+	/**
+	 * Private data constructor
+	 */
+	PerspectiveLibraryPrivate(CPerspectiveLibrary* _public);
+
+	/**
+	 * Maps the complete file into memory
+	 */
+	bool map();
+
+	/**
+	 * Releases the memory mapping
+	 */
+	void unmap();
+
+	/**
+	 * Reads the header and the index from the mapped file
+	 */
+	bool readIndex();
+
+	/**
+	 * Serializes the given perspective and subtree index
+	 */
+	static QByteArray indexData(const QMap<QString, Entry>& Index,
+		const QMap<QByteArray, Entry>& SubtreeIndex);
+
+	/**
+	 * Writes the header into the given device
+	 */
+	static bool writeHeader(QIODevice* Device, quint64 IndexOffset, quint64 IndexSize);
+
+	/**
+	 * Appends the index to the end of the file, updates the header and
+	 * remaps the file
+	 */
+	bool writeIndex();
+
+	/**
+	 * Appends the given state to the file and updates the index entry.
+	 * The index itself is not written.
+	 */
+	bool writeState(const QString& Name, const QByteArray& State);
+
+	/**
+	 * Appends all given subtrees that are not stored yet to the file and
+	 * updates the subtree index. The index itself is not written.
+	 */
+	bool writeSubtrees(const QMap<QByteArray, QByteArray>& Subtrees);
+
+	/**
+	 * Returns the data of the given record from the mapped file
+	 */
+	QByteArray record(const Entry& e) const
+	{
+		return Map ? QByteArray(reinterpret_cast<const char*>(Map + e.Offset), e.Size)
+			: QByteArray();
+	}
+
+	/**
+	 * Returns the hashes of all subtrees that are referenced directly or
+	 * indirectly by the stored perspectives
+	 */
+	QSet<QByteArray> referencedSubtrees() const;
+
+	/**
+	 * Returns the number of used bytes in the library file
+	 */
+	qint64 usedSize() const;
+};
+// struct PerspectiveLibraryPrivate
+
+
+//============================================================================
+PerspectiveLibraryPrivate::PerspectiveLibraryPrivate(CPerspectiveLibrary* _public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::map()
+{
+	unmap();
+	MapSize = File.size();
+	Map = File.map(0, MapSize);
+	return Map != nullptr;
+}
+
+
+//============================================================================
+void PerspectiveLibraryPrivate::unmap()
+{
+	if (Map)
+	{
+		File.unmap(Map);
+		Map = nullptr;
+		MapSize = 0;
+	}
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::readIndex()
+{
+	Index.clear();
+	SubtreeIndex.clear();
+	IndexSize = 0;
+	if (MapSize < HeaderSize)
+	{
+		return false;
+	}
+
+	QDataStream Header(QByteArray::fromRawData(reinterpret_cast<const char*>(Map), HeaderSize));
+	quint32 Magic, Version;
+	quint64 IndexOffset, Size;
+	Header >> Magic >> Version >> IndexOffset >> Size;
+	if (Magic != LibraryMagic || Version > LibraryVersion
+	 || IndexOffset < quint64(HeaderSize) || IndexOffset + Size > quint64(MapSize))
+	{
+		return false;
+	}
+
+	QDataStream s(QByteArray::fromRawData(reinterpret_cast<const char*>(Map + IndexOffset), Size));
+	s.setVersion(QDataStream::Qt_5_0);
+	quint32 Count;
+	s >> Count;
+	for (quint32 i = 0; i < Count && s.status() == QDataStream::Ok; ++i)
+	{
+		QString Name;
+		Entry e;
+		s >> Name >> e.Offset >> e.Size;
+		if (Version < 2)
+		{
+			quint32 Capacity;
+			s >> Capacity;
+		}
+		if (e.Offset + e.Size > IndexOffset)
+		{
+			return false;
+		}
+		Index.insert(Name, e);
+	}
+
+	if (Version >= 3 && s.status() == QDataStream::Ok)
+	{
+		s >> Count;
+		for (quint32 i = 0; i < Count && s.status() == QDataStream::Ok; ++i)
+		{
+			QByteArray Hash;
+			Entry e;
+			s >> Hash >> e.Offset >> e.Size;
+			if (e.Offset + e.Size > IndexOffset)
+			{
+				return false;
+			}
+			SubtreeIndex.insert(Hash, e);
+		}
+	}
+
+	IndexSize = Size;
+	return s.status() == QDataStream::Ok;
+}
+
+
+//============================================================================
+QByteArray PerspectiveLibraryPrivate::indexData(const QMap<QString, Entry>& Index,
+	const QMap<QByteArray, Entry>& SubtreeIndex)
+{
+	QByteArray Data;
+	QDataStream s(&Data, QIODevice::WriteOnly);
+	s.setVersion(QDataStream::Qt_5_0);
+	s << quint32(Index.count());
+	for (auto it = Index.constBegin(); it != Index.constEnd(); ++it)
+	{
+		s << it.key() << it->Offset << it->Size;
+	}
+	s << quint32(SubtreeIndex.count());
+	for (auto it = SubtreeIndex.constBegin(); it != SubtreeIndex.constEnd(); ++it)
+	{
+		s << it.key() << it->Offset << it->Size;
+	}
+	return Data;
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::writeHeader(QIODevice* Device, quint64 IndexOffset,
+	quint64 IndexSize)
+{
+	QByteArray Data;
+	QDataStream s(&Data, QIODevice::WriteOnly);
+	s << LibraryMagic << LibraryVersion << IndexOffset << IndexSize;
+	return Device->seek(0) && Device->write(Data) == HeaderSize;
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::writeIndex()
+{
+	QByteArray Data = indexData(Index, SubtreeIndex);
+	qint64 IndexOffset = qMax<qint64>(File.size(), HeaderSize);
+	if (!File.seek(IndexOffset) || File.write(Data) != Data.size()
+	 || !File.flush() || !writeHeader(&File, IndexOffset, Data.size())
+	 || !File.flush())
+	{
+		return false;
+	}
+
+	IndexSize = Data.size();
+	if (!map())
+	{
+		return false;
+	}
+
+	// Every update leaves the old index behind - reclaim the space if
+	// the file contains more unused than used space
+	qint64 Unused = _this->unusedSize();
+	if (Unused > MinCompactSize && Unused > usedSize())
+	{
+		return _this->compact();
+	}
+	return true;
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::writeState(const QString& Name, const QByteArray& State)
+{
+	// The old record stays valid until the new index has been written
+	Entry e;
+	e.Offset = qMax<qint64>(File.size(), HeaderSize);
+	e.Size = State.size();
+	if (!File.seek(e.Offset) || File.write(State) != State.size())
+	{
+		return false;
+	}
+	Index.insert(Name, e);
+	return true;
+}
+
+
+//============================================================================
+bool PerspectiveLibraryPrivate::writeSubtrees(const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	// Subtrees are content addressed, so a stored subtree never changes
+	for (auto it = Subtrees.constBegin(); it != Subtrees.constEnd(); ++it)
+	{
+		if (SubtreeIndex.contains(it.key()))
+		{
+			continue;
+		}
+
+		Entry e;
+		e.Offset = qMax<qint64>(File.size(), HeaderSize);
+		e.Size = it->size();
+		if (!File.seek(e.Offset) || File.write(it.value()) != it->size())
+		{
+			return false;
+		}
+		SubtreeIndex.insert(it.key(), e);
+	}
+	return true;
+}
+
+
+//============================================================================
+QSet<QByteArray> PerspectiveLibraryPrivate::referencedSubtrees() const
+{
+	QSet<QByteArray> Result;
+	QList<QByteArray> Pending;
+	for (const auto& e : Index)
+	{
+		auto State = record(e);
+		if (CLayoutSubtreeStore::isReferenceDocument(State))
+		{
+			Pending.append(CLayoutSubtreeStore::references(State));
+		}
+	}
+
+	while (!Pending.isEmpty())
+	{
+		auto Hash = Pending.takeLast();
+		auto it = SubtreeIndex.constFind(Hash);
+		if (Result.contains(Hash) || it == SubtreeIndex.constEnd())
+		{
+			continue;
+		}
+		Result.insert(Hash);
+		Pending.append(CLayoutSubtreeStore::references(record(it.value())));
+	}
+	return Result;
+}
+
+
+//============================================================================
+qint64 PerspectiveLibraryPrivate::usedSize() const
+{
+	qint64 Size = HeaderSize + IndexSize;
+	for (const auto& e : Index)
+	{
+		Size += e.Size;
+	}
+	for (const auto& e : SubtreeIndex)
+	{
+		Size += e.Size;
+	}
+	return Size;
+}
+
+
+//============================================================================
+CPerspectiveLibrary::CPerspectiveLibrary(const QString& FileName) :
+	d(new PerspectiveLibraryPrivate(this))
+{
+	d->File.setFileName(FileName);
+}
+
+
+//============================================================================
+CPerspectiveLibrary::~CPerspectiveLibrary()
+{
+	close();
+	delete d;
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::open()
+{
+	close();
+	if (!d->File.open(QIODevice::ReadWrite) && !d->File.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	if (d->File.size() == 0 && (!isWritable() || !d->writeIndex()))
+	{
+		close();
+		return false;
+	}
+
+	if (!d->map() || !d->readIndex())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//============================================================================
+void CPerspectiveLibrary::close()
+{
+	d->unmap();
+	d->Index.clear();
+	d->SubtreeIndex.clear();
+	d->IndexSize = 0;
+	d->File.close();
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::isOpen() const
+{
+	return d->File.isOpen();
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::isWritable() const
+{
+	return d->File.isWritable();
+}
+
+
+//============================================================================
+QString CPerspectiveLibrary::fileName() const
+{
+	return d->File.fileName();
+}
+
+
+//============================================================================
+QStringList CPerspectiveLibrary::names() const
+{
+	return d->Index.keys();
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::contains(const QString& Name) const
+{
+	return d->Index.contains(Name);
+}
+
+
+//============================================================================
+int CPerspectiveLibrary::count() const
+{
+	return d->Index.count();
+}
+
+
+//============================================================================
+QByteArray CPerspectiveLibrary::state(const QString& Name) const
+{
+	auto it = d->Index.constFind(Name);
+	return (it == d->Index.constEnd()) ? QByteArray() : d->record(it.value());
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::setState(const QString& Name, const QByteArray& State,
+	const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	if (!isWritable())
+	{
+		return false;
+	}
+
+	return d->writeSubtrees(Subtrees) && d->writeState(Name, State) && d->writeIndex();
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::setStates(const QMap<QString, QByteArray>& States,
+	const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	if (!isWritable() || !d->writeSubtrees(Subtrees))
+	{
+		return false;
+	}
+
+	for (auto it = States.constBegin(); it != States.constEnd(); ++it)
+	{
+		if (!d->writeState(it.key(), it.value()))
+		{
+			return false;
+		}
+	}
+
+	return d->writeIndex();
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::replaceStates(const QMap<QString, QByteArray>& States,
+	const QMap<QByteArray, QByteArray>& Subtrees)
+{
+	if (!isWritable())
+	{
+		return false;
+	}
+
+	// The index in the file is only replaced by the final index write, so
+	// the previous perspectives stay intact if a write fails. Subtrees that
+	// are not used anymore are dropped by the next compact().
+	auto OldIndex = d->Index;
+	auto OldSubtreeIndex = d->SubtreeIndex;
+	d->Index.clear();
+	bool Written = d->writeSubtrees(Subtrees);
+	for (auto it = States.constBegin(); Written && it != States.constEnd(); ++it)
+	{
+		Written = d->writeState(it.key(), it.value());
+	}
+	if (!Written)
+	{
+		d->Index = OldIndex;
+		d->SubtreeIndex = OldSubtreeIndex;
+		return false;
+	}
+
+	return d->writeIndex();
+}
+
+
+//============================================================================
+QByteArray CPerspectiveLibrary::subtree(const QByteArray& Hash) const
+{
+	auto it = d->SubtreeIndex.constFind(Hash);
+	return (it == d->SubtreeIndex.constEnd()) ? QByteArray() : d->record(it.value());
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::containsSubtree(const QByteArray& Hash) const
+{
+	return d->SubtreeIndex.contains(Hash);
+}
+
+
+//============================================================================
+QMap<QByteArray, QByteArray> CPerspectiveLibrary::subtrees() const
+{
+	QMap<QByteArray, QByteArray> Result;
+	for (auto it = d->SubtreeIndex.constBegin(); it != d->SubtreeIndex.constEnd(); ++it)
+	{
+		Result.insert(it.key(), d->record(it.value()));
+	}
+	return Result;
+}
+
+
+//============================================================================
+int CPerspectiveLibrary::subtreeCount() const
+{
+	return d->SubtreeIndex.count();
+}
+
+
+//============================================================================
+int CPerspectiveLibrary::remove(const QStringList& Names)
+{
+	if (!isWritable())
+	{
+		return 0;
+	}
+
+	int Count = 0;
+	for (const auto& Name : Names)
+	{
+		Count += d->Index.remove(Name);
+	}
+
+	if (Count && !d->writeIndex())
+	{
+		return 0;
+	}
+	return Count;
+}
+
+
+//============================================================================
+bool CPerspectiveLibrary::compact()
+{
+	if (!isWritable() || !d->Map)
+	{
+		return false;
+	}
+
+	QSaveFile Out(fileName());
+	if (!Out.open(QIODevice::WriteOnly) || !d->writeHeader(&Out, 0, 0))
+	{
+		return false;
+	}
+
+	QMap<QString, PerspectiveLibraryPrivate::Entry> Index;
+	qint64 Offset = HeaderSize;
+	for (auto it = d->Index.constBegin(); it != d->Index.constEnd(); ++it)
+	{
+		if (Out.write(reinterpret_cast<const char*>(d->Map + it->Offset), it->Size) != it->Size)
+		{
+			return false;
+		}
+		Index.insert(it.key(), {quint64(Offset), it->Size});
+		Offset += it->Size;
+	}
+
+	// Subtrees that are not referenced by any perspective are dropped
+	QMap<QByteArray, PerspectiveLibraryPrivate::Entry> SubtreeIndex;
+	const auto Referenced = d->referencedSubtrees();
+	for (auto it = d->SubtreeIndex.constBegin(); it != d->SubtreeIndex.constEnd(); ++it)
+	{
+		if (!Referenced.contains(it.key()))
+		{
+			continue;
+		}
+		if (Out.write(reinterpret_cast<const char*>(d->Map + it->Offset), it->Size) != it->Size)
+		{
+			return false;
+		}
+		SubtreeIndex.insert(it.key(), {quint64(Offset), it->Size});
+		Offset += it->Size;
+	}
+
+	QByteArray Data = d->indexData(Index, SubtreeIndex);
+	if (Out.write(Data) != Data.size() || !d->writeHeader(&Out, Offset, Data.size()))
+	{
+		return false;
+	}
+
+	// The mapped file needs to be closed before it can be replaced
+	close();
+	bool Result = Out.commit();
+	return open() && Result;
+}
+
+
+//============================================================================
+qint64 CPerspectiveLibrary::unusedSize() const
+{
+	return isOpen() ? qMax<qint64>(0, d->File.size() - d->usedSize()) : 0;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF PerspectiveLibrary.cpp
@@ -0,0 +1,203 @@
+#ifndef PerspectiveLibraryH
+#define PerspectiveLibraryH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   PerspectiveLibrary.h
+/// \date   19.10.2026
+/// \brief  Declaration of CPerspectiveLibrary class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct PerspectiveLibraryPrivate;
+
+/**
+ * File based storage for perspectives.
+ * All perspectives are stored in one single file. The file starts with a
+ * small header that points to an index of all stored perspectives. When the
+ * library is opened, the file is memory mapped and only the index is read.
+ * The state of a perspective is read from the mapped file only if it is
+ * requested via state(). So opening a library does not depend on the size
+ * or number of the stored perspectives.
+ * Changing a perspective does not rewrite the whole file. The new state is
+ * appended to the file and the old state is only released when the updated
+ * index has been written, so an interrupted write keeps the previous
+ * perspectives. Replacing a perspective is always append only. The old
+ * record is never overwritten in place, even if the new state would fit
+ * into it, because the current index still refers to it. The space of removed or replaced perspectives is reclaimed
+ * by compact(), which is called automatically if the file contains more
+ * unused than used space.
+ * The library also stores the shared layout subtrees of perspectives that
+ * are stored as reference documents (see
+ * CDockManager::PerspectiveDeduplication). Each subtree is stored once as
+ * compressed record and is never written again. Subtrees that are not
+ * referenced by any perspective anymore are dropped by compact().
+ * Assign a library to a dock manager via CDockManager::setPerspectiveLibrary()
+ * to use it as storage for the dock manager perspectives.
+ */
+class ADS_EXPORT CPerspectiveLibrary
+{
+private:
+	PerspectiveLibraryPrivate* d; ///< private data (pimpl)
+	friend struct PerspectiveLibraryPrivate;
+
+public:
+	/**
+	 * Creates a library for the given file. Call open() to open the file.
+	 */
+	CPerspectiveLibrary(const QString& FileName);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CPerspectiveLibrary();
+
+	/**
+	 * Opens and memory maps the library file and reads the index.
+	 * If the file does not exist, an empty library file is created.
+	 * If the file is not writable, it is opened read only and all
+	 * functions that modify the library will fail.
+	 * Returns false, if the file could not be opened or if it is not a
+	 * valid perspective library file.
+	 */
+	bool open();
+
+	/**
+	 * Unmaps and closes the library file
+	 */
+	void close();
+
+	/**
+	 * Returns true, if the library file is open
+	 */
+	bool isOpen() const;
+
+	/**
+	 * Returns true, if the library file is open and writable
+	 */
+	bool isWritable() const;
+
+	/**
+	 * Returns the file name of the library
+	 */
+	QString fileName() const;
+
+	/**
+	 * Returns the sorted names of all perspectives in this library
+	 */
+	QStringList names() const;
+
+	/**
+	 * Returns true, if the library contains a perspective with the given name
+	 */
+	bool contains(const QString& Name) const;
+
+	/**
+	 * Returns the number of perspectives in this library
+	 */
+	int count() const;
+
+	/**
+	 * Reads the state of the perspective with the given name from the
+	 * mapped file. Returns an empty byte array, if the library does not
+	 * contain the perspective.
+	 */
+	QByteArray state(const QString& Name) const;
+
+	/**
+	 * Stores the given state for the perspective with the given name.
+	 * If the perspective already exists, its state is replaced.
+	 * Subtrees contains the layout subtrees that are referenced by the
+	 * state, mapped by their hash. Only the subtrees that are not stored
+	 * yet are written.
+	 */
+	bool setState(const QString& Name, const QByteArray& State,
+		const QMap<QByteArray, QByteArray>& Subtrees = QMap<QByteArray, QByteArray>());
+
+	/**
+	 * Stores multiple perspectives and their subtrees with one single
+	 * update of the index
+	 */
+	bool setStates(const QMap<QString, QByteArray>& States,
+		const QMap<QByteArray, QByteArray>& Subtrees = QMap<QByteArray, QByteArray>());
+
+	/**
+	 * Replaces all perspectives of the library with the given perspectives
+	 * with one single update of the index. If the update fails, the
+	 * library keeps its previous perspectives.
+	 */
+	bool replaceStates(const QMap<QString, QByteArray>& States,
+		const QMap<QByteArray, QByteArray>& Subtrees = QMap<QByteArray, QByteArray>());
+
+	/**
+	 * Reads the compressed layout subtree with the given hash from the
+	 * mapped file. Returns an empty byte array, if the library does not
+	 * contain the subtree.
+	 */
+	QByteArray subtree(const QByteArray& Hash) const;
+
+	/**
+	 * Returns true, if the library contains the subtree with the given hash
+	 */
+	bool containsSubtree(const QByteArray& Hash) const;
+
+	/**
+	 * Returns all stored layout subtrees mapped by their hash
+	 */
+	QMap<QByteArray, QByteArray> subtrees() const;
+
+	/**
+	 * Returns the number of stored layout subtrees
+	 */
+	int subtreeCount() const;
+
+	/**
+	 * Removes the perspectives with the given names and returns the
+	 * number of removed perspectives
+	 */
+	int remove(const QStringList& Names);
+
+	/**
+	 * Rewrites the library file without unused space
+	 */
+	bool compact();
+
+	/**
+	 * Returns the number of bytes in the library file that are not used
+	 * by the header, the index, a stored perspective or a stored subtree
+	 */
+	qint64 unusedSize() const;
+}; // class CPerspectiveLibrary
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // PerspectiveLibraryH
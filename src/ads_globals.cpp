@@ -55,6 +55,7 @@ const int DockedWidgetDragStartEvent = QEvent::registerEventType();
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
 static QString _window_manager;
 static QHash<QString, xcb_atom_t> _xcb_atom_cache;
+static SXcbRequestCounts _xcb_request_counts;
 
 
 //============================================================================
@@ -112,7 +113,8 @@ xcb_atom_t xcb_get_atom(const char *name)
 
 
 //============================================================================
-void xcb_update_prop(bool set, WId window, const char *type, const char *prop, const char *prop2)
+void xcb_update_prop(bool set, WId window, const char *type, const char *prop,
+	const char *prop2, bool Flush)
 {
 	auto connection = x11_connection();
 	xcb_atom_t type_atom = xcb_get_atom(type);
@@ -132,7 +134,38 @@ void xcb_update_prop(bool set, WId window, const char *type, const char *prop, c
 	xcb_send_event(connection, 0, window,
 				   XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT | XCB_EVENT_MASK_PROPERTY_CHANGE,
 				   (const char *)&event);
-	xcb_flush(connection);
+	++_xcb_request_counts.ClientMessages;
+	if (Flush)
+	{
+		xcb_flush(connection);
+		++_xcb_request_counts.Flushes;
+	}
+}
+
+
+//============================================================================
+void xcb_flush_connection()
+{
+	if (!is_platform_x11())
+	{
+		return;
+	}
+	xcb_flush(x11_connection());
+	++_xcb_request_counts.Flushes;
+}
+
+
+//============================================================================
+SXcbRequestCounts xcb_request_counts()
+{
+	return _xcb_request_counts;
+}
+
+
+//============================================================================
+void xcb_reset_request_counts()
+{
+	_xcb_request_counts = SXcbRequestCounts();
 }
 
 
@@ -177,6 +177,7 @@ static const QString TitleBarHighlightedColor = "rgb(140, 160, 180)";
 static const char* const ClosedProperty = "close";
 static const char* const DirtyProperty = "dirty";
 static const char* const LocationProperty = "Location";
+static const char* const ViewMenuGroupProperty = "viewMenuGroup";
 extern const int FloatingWidgetDragStartEvent;
 extern const int DockedWidgetDragStartEvent;
 
@@ -193,8 +194,35 @@ xcb_atom_t xcb_get_atom(const char *name);
 void xcb_add_prop(bool state, WId window, const char *type, const char *prop);
 /**
  * Updates up to two window properties. Can be set on a visible window.
+ * If Flush is false, the request is not flushed to the X server. Use this
+ * to send multiple requests and call xcb_flush_connection() afterwards.
  */
-void xcb_update_prop(bool set, WId window, const char *type, const char *prop, const char *prop2 = nullptr);
+void xcb_update_prop(bool set, WId window, const char *type, const char *prop,
+	const char *prop2 = nullptr, bool Flush = true);
+/**
+ * Flushes all pending requests to the X server.
+ */
+void xcb_flush_connection();
+/**
+ * Number of client messages sent by xcb_update_prop() and number of
+ * flushes by xcb_update_prop() and xcb_flush_connection().
+ * The stress benchmark uses these counters to verify that stacking state
+ * changes of floating widgets are batched.
+ */
+struct SXcbRequestCounts
+{
+	int ClientMessages = 0;
+	int Flushes = 0;
+};
+/**
+ * Returns the requests counted since the last call of
+ * xcb_reset_request_counts()
+ */
+ADS_EXPORT SXcbRequestCounts xcb_request_counts();
+/**
+ * Resets the request counters
+ */
+ADS_EXPORT void xcb_reset_request_counts();
 /**
  * Only for debugging purposes.
  */
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ ** Qt Advanced Docking System
+ ** Copyright (C) 2017 Uwe Kindler
+ **
+ ** This library is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2.1 of the License, or (at your option) any later version.
+ **
+ ** This library is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+//============================================================================
+/// \file   FloatingStackingManager.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CFloatingStackingManager class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "FloatingStackingManager.h"
+
+#include <algorithm>
+
+#include <QGuiApplication>
+
+#include "ads_globals.h"
+#include "DockContainerWidget.h"
+#include "FloatingDockContainer.h"
+
+namespace ads
+{
+//============================================================================
+void CFloatingStackingManager::requestAbove(CFloatingDockContainer* FloatingWidget,
+	bool Above)
+{
+	// Only the last request for a floating widget counts
+	for (auto& Request : PendingRequests)
+	{
+		if (Request.FloatingWidget == FloatingWidget)
+		{
+			Request.Above = Above;
+			return;
+		}
+	}
+
+	PendingRequests.append({FloatingWidget, Above});
+}
+
+
+//============================================================================
+void CFloatingStackingManager::flush()
+{
+	const bool IsX11 = QGuiApplication::platformName() == QLatin1String("xcb");
+	bool MessagesSent = false;
+	QList<CFloatingDockContainer*> LoweredWidgets;
+	for (const auto& Request : PendingRequests)
+	{
+		CFloatingDockContainer* FloatingWidget = Request.FloatingWidget;
+		if (!FloatingWidget || !FloatingWidget->isVisible())
+		{
+			continue;
+		}
+
+		// A state is only valid for the native window it has been sent to.
+		// If the native window has been recreated, the state is unknown.
+		WId Window = FloatingWidget->window()->winId();
+		auto it = States.find(FloatingWidget);
+		if (it != States.end() && it->Window == Window && it->Above == Request.Above)
+		{
+			continue;
+		}
+
+		if (IsX11)
+		{
+			internal::xcb_update_prop(Request.Above, Window, "_NET_WM_STATE",
+				"_NET_WM_STATE_ABOVE", "_NET_WM_STATE_STAYS_ON_TOP", false);
+			MessagesSent = true;
+		}
+		else if (FloatingWidget->windowFlags().testFlag(Qt::WindowStaysOnTopHint) != Request.Above)
+		{
+			FloatingWidget->setWindowFlag(Qt::WindowStaysOnTopHint, Request.Above);
+		}
+
+		States.insert(FloatingWidget, WindowState{Window, Request.Above});
+		if (!Request.Above)
+		{
+			LoweredWidgets.append(FloatingWidget);
+		}
+	}
+	PendingRequests.clear();
+
+	if (MessagesSent)
+	{
+		internal::xcb_flush_connection();
+	}
+
+	// Raise the floating widgets that left the above state in their z-order
+	// to keep the stacking order of the floating widgets
+	std::sort(LoweredWidgets.begin(), LoweredWidgets.end(),
+		[](CFloatingDockContainer* a, CFloatingDockContainer* b)
+		{
+			return a->dockContainer()->zOrderIndex() < b->dockContainer()->zOrderIndex();
+		});
+	for (auto FloatingWidget : LoweredWidgets)
+	{
+		FloatingWidget->raise();
+	}
+}
+
+
+//============================================================================
+void CFloatingStackingManager::removeFloatingWidget(CFloatingDockContainer* FloatingWidget)
+{
+	States.remove(FloatingWidget);
+	for (int i = PendingRequests.count() - 1; i >= 0; --i)
+	{
+		if (PendingRequests[i].FloatingWidget == FloatingWidget)
+		{
+			PendingRequests.removeAt(i);
+		}
+	}
+}
+
+
+//============================================================================
+void CFloatingStackingManager::floatingWidgetHidden(CFloatingDockContainer* FloatingWidget)
+{
+	States.remove(FloatingWidget);
+}
+
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF FloatingStackingManager.cpp
@@ -0,0 +1,106 @@
+#ifndef FLOATINGSTACKINGMANAGER_H
+#define FLOATINGSTACKINGMANAGER_H
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   FloatingStackingManager.h
+/// \date   19.10.2026
+/// \brief  Declaration of CFloatingStackingManager class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QWidget>
+
+namespace ads
+{
+class CFloatingDockContainer;
+
+/**
+ * Keeps track of the stacking state (above or normal) of the floating
+ * widgets of one dock manager.
+ * On Linux the dock manager emulates the Qt::Tool behaviour by putting all
+ * floating widgets into the above state if the main window is activated and
+ * back into the normal state if it is deactivated. Doing this for each
+ * floating widget on every activation change causes a lot of requests to
+ * the window system and flickering. This class records the requested state
+ * changes and sends only the transitions that are really required in one
+ * single batch.
+ */
+class CFloatingStackingManager
+{
+public:
+	/**
+	 * Records that the given floating widget should be in the above state
+	 * (Above = true) or in the normal state (Above = false).
+	 * Nothing is sent to the window system until flush() is called.
+	 */
+	void requestAbove(CFloatingDockContainer* FloatingWidget, bool Above);
+
+	/**
+	 * Sends all required state transitions to the window system.
+	 * On X11 all client messages are sent with one single flush of the
+	 * connection. Floating widgets that left the above state are raised
+	 * afterwards in their z-order, so that they stay in front of the main
+	 * window. Floating widgets whose state did not change are not raised.
+	 */
+	void flush();
+
+	/**
+	 * Removes the given floating widget from the tracked windows.
+	 * Call this function if the floating widget is removed from the dock
+	 * manager.
+	 */
+	void removeFloatingWidget(CFloatingDockContainer* FloatingWidget);
+
+	/**
+	 * Forgets the stacking state of the given floating widget.
+	 * The window manager drops the state of a window when it is unmapped,
+	 * so call this function if the floating widget is hidden.
+	 */
+	void floatingWidgetHidden(CFloatingDockContainer* FloatingWidget);
+
+private:
+	/**
+	 * The last stacking state that has been sent for a native window
+	 */
+	struct WindowState
+	{
+		WId Window = 0;
+		bool Above = false;
+	};
+
+	struct Request
+	{
+		QPointer<CFloatingDockContainer> FloatingWidget;
+		bool Above;
+	};
+
+	QHash<CFloatingDockContainer*, WindowState> States;
+	QList<Request> PendingRequests;
+}; // class CFloatingStackingManager
+} // namespace ads
+
+//-----------------------------------------------------------------------------
+#endif // FLOATINGSTACKINGMANAGER_H
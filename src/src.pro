@@ -40,6 +40,15 @@ HEADERS += \
     DockWidgetTab.h \ 
 	FloatingHelper.h \
     DockingStateReader.h \
+    DockingStateStream.h \
+    DockLayoutSnapshot.h \
+    DockLayoutSolver.h \
+    DockCommandQueue.h \
+    DockOcclusionTracker.h \
+    DockMemoryUsage.h \
+    DockQuickOpen.h \
+    PerspectiveLibrary.h \
+    LayoutSubtreeStore.h \
     FloatingDockContainer.h \
     FloatingDragPreview.h \
     DockOverlay.h \
@@ -66,6 +75,15 @@ SOURCES += \
     DockManager.cpp \
     DockWidget.cpp \
     DockingStateReader.cpp \
+    DockingStateStream.cpp \
+    DockLayoutSnapshot.cpp \
+    DockLayoutSolver.cpp \
+    DockCommandQueue.cpp \
+    DockOcclusionTracker.cpp \
+    DockMemoryUsage.cpp \
+    DockQuickOpen.cpp \
+    PerspectiveLibrary.cpp \
+    LayoutSubtreeStore.cpp \
     DockWidgetTab.cpp \
     FloatingDockContainer.cpp \
     FloatingDragPreview.cpp \
@@ -86,7 +104,9 @@ SOURCES += \
 
 unix:!macx {
 HEADERS += linux/FloatingWidgetTitleBar.h
+HEADERS += linux/FloatingStackingManager.h
 SOURCES += linux/FloatingWidgetTitleBar.cpp
+SOURCES += linux/FloatingStackingManager.cpp
 LIBS += -lxcb
 QT += gui-private
 }